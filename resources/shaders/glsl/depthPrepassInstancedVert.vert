@@ -0,0 +1,34 @@
+#version 450
+
+layout(location = 0) in vec3 inPosition;
+
+// NOTE: The shading pass tests against this depth with EQUAL, so both have to compute the exact same position
+invariant gl_Position;
+
+layout(set = 0, binding = 0) uniform UniformBufferGlobal
+{
+    mat4 projection;
+    mat4 view;
+    mat4 inverseView;
+    vec4 ambientLightColor;
+} global;
+
+struct ObjectData
+{
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    uint materialIndex;
+};
+
+// NOTE: gl_InstanceIndex includes the firstInstance of the draw command, which points at the batch's first object
+layout(std430, set = 2, binding = 0) readonly buffer ObjectBuffer
+{
+    ObjectData objects[];
+} objectBuffer;
+
+void main()
+{
+    const vec4 worldPosition = objectBuffer.objects[gl_InstanceIndex].modelMatrix * vec4(inPosition, 1.0);
+
+    gl_Position = global.projection * global.view * worldPosition;
+}
@@ -0,0 +1,28 @@
+#version 450
+
+layout(location = 0) in vec3 inPosition;
+
+// NOTE: The shading pass tests against this depth with EQUAL, so both have to compute the exact same position
+invariant gl_Position;
+
+layout(set = 0, binding = 0) uniform UniformBufferGlobal
+{
+    mat4 projection;
+    mat4 view;
+    mat4 inverseView;
+    vec4 ambientLightColor;
+} global;
+
+layout(push_constant) uniform Push
+{
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    uint materialIndex;
+} push;
+
+void main()
+{
+    const vec4 worldPosition = push.modelMatrix * vec4(inPosition, 1.0);
+
+    gl_Position = global.projection * global.view * worldPosition;
+}
@@ -1,47 +1,100 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 layout(location = 0) in vec2 uv;
 layout(location = 1) in vec3 worldPos;
 layout(location = 2) in vec3 normal;
+layout(location = 3) flat in uint materialIndex;
 
 layout(location = 0) out vec4 outColor;
 
-struct PointLight
-{
-    vec4 position;
-    vec4 color;
-};
-
 layout(set = 0, binding = 0) uniform UniformBufferGlobal
 {
     mat4 projection;
     mat4 view;
     mat4 inverseView;
     vec4 ambientLightColor;
-    PointLight pointLights[10];
-    int numLights;
 } global;
 
-layout(set = 1, binding = 0) uniform sampler2D albedoTexture;
-layout(set = 1, binding = 1) uniform sampler2D normalTexture;
-layout(set = 1, binding = 2) uniform sampler2D metallicRoughnessTexture;
-layout(set = 1, binding = 3) uniform sampler2D occlusionTexture;
-layout(set = 1, binding = 4) uniform sampler2D emissiveTexture;
+// NOTE: Has to match LightClusterer::MAX_LIGHTS_PER_CLUSTER
+const uint MAX_LIGHTS_PER_CLUSTER = 256;
+
+struct PointLight
+{
+    vec4 position; // world space position and range
+    vec4 color;    // color and intensity
+};
+
+layout(set = 3, binding = 0) uniform ClusterUniforms
+{
+    mat4 view;
+    vec4 projection; // projection[0][0], projection[1][1], near plane, far plane
+    vec4 screen;     // image size, depth slice scale and bias
+    uvec4 grid;      // clusters per axis and light count
+} clusters;
+
+layout(std430, set = 3, binding = 1) readonly buffer LightBuffer
+{
+    PointLight lights[];
+} lightBuffer;
+
+layout(std430, set = 3, binding = 2) readonly buffer ClusterCountBuffer
+{
+    uint counts[];
+} countBuffer;
+
+layout(std430, set = 3, binding = 3) readonly buffer ClusterIndexBuffer
+{
+    uint indices[];
+} indexBuffer;
 
-layout(push_constant) uniform Push
+struct MaterialData
 {
-    mat4 modelMatrix;
-    mat4 normalMatrix;
-    vec4 albedoFactor;
-    float normalFactor;
+    vec4 baseColorFactor;
+    vec3 emissiveFactor;
+    float normalScale;
     float metallicFactor;
     float roughnessFactor;
-    float occlusionFactor;
-    vec3 emissiveFactor;
-} push;
+    float occlusionStrength;
+    float alphaCutoff;
+    uint albedoTexture;
+    uint normalTexture;
+    uint metallicRoughnessTexture;
+    uint occlusionTexture;
+    uint emissiveTexture;
+};
+
+layout(std430, set = 1, binding = 0) readonly buffer MaterialBuffer
+{
+    MaterialData materials[];
+} materialBuffer;
+
+// NOTE: Every texture of every material, indexed by the texture indices of a material
+layout(set = 1, binding = 1) uniform sampler2D textures[];
 
 const float PI = 3.14159265359;
 
+// NOTE: Cluster that contains the fragment, see LightClusterer
+uint clusterIndex()
+{
+    // NOTE: gl_FragCoord.w is 1 / w_clip and w_clip is the view depth of the perspective projection
+    const float viewDepth = 1.0 / gl_FragCoord.w;
+    const float slice = floor(log(viewDepth) * clusters.screen.z - clusters.screen.w);
+    const uint sliceIndex = uint(clamp(slice, 0.0, float(clusters.grid.z - 1u)));
+    const uvec2 tile = min(uvec2(gl_FragCoord.xy / clusters.screen.xy * vec2(clusters.grid.xy)), clusters.grid.xy - 1u);
+
+    return tile.x + clusters.grid.x * (tile.y + clusters.grid.y * sliceIndex);
+}
+
+// NOTE: Inverse square falloff that is windowed to reach zero at the light's range, beyond which clusters drop it
+float attenuate(float distance, float range)
+{
+    const float ratio = distance / range;
+    const float window = clamp(1.0 - ratio * ratio * ratio * ratio, 0.0, 1.0);
+
+    return window * window / max(distance * distance, 0.0001);
+}
+
 float distributionGGX(vec3 N, vec3 H, float roughness)
 {
     float a = roughness * roughness;
@@ -82,13 +135,17 @@ vec3 fresnelSchlick(float cosTheta, vec3 F0)
 
 void main()
 {
+    // NOTE: The index comes from a flat input and can differ between the draws of an indirect batch
+    const MaterialData material = materialBuffer.materials[materialIndex];
+
     // NOTE: sample textures
-    vec3 albedo = texture(albedoTexture, uv).rgb * push.albedoFactor.rgb;
-    vec2 metallicRoughness = texture(metallicRoughnessTexture, uv).bg; // NOTE: b = metallic, g = roughness
-    float metallic = metallicRoughness.x * push.metallicFactor;
-    float roughness = metallicRoughness.y * push.roughnessFactor;
-    float ao = texture(occlusionTexture, uv).r * push.occlusionFactor;
-    vec3 emissive = texture(emissiveTexture, uv).rgb * push.emissiveFactor;
+    vec3 albedo = texture(textures[nonuniformEXT(material.albedoTexture)], uv).rgb * material.baseColorFactor.rgb;
+    // NOTE: b = metallic, g = roughness
+    vec2 metallicRoughness = texture(textures[nonuniformEXT(material.metallicRoughnessTexture)], uv).bg;
+    float metallic = metallicRoughness.x * material.metallicFactor;
+    float roughness = metallicRoughness.y * material.roughnessFactor;
+    float ao = texture(textures[nonuniformEXT(material.occlusionTexture)], uv).r * material.occlusionStrength;
+    vec3 emissive = texture(textures[nonuniformEXT(material.emissiveTexture)], uv).rgb * material.emissiveFactor;
 
     vec3 N = normalize(normal);
     vec3 V = normalize(global.inverseView[3].xyz - worldPos);
@@ -96,16 +153,22 @@ void main()
     vec3 F0 = vec3(0.04);
     F0 = mix(F0, albedo, metallic);
 
+    // NOTE: Only the lights that were binned into the fragment's cluster can reach it
+    const uint cluster = clusterIndex();
+    const uint lightCount = min(countBuffer.counts[cluster], MAX_LIGHTS_PER_CLUSTER);
+
     vec3 Lo = vec3(0.0);
-    for(int i = 0; i < global.numLights; ++i)
+    for(uint i = 0; i < lightCount; ++i)
     {
-        vec3 lightPos = global.pointLights[i].position.xyz;
+        const PointLight light = lightBuffer.lights[indexBuffer.indices[cluster * MAX_LIGHTS_PER_CLUSTER + i]];
+
+        vec3 lightPos = light.position.xyz;
         vec3 L = normalize(lightPos - worldPos);
         vec3 H = normalize(V + L);
 
         float distance = length(lightPos - worldPos);
-        float attenuation = 1.0 / (distance * distance);
-        vec3 radiance = global.pointLights[i].color.rgb * global.pointLights[i].color.w * attenuation;
+        float attenuation = attenuate(distance, light.position.w);
+        vec3 radiance = light.color.rgb * light.color.w * attenuation;
 
         float NDF = distributionGGX(N, H, roughness);
         float G = geometrySmith(N, V, L, roughness);
@@ -0,0 +1,48 @@
+#version 450
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColor;
+layout(location = 2) in vec3 inNormal;
+layout(location = 3) in vec2 inUv;
+
+layout(location = 0) out vec2 uv;
+layout(location = 1) out vec3 worldPos;
+layout(location = 2) out vec3 normal;
+layout(location = 3) flat out uint materialIndex;
+
+// NOTE: The depth prepass computes the same position, which the EQUAL depth test after it relies on
+invariant gl_Position;
+
+layout(set = 0, binding = 0) uniform UniformBufferGlobal
+{
+    mat4 projection;
+    mat4 view;
+    mat4 inverseView;
+    vec4 ambientLightColor;
+} global;
+
+struct ObjectData
+{
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    uint materialIndex;
+};
+
+// NOTE: gl_InstanceIndex includes the firstInstance of the draw command, which points at the batch's first object
+layout(std430, set = 2, binding = 0) readonly buffer ObjectBuffer
+{
+    ObjectData objects[];
+} objectBuffer;
+
+void main()
+{
+    const ObjectData object = objectBuffer.objects[gl_InstanceIndex];
+    const vec4 worldPosition = object.modelMatrix * vec4(inPosition, 1.0);
+
+    uv = inUv;
+    worldPos = worldPosition.xyz;
+    normal = normalize(mat3(object.normalMatrix) * inNormal);
+    materialIndex = object.materialIndex;
+
+    gl_Position = global.projection * global.view * worldPosition;
+}
@@ -8,12 +8,10 @@ layout(location = 3) in vec2 inUv;
 layout(location = 0) out vec2 uv;
 layout(location = 1) out vec3 worldPos;
 layout(location = 2) out vec3 normal;
+layout(location = 3) flat out uint materialIndex;
 
-struct PointLight
-{
-    vec4 position;
-    vec4 color;
-};
+// NOTE: The depth prepass computes the same position, which the EQUAL depth test after it relies on
+invariant gl_Position;
 
 layout(set = 0, binding = 0) uniform UniformBufferGlobal
 {
@@ -21,20 +19,13 @@ layout(set = 0, binding = 0) uniform UniformBufferGlobal
     mat4 view;
     mat4 inverseView;
     vec4 ambientLightColor;
-    PointLight pointLights[10];
-    int numLights;
 } global;
 
 layout(push_constant) uniform Push
 {
     mat4 modelMatrix;
     mat4 normalMatrix;
-    vec4 albedoFactor;
-    float normalFactor;
-    float metallicFactor;
-    float roughnessFactor;
-    float occlusionFactor;
-    vec3 emissiveFactor;
+    uint materialIndex;
 } push;
 
 void main()
@@ -44,6 +35,7 @@ void main()
     uv = inUv;
     worldPos = worldPosition.xyz;
     normal = normalize(mat3(push.normalMatrix) * inNormal);
+    materialIndex = push.materialIndex;
 
     gl_Position = global.projection * global.view * worldPosition;
 }
@@ -1,32 +1,18 @@
 #version 450
 
 layout (location = 0) in vec2 fragOffset;
+layout (location = 1) flat in vec4 fragColor;
 
 layout (location = 0) out vec4 outColor;
 
-struct PointLight
-{
-    vec4 position;
-    vec4 color;
-};
-
 layout(set = 0, binding = 0) uniform UniformBufferGlobal
 {
     mat4 projection;
     mat4 view;
     mat4 inverseView;
     vec4 ambientLightColor;
-    PointLight pointLights[10];
-    int numLights;
 } ubo;
 
-layout(push_constant) uniform Push
-{
-    vec4 position;
-    vec4 color;
-    float radius;
-} push;
-
 void main()
 {
     float distance = sqrt(dot(fragOffset, fragOffset));
@@ -34,5 +20,5 @@ void main()
     if(distance >= 1.0)
         discard;
 
-    outColor = vec4(push.color.xyz, 1.0); // ensure always light intensity of 1
+    outColor = vec4(fragColor.xyz, 1.0); // ensure always light intensity of 1
 }
@@ -10,12 +10,7 @@ const vec2 OFFSET[6] = vec2[](
 );
 
 layout (location = 0) out vec2 fragOffset;
-
-struct PointLight
-{
-    vec4 position;
-    vec4 color;
-};
+layout (location = 1) flat out vec4 fragColor;
 
 layout(set = 0, binding = 0) uniform UniformBufferGlobal
 {
@@ -23,27 +18,32 @@ layout(set = 0, binding = 0) uniform UniformBufferGlobal
     mat4 view;
     mat4 inverseView;
     vec4 ambientLightColor;
-    PointLight pointLights[10];
-    int numLights;
 } ubo;
 
-layout(push_constant) uniform Push
+struct PointLightInstance
 {
-    vec4 position;
-    vec4 color;
-    float radius;
-} push;
+    vec4 position; // world space position and billboard radius
+    vec4 color;    // color and intensity
+};
+
+layout(std430, set = 1, binding = 0) readonly buffer PointLightBuffer
+{
+    PointLightInstance lights[];
+} lightBuffer;
 
 void main()
 {
+    const PointLightInstance light = lightBuffer.lights[gl_InstanceIndex];
+
     fragOffset = OFFSET[gl_VertexIndex];
+    fragColor = light.color;
 
     vec3 cameraRightWorld = vec3(ubo.view[0][0], ubo.view[1][0], ubo.view[2][0]);
     vec3 cameraUpWorld = vec3(ubo.view[0][1], ubo.view[1][1], ubo.view[2][1]);
 
-    vec3 positionWorld = push.position.xyz +
-        (push.radius * fragOffset.x * cameraRightWorld) +
-        (push.radius * fragOffset.y * cameraUpWorld);
+    vec3 positionWorld = light.position.xyz +
+        (light.position.w * fragOffset.x * cameraRightWorld) +
+        (light.position.w * fragOffset.y * cameraUpWorld);
 
     gl_Position = ubo.projection * ubo.view * vec4(positionWorld, 1.0);
 }
@@ -6,28 +6,73 @@ layout(location = 2) in vec3 fragNormalWorld;
 
 layout (location = 0) out vec4 outColor;
 
-struct PointLight
-{
-    vec4 position;
-    vec4 color;
-};
-
 layout(set = 0, binding = 0) uniform UniformBufferGlobal
 {
     mat4 projection;
     mat4 view;
     mat4 inverseView;
     vec4 ambientLightColor;
-    PointLight pointLights[10];
-    int numLights;
 } ubo;
 
+// NOTE: Has to match LightClusterer::MAX_LIGHTS_PER_CLUSTER
+const uint MAX_LIGHTS_PER_CLUSTER = 256;
+
+struct PointLight
+{
+    vec4 position; // world space position and range
+    vec4 color;    // color and intensity
+};
+
+layout(set = 1, binding = 0) uniform ClusterUniforms
+{
+    mat4 view;
+    vec4 projection; // projection[0][0], projection[1][1], near plane, far plane
+    vec4 screen;     // image size, depth slice scale and bias
+    uvec4 grid;      // clusters per axis and light count
+} clusters;
+
+layout(std430, set = 1, binding = 1) readonly buffer LightBuffer
+{
+    PointLight lights[];
+} lightBuffer;
+
+layout(std430, set = 1, binding = 2) readonly buffer ClusterCountBuffer
+{
+    uint counts[];
+} countBuffer;
+
+layout(std430, set = 1, binding = 3) readonly buffer ClusterIndexBuffer
+{
+    uint indices[];
+} indexBuffer;
+
 layout(push_constant) uniform Push
 {
     mat4 modelMatrix;
     mat4 normalMatrix;
 } push;
 
+// NOTE: Cluster that contains the fragment, see LightClusterer
+uint clusterIndex()
+{
+    // NOTE: gl_FragCoord.w is 1 / w_clip and w_clip is the view depth of the perspective projection
+    const float viewDepth = 1.0 / gl_FragCoord.w;
+    const float slice = floor(log(viewDepth) * clusters.screen.z - clusters.screen.w);
+    const uint sliceIndex = uint(clamp(slice, 0.0, float(clusters.grid.z - 1u)));
+    const uvec2 tile = min(uvec2(gl_FragCoord.xy / clusters.screen.xy * vec2(clusters.grid.xy)), clusters.grid.xy - 1u);
+
+    return tile.x + clusters.grid.x * (tile.y + clusters.grid.y * sliceIndex);
+}
+
+// NOTE: Inverse square falloff that is windowed to reach zero at the light's range, beyond which clusters drop it
+float attenuate(float distance, float range)
+{
+    const float ratio = distance / range;
+    const float window = clamp(1.0 - ratio * ratio * ratio * ratio, 0.0, 1.0);
+
+    return window * window / max(distance * distance, 0.0001);
+}
+
 void main()
 {
     vec3 diffuseLight = ubo.ambientLightColor.xyz * ubo.ambientLightColor.w;
@@ -37,12 +82,15 @@ void main()
     vec3 cameraPosWorld = ubo.inverseView[3].xyz;
     vec3 viewDirection = normalize(cameraPosWorld - fragPosWorld);
 
-    for(int i = 0; i < ubo.numLights; ++i)
+    const uint cluster = clusterIndex();
+    const uint lightCount = min(countBuffer.counts[cluster], MAX_LIGHTS_PER_CLUSTER);
+
+    for(uint i = 0; i < lightCount; ++i)
     {
-        PointLight light = ubo.pointLights[i];
+        PointLight light = lightBuffer.lights[indexBuffer.indices[cluster * MAX_LIGHTS_PER_CLUSTER + i]];
 
         vec3 directionToLight = light.position.xyz - fragPosWorld;
-        float attenuation = 1.0 / dot(directionToLight, directionToLight); // dot(x, x) == distance^2
+        float attenuation = attenuate(length(directionToLight), light.position.w);
 
         directionToLight = normalize(directionToLight);
         float cosAngIncidence = max(dot(surfaceNormal, directionToLight), 0);
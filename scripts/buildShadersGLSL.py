@@ -11,20 +11,22 @@ import subprocess
 import argparse
 
 parser = argparse.ArgumentParser(description="Compile GLSL shaders to SPIR-V")
-parser.add_argument("--input", required=True, help="Input directory containing .vert/.frag files")
+parser.add_argument("--input", required=True, help="Input directory containing .vert/.frag/.comp files")
 parser.add_argument("--output", required=True, help="Output directory for .spv files")
 args = parser.parse_args()
 
 os.makedirs(args.output, exist_ok=True)
 
 for file in os.listdir(args.input):
-    if file.endswith(".vert") or file.endswith(".frag"):
+    if file.endswith(".vert") or file.endswith(".frag") or file.endswith(".comp"):
         in_path = os.path.join(args.input, file)
 
         if file.endswith(".vert"):
             out_path = os.path.join(args.output, file.removesuffix(".vert") + ".spv")
-        else:
+        elif file.endswith(".frag"):
             out_path = os.path.join(args.output, file.removesuffix(".frag") + ".spv")
+        else:
+            out_path = os.path.join(args.output, file.removesuffix(".comp") + ".spv")
 
         print(f"Compiled {file} -> {out_path}")
         result = subprocess.run(["glslangValidator", "-V", in_path, "-o", out_path])
@@ -23,6 +23,8 @@ for file in os.listdir(args.input):
             stage = "vertex"
         elif "Frag" in file:
             stage = "fragment"
+        elif "Comp" in file:
+            stage = "compute"
         else:
             print(f"Skipping {file}: Unknown shader stage")
             continue
@@ -1,4 +1,5 @@
 #include "Application.hpp"
+#include "core/Swapchain.hpp"
 #include "utility/exceptions/Exception.hpp"
 #include "utility/exceptions/FileException.hpp"
 #include "utility/exceptions/ResourceException.hpp"
@@ -7,13 +8,97 @@
 #include "spdlog/common.h"
 #include "spdlog/spdlog.h"
 
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <system_error>
 
-int main()
+namespace
+{
+
+/// \brief Check whether a command line argument is an option instead of a value
+///
+/// \param arg the command line argument
+///
+/// \returns true if the argument starts with "--"
+bool isOption(std::string_view arg)
+{
+    return arg.starts_with("--");
+}
+
+/// \brief Read the frames in flight from the first command line argument that is not an option
+///
+/// 1 gives the lowest latency, 3 the highest throughput. Invalid values fall back to the default
+///
+/// \param args the command line arguments, including the program name
+///
+/// \returns the frames in flight to use
+std::uint32_t parseFramesInFlight(std::span<char*> args)
+{
+    const auto values{ args.subspan(1) };
+    const auto value{ std::ranges::find_if_not(values, ::isOption) };
+    if(value == values.end())
+        return vv::Swapchain::DEFAULT_FRAMES_IN_FLIGHT;
+
+    const std::string_view arg{ *value };
+    std::uint32_t framesInFlight{ 0 };
+    const auto [end, error]{ std::from_chars(arg.data(), arg.data() + arg.size(), framesInFlight) };
+    if(error != std::errc{} || end != arg.data() + arg.size() || framesInFlight == 0
+       || framesInFlight > vv::Swapchain::MAX_FRAMES_IN_FLIGHT)
+    {
+        spdlog::warn(
+            "Invalid frames in flight '{}', expected 1 to {}. Using {}",
+            arg,
+            vv::Swapchain::MAX_FRAMES_IN_FLIGHT,
+            vv::Swapchain::DEFAULT_FRAMES_IN_FLIGHT
+        );
+        return vv::Swapchain::DEFAULT_FRAMES_IN_FLIGHT;
+    }
+
+    return framesInFlight;
+}
+
+/// \brief Read which benchmarks to run from the options on the command line
+///
+/// --light-stress-test, --depth-prepass-comparison, --recording-benchmark and --serial-asset-loading each enable
+/// one benchmark. Unknown options are skipped with a warning
+///
+/// \param args the command line arguments, including the program name
+///
+/// \returns the benchmarks to run
+vv::BenchmarkOptions parseBenchmarks(std::span<char*> args)
+{
+    vv::BenchmarkOptions benchmarks{};
+    for(const std::string_view arg : args.subspan(1) | std::views::filter(::isOption))
+    {
+        if(arg == "--light-stress-test")
+            benchmarks.lightStressTest = true;
+        else if(arg == "--depth-prepass-comparison")
+            benchmarks.depthPrepassComparison = true;
+        else if(arg == "--recording-benchmark")
+            benchmarks.recordingBenchmark = true;
+        else if(arg == "--serial-asset-loading")
+            benchmarks.serialAssetLoading = true;
+        else
+            spdlog::warn("Unknown option '{}'", arg);
+    }
+
+    return benchmarks;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
 {
     try
     {
-        vv::Application app{};
+        const std::span<char*> args{ argv, static_cast<std::size_t>(argc) };
+        vv::Application app{ ::parseFramesInFlight(args), ::parseBenchmarks(args) };
         app.run();
     }
     catch(const vv::VulkanException& e)
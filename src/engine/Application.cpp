@@ -1,20 +1,29 @@
 #include "Application.hpp"
 
 #include "core/Buffer.hpp"
+#include "core/DepthPyramid.hpp"
 #include "core/DescriptorPool.hpp"
 #include "core/DescriptorSetLayout.hpp"
 #include "core/DescriptorWriter.hpp"
 #include "core/Device.hpp"
+#include "core/GpuCuller.hpp"
+#include "core/GpuTimer.hpp"
+#include "core/LightClusterer.hpp"
+#include "core/PipelineStatistics.hpp"
+#include "core/RenderGraph.hpp"
 #include "core/Renderer.hpp"
-#include "core/Swapchain.hpp"
 #include "core/Texture2D.hpp"
+#include "core/UploadManager.hpp"
 #include "core/Window.hpp"
 #include "renderSystems/BasicRenderSystem.hpp"
 #include "renderSystems/PBRRenderSystem.hpp"
 #include "renderSystems/PointLightRenderSystem.hpp"
+#include "utility/AssetLoader.hpp"
 #include "utility/Camera.hpp"
 #include "utility/FrameInfo.hpp"
 #include "utility/KeyboardMovementController.hpp"
+#include "utility/RenderGraphCompiler.hpp"
+#include "utility/ThreadPool.hpp"
 #include "utility/object/Object.hpp"
 #include "utility/object/ObjectBuilder.hpp"
 
@@ -24,29 +33,56 @@
 #include "glm/ext/matrix_transform.hpp"
 #include "glm/glm.hpp"
 #include "glm/gtc/constants.hpp"
+#include "spdlog/spdlog.h"
 #include <vulkan/vulkan_core.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <random>
+#include <string_view>
+#include <thread>
 #include <vector>
 
+namespace
+{
+
+/// \brief How many threads share some work, one per hardware thread up to a limit
+///
+/// \param maxThreads the most threads that are used
+///
+/// \returns the thread count, at least one
+std::size_t hardwareThreadCount(std::size_t maxThreads)
+{
+    return std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, maxThreads);
+}
+
+} // namespace
+
 namespace vv
 {
 
-Application::Application()
+Application::Application(std::uint32_t framesInFlight, const BenchmarkOptions& benchmarks)
     : m_window{ std::make_shared<Window>(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE) }
     , m_device{ std::make_shared<Device>(m_window) }
+    , m_threadPool{ std::make_unique<ThreadPool>(
+          MULTITHREADED_RECORDING && !benchmarks.depthPrepassComparison ? ::hardwareThreadCount(MAX_RECORDING_THREADS)
+                                                                         : 1
+      ) }
     , m_globalPool{ DescriptorPool::Builder(m_device)
-                        .setMaxSets(Swapchain::MAX_FRAMES_IN_FLIGHT)
-                        .addPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, Swapchain::MAX_FRAMES_IN_FLIGHT)
+                        .setMaxSets(framesInFlight)
+                        .addPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight)
                         .build() }
-    , m_renderer{ std::make_unique<Renderer>(m_window, m_device) }
-    , m_uboBuffers(Swapchain::MAX_FRAMES_IN_FLIGHT)
+    , m_renderer{ std::make_unique<Renderer>(m_window, m_device, framesInFlight, m_threadPool->getThreadCount()) }
+    , m_uboBuffers(framesInFlight)
     , m_globalSetLayout{ DescriptorSetLayout::Builder(m_device)
                              .addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_ALL_GRAPHICS)
                              .buildShared() }
-    , m_globalDescriptorSets(Swapchain::MAX_FRAMES_IN_FLIGHT)
+    , m_globalDescriptorSets(framesInFlight)
+    , m_benchmarks{ benchmarks }
 {
     for(std::size_t i{ 0 }; i < m_uboBuffers.size(); ++i)
         m_uboBuffers[i] = std::make_unique<Buffer>(Buffer::createUniformBuffer(m_device, sizeof(GlobalUBO), 1));
@@ -60,17 +96,38 @@ Application::Application()
             .build(m_globalDescriptorSets[i]);
     }
 
+    m_lightClusterer = std::make_unique<LightClusterer>(m_device, framesInFlight);
+    m_renderGraph = std::make_unique<RenderGraph>(m_device);
+    const VkDescriptorSetLayout lightSetLayout{ m_lightClusterer->getSetLayout()->getDescriptorLayout() };
+
     m_basicRenderSystem = std::make_unique<BasicRenderSystem>(
-        m_device, m_renderer->getRenderPass(), m_globalSetLayout->getDescriptorLayout()
+        m_device, m_renderer->getRenderPass(), m_globalSetLayout->getDescriptorLayout(), lightSetLayout
     );
     m_pointLightRenderSystem = std::make_unique<PointLightRenderSystem>(
-        m_device, m_renderer->getRenderPass(), m_globalSetLayout->getDescriptorLayout()
+        m_device, m_renderer->getRenderPass(), m_globalSetLayout->getDescriptorLayout(), framesInFlight
     );
     m_pbrRenderSystem = std::make_unique<PBRRenderSystem>(
-        m_device, m_renderer->getRenderPass(), m_globalSetLayout->getDescriptorLayout()
+        m_device, m_renderer->getRenderPass(), m_globalSetLayout->getDescriptorLayout(), lightSetLayout, framesInFlight
     );
-    m_scene = std::make_unique<Scene>(m_device, m_pbrRenderSystem->getMaterialSetLayout());
+    m_pbrRenderSystem->setRenderMode(PBR_RENDER_MODE);
+    m_pbrRenderSystem->setDepthPrepass(PBR_DEPTH_PREPASS);
+    if(m_pbrRenderSystem->getRenderMode() == PBRRenderMode::GpuCulled)
+        m_depthPyramid = std::make_unique<DepthPyramid>(m_device);
+    m_scene = std::make_unique<Scene>(m_device, m_pbrRenderSystem->getMaterialTable());
     initScene();
+
+    if(m_benchmarks.lightStressTest)
+        addStressLights(LIGHT_STRESS_STEPS[m_lightStressStep++]);
+
+    if(MULTITHREADED_RECORDING && m_benchmarks.depthPrepassComparison)
+    {
+        spdlog::warn("The depth prepass comparison needs pipeline statistics, the main pass is recorded on one thread");
+        m_multithreadedRecording = false;
+    }
+
+    m_recordingThreads = m_threadPool->getThreadCount();
+    if(m_benchmarks.recordingBenchmark)
+        m_recordingThreads = std::min(RECORDING_BENCHMARK_STEPS[m_recordingBenchmarkStep++], m_recordingThreads);
 }
 
 void Application::run()
@@ -80,6 +137,7 @@ void Application::run()
     viewer->getComponent<TransformComponent>()->translation.z = CAMERA_START_OFFSET_Z;
 
     auto currentTime{ std::chrono::high_resolution_clock::now() };
+    float timeSinceStatsLog{ 0.f };
 
     while(!m_window->shouldClose())
     {
@@ -96,10 +154,7 @@ void Application::run()
         );
 
         const float aspectRatio{ m_renderer->getAspectRatio() };
-        constexpr float fov{ 50.f };
-        constexpr float nearPlane{ 0.1f };
-        constexpr float farPlane{ 100.f };
-        camera->setPerspectiveProjection(glm::radians(fov), aspectRatio, nearPlane, farPlane);
+        camera->setPerspectiveProjection(glm::radians(CAMERA_FOV), aspectRatio, CAMERA_NEAR_PLANE, CAMERA_FAR_PLANE);
 
         if(auto* const commandBuffer{ m_renderer->beginFrame() })
         {
@@ -109,6 +164,7 @@ void Application::run()
                                  .commandBuffer = commandBuffer,
                                  .camera = camera,
                                  .globalDescriptorSet = m_globalDescriptorSets[frameIndex],
+                                 .lightDescriptorSet = m_lightClusterer->getDescriptorSet(frameIndex),
                                  .objects = m_scene->getObjects(),
                                  .lights = m_scene->getPointLights() };
             GlobalUBO ubo{};
@@ -117,24 +173,434 @@ void Application::run()
             ubo.inverseView = camera->getInverseView();
 
             m_pointLightRenderSystem->update(frameInfo, ubo);
+            m_pbrRenderSystem->update(frameInfo, ubo);
+            m_lightClusterer->update(
+                frameIndex,
+                m_pointLightRenderSystem->getLights(),
+                ubo.view,
+                ubo.projection,
+                CAMERA_NEAR_PLANE,
+                CAMERA_FAR_PLANE,
+                m_renderer->getSwapchainExtent()
+            );
 
             m_uboBuffers[frameIndex]->writeToBuffer(ubo);
 
-            m_renderer->beginRenderPass(commandBuffer);
+            GpuTimer& gpuTimer{ m_renderer->getGpuTimer() };
+            gpuTimer.beginScope(commandBuffer, "frame");
+
+            // NOTE: Culls against the depth pyramid that the previous frame left behind
+            if(m_depthPyramid != nullptr)
+                m_depthPyramid->prepare(commandBuffer, m_renderer->getSwapchainExtent());
 
-            m_pbrRenderSystem->render(frameInfo);
-            m_pointLightRenderSystem->render(frameInfo);
+            declareRenderGraph(frameInfo);
+            m_renderGraph->compile();
+            m_renderGraph->execute(commandBuffer);
 
-            m_renderer->endRenderPass(commandBuffer);
+            gpuTimer.endScope(commandBuffer);
             m_renderer->endFrame();
         }
+
+        timeSinceStatsLog += dt;
+        if(timeSinceStatsLog >= FRAME_STATS_LOG_INTERVAL)
+        {
+            logFrameStats();
+            logRecordingTime();
+            timeSinceStatsLog = 0.f;
+
+            // NOTE: Evicted textures and models are destroyed once the frames in flight that may use them are done
+            if(const std::size_t evicted{ m_scene->trimCaches() }; evicted > 0)
+                spdlog::info("Scene caches: {} unused resources evicted", evicted);
+
+            if(m_benchmarks.depthPrepassComparison)
+                compareDepthPrepass();
+
+            if(m_benchmarks.lightStressTest && m_lightStressStep < LIGHT_STRESS_STEPS.size())
+                addStressLights(LIGHT_STRESS_STEPS[m_lightStressStep++]);
+
+            if(m_benchmarks.recordingBenchmark && m_recordingBenchmarkStep < RECORDING_BENCHMARK_STEPS.size())
+            {
+                m_recordingThreads = std::min(
+                    RECORDING_BENCHMARK_STEPS[m_recordingBenchmarkStep++], m_threadPool->getThreadCount()
+                );
+            }
+        }
     }
 
     vkDeviceWaitIdle(m_device->device());
 }
 
+/// \brief Declare the passes of a frame and the resources they share in the render graph
+///
+/// \param frameInfo \ref FrameInfo of the frame that is recorded, has to outlive the execution of the graph
+void Application::declareRenderGraph(const FrameInfo& frameInfo)
+{
+    RenderGraph& graph{ *m_renderGraph };
+    GpuTimer& gpuTimer{ m_renderer->getGpuTimer() };
+    const std::size_t frameIndex{ frameInfo.frameIndex };
+
+    graph.reset();
+
+    // NOTE: The render pass clears the depth image, so it only waits for the last frame that used the image
+    const VkFormat depthFormat{ m_renderer->getDepthFormat() };
+    VkImageAspectFlags depthAspect{ VK_IMAGE_ASPECT_DEPTH_BIT };
+    if(depthFormat == VK_FORMAT_D32_SFLOAT_S8_UINT || depthFormat == VK_FORMAT_D24_UNORM_S8_UINT)
+        depthAspect |= VK_IMAGE_ASPECT_STENCIL_BIT;
+
+    const VkImageSubresourceRange depthRange{
+        .aspectMask = depthAspect, .baseMipLevel = 0, .levelCount = 1, .baseArrayLayer = 0, .layerCount = 1
+    };
+    constexpr RenderGraphAccess PREVIOUS_DEPTH_ACCESS{
+        .stages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT
+                  | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        .accessMask = 0,
+        .layout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .finalLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .write = false
+    };
+    const RenderGraphImage depth{
+        graph.importImage(m_renderer->getCurrentDepthImage(), depthRange, PREVIOUS_DEPTH_ACCESS)
+    };
+    const RenderGraphBuffer lightCounts{ graph.importBuffer(m_lightClusterer->getCountBuffer(frameIndex)) };
+    const RenderGraphBuffer lightIndices{ graph.importBuffer(m_lightClusterer->getIndexBuffer(frameIndex)) };
+
+    const bool gpuCulled{ m_depthPyramid != nullptr };
+    RenderGraphImage pyramid{};
+    RenderGraphBuffer drawCommands{};
+    RenderGraphBuffer drawCounts{};
+    if(gpuCulled)
+    {
+        const GpuCuller& culler{ *m_pbrRenderSystem->getGpuCuller() };
+
+        // NOTE: The pyramid was last written by the previous frame, or transitioned by prepare() if it was recreated
+        pyramid = graph.importImage(
+            m_depthPyramid->getImage(), m_depthPyramid->getSubresourceRange(), RenderGraphAccess::computeShaderWrite()
+        );
+        drawCommands = graph.importBuffer(culler.getCommandBuffer(frameIndex));
+        drawCounts = graph.importBuffer(culler.getCountBuffer(frameIndex));
+
+        graph
+            .addPass(
+                "culling",
+                [this, &gpuTimer, &frameInfo](VkCommandBuffer commandBuffer) {
+                    gpuTimer.beginScope(commandBuffer, "culling");
+                    m_pbrRenderSystem->cull(frameInfo, *m_depthPyramid);
+                    gpuTimer.endScope(commandBuffer);
+                }
+            )
+            .read(pyramid, RenderGraphAccess::computeShaderRead(VK_IMAGE_LAYOUT_GENERAL))
+            .write(drawCommands, RenderGraphAccess::computeShaderWrite())
+            .write(drawCounts, RenderGraphAccess::computeShaderWrite());
+    }
+
+    graph
+        .addPass(
+            "light clustering",
+            [this, &gpuTimer, frameIndex](VkCommandBuffer commandBuffer) {
+                gpuTimer.beginScope(commandBuffer, "light clustering");
+                m_lightClusterer->build(commandBuffer, frameIndex);
+                gpuTimer.endScope(commandBuffer);
+            }
+        )
+        .write(lightCounts, RenderGraphAccess::computeShaderWrite())
+        .write(lightIndices, RenderGraphAccess::computeShaderWrite());
+
+    auto mainPass{ graph.addPass("main", [this, &frameInfo](VkCommandBuffer) {
+        const auto recordingStart{ std::chrono::steady_clock::now() };
+
+        if(m_multithreadedRecording)
+            recordMainPassInParallel(frameInfo);
+        else
+            recordMainPass(frameInfo);
+
+        m_recordingTime += std::chrono::steady_clock::now() - recordingStart;
+        ++m_recordedFrames;
+    }) };
+    // NOTE: The swapchain image is presented, which the graph does not see
+    mainPass.write(depth, RenderGraphAccess::depthAttachmentWrite(VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL))
+        .read(lightCounts, RenderGraphAccess::fragmentShaderRead())
+        .read(lightIndices, RenderGraphAccess::fragmentShaderRead())
+        .setSideEffects();
+
+    if(!gpuCulled)
+        return;
+
+    mainPass.read(drawCommands, RenderGraphAccess::indirectRead()).read(drawCounts, RenderGraphAccess::indirectRead());
+
+    graph
+        .addPass(
+            "depth pyramid",
+            [this, &gpuTimer](VkCommandBuffer commandBuffer) {
+                gpuTimer.beginScope(commandBuffer, "depth pyramid");
+                m_depthPyramid->build(
+                    commandBuffer, m_renderer->getFrameDescriptorAllocator(), m_renderer->getCurrentDepthImageView()
+                );
+                gpuTimer.endScope(commandBuffer);
+            }
+        )
+        .read(depth, RenderGraphAccess::computeShaderRead(VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL))
+        .write(pyramid, RenderGraphAccess::computeShaderWrite());
+}
+
+/// \brief Record the main render pass with the depth prepass, the PBR shading and the point lights inline
+///
+/// \param frameInfo \ref FrameInfo of the frame that is recorded
+void Application::recordMainPass(const FrameInfo& frameInfo)
+{
+    GpuTimer& gpuTimer{ m_renderer->getGpuTimer() };
+    PipelineStatistics& pipelineStatistics{ m_renderer->getPipelineStatistics() };
+    VkCommandBuffer commandBuffer{ frameInfo.commandBuffer };
+
+    m_renderer->beginRenderPass(commandBuffer);
+
+    if(m_pbrRenderSystem->hasDepthPrepass())
+    {
+        gpuTimer.beginScope(commandBuffer, "depth prepass");
+        pipelineStatistics.beginScope(commandBuffer, "depth prepass");
+        m_pbrRenderSystem->renderDepthPrepass(frameInfo);
+        pipelineStatistics.endScope(commandBuffer);
+        gpuTimer.endScope(commandBuffer);
+    }
+
+    gpuTimer.beginScope(commandBuffer, "pbr");
+    pipelineStatistics.beginScope(commandBuffer, "pbr");
+    m_pbrRenderSystem->render(frameInfo);
+    pipelineStatistics.endScope(commandBuffer);
+    gpuTimer.endScope(commandBuffer);
+
+    gpuTimer.beginScope(commandBuffer, "point lights");
+    m_pointLightRenderSystem->render(frameInfo);
+    gpuTimer.endScope(commandBuffer);
+
+    m_renderer->endRenderPass(commandBuffer);
+}
+
+/// \brief Record the main render pass into secondary command buffers, with the PBR draws split between threads
+///
+/// \param frameInfo \ref FrameInfo of the frame that is recorded
+void Application::recordMainPassInParallel(const FrameInfo& frameInfo)
+{
+    GpuTimer& gpuTimer{ m_renderer->getGpuTimer() };
+    m_secondaryCommandBuffers.clear();
+
+    m_renderer->beginRenderPass(frameInfo.commandBuffer, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+    const std::size_t drawCount{ m_pbrRenderSystem->getDrawCount() };
+    if(m_pbrRenderSystem->hasDepthPrepass())
+    {
+        recordInParallel(
+            frameInfo,
+            "depth prepass",
+            drawCount,
+            [this](const FrameInfo& rangeInfo, std::size_t first, std::size_t count) {
+                m_pbrRenderSystem->renderDepthPrepass(rangeInfo, first, count);
+            }
+        );
+    }
+
+    recordInParallel(
+        frameInfo, "pbr", drawCount, [this](const FrameInfo& rangeInfo, std::size_t first, std::size_t count) {
+            m_pbrRenderSystem->render(rangeInfo, first, count);
+        }
+    );
+
+    // NOTE: The point lights are a single instanced draw, which is not worth another thread
+    FrameInfo lightInfo{ frameInfo };
+    lightInfo.commandBuffer = m_renderer->beginSecondaryCommandBuffer(0);
+    gpuTimer.beginScope(lightInfo.commandBuffer, "point lights");
+    m_pointLightRenderSystem->render(lightInfo);
+    gpuTimer.endScope(lightInfo.commandBuffer);
+    m_renderer->endSecondaryCommandBuffer(lightInfo.commandBuffer);
+    m_secondaryCommandBuffers.push_back(lightInfo.commandBuffer);
+
+    m_renderer->executeSecondaryCommandBuffers(frameInfo.commandBuffer, m_secondaryCommandBuffers);
+    m_renderer->endRenderPass(frameInfo.commandBuffer);
+}
+
+/// \brief Split draws into ranges and record each range into its own secondary command buffer on its own thread
+///
+/// The finished command buffers are appended to the secondary command buffers of the main render pass in the order
+/// of their ranges, so the draws execute in the same order as when they are recorded by a single thread
+///
+/// \param frameInfo \ref FrameInfo of the frame that is recorded
+/// \param scope name of the GPU timer scope around the draws
+/// \param drawCount how many draws there are
+/// \param record records a range of the draws into the command buffer of the \ref FrameInfo that it gets
+void Application::recordInParallel(
+    const FrameInfo& frameInfo,
+    std::string_view scope,
+    std::size_t drawCount,
+    const std::function<void(const FrameInfo&, std::size_t, std::size_t)>& record
+)
+{
+    GpuTimer& gpuTimer{ m_renderer->getGpuTimer() };
+    const std::size_t minDraws{ m_benchmarks.recordingBenchmark ? 1 : MIN_DRAWS_PER_RECORDING_THREAD };
+    const std::size_t rangeCount{
+        std::clamp<std::size_t>((drawCount + minDraws - 1) / minDraws, 1, m_recordingThreads)
+    };
+
+    m_rangeCommandBuffers.assign(rangeCount, VK_NULL_HANDLE);
+    m_threadPool->parallelFor(drawCount, rangeCount, [&](std::size_t begin, std::size_t end, std::size_t thread) {
+        FrameInfo rangeInfo{ frameInfo };
+        rangeInfo.commandBuffer = m_renderer->beginSecondaryCommandBuffer(thread);
+        m_rangeCommandBuffers[thread] = rangeInfo.commandBuffer;
+
+        // NOTE: The GPU timer is not thread safe, so only the calling thread (thread 0) may use it
+        if(thread == 0)
+            gpuTimer.beginScope(rangeInfo.commandBuffer, scope);
+
+        record(rangeInfo, begin, end - begin);
+    });
+
+    // NOTE: The workers are done, so the calling thread can finish their command buffers
+    gpuTimer.endScope(m_rangeCommandBuffers.back());
+    for(auto* const commandBuffer : m_rangeCommandBuffers)
+    {
+        m_renderer->endSecondaryCommandBuffer(commandBuffer);
+        m_secondaryCommandBuffers.push_back(commandBuffer);
+    }
+}
+
+/// \brief Print the average CPU time that recording the main render pass took since the last stats log
+void Application::logRecordingTime()
+{
+    if(m_recordedFrames == 0)
+        return;
+
+    spdlog::info(
+        "CPU main pass recording: {:.3f} ms on {} threads",
+        m_recordingTime.count() / static_cast<double>(m_recordedFrames),
+        m_recordingThreads
+    );
+
+    m_recordingTime = {};
+    m_recordedFrames = 0;
+}
+
+/// \brief Print the draw statistics and GPU timings of the most recently completed frame
+void Application::logFrameStats() const
+{
+    const auto& pbrStats{ m_pbrRenderSystem->getStats() };
+    spdlog::info(
+        "PBR draws: {} objects, {} visible ({} occluded) -> {} draw calls",
+        pbrStats.objects,
+        pbrStats.visibleObjects,
+        pbrStats.occlusionCulled,
+        pbrStats.drawCalls
+    );
+    spdlog::info(
+        "PBR binds: {} materials, {} models, {} binds saved by sorting",
+        pbrStats.materialBinds,
+        pbrStats.modelBinds,
+        pbrStats.bindsSkipped
+    );
+    spdlog::info("Lights: {}", m_pointLightRenderSystem->getLights().size());
+    spdlog::info(
+        "Render graph: {} of {} passes, {} barriers, {} byte transient memory",
+        m_renderGraph->getExecutedPassCount(),
+        m_renderGraph->getPassCount(),
+        m_renderGraph->getBarrierCount(),
+        m_renderGraph->getTransientMemorySize()
+    );
+
+    for(const auto& result : m_renderer->getPipelineStatistics().getResults())
+    {
+        spdlog::info(
+            "Invocations {}: {} vertex, {} fragment",
+            result.name,
+            result.vertexShaderInvocations,
+            result.fragmentShaderInvocations
+        );
+    }
+
+    const GpuTimer& gpuTimer{ m_renderer->getGpuTimer() };
+    if(!gpuTimer.isSupported())
+        return;
+
+    for(const auto& result : gpuTimer.getResults())
+        spdlog::info("GPU {}: {:.3f} ms", result.name, result.milliseconds);
+}
+
+/// \brief Remember the PBR fragment shader invocations of the current depth prepass setting and switch it
+///
+/// Once both settings were measured, the invocations that the prepass saves are logged
+void Application::compareDepthPrepass()
+{
+    const bool prepass{ m_pbrRenderSystem->hasDepthPrepass() };
+    for(const auto& result : m_renderer->getPipelineStatistics().getResults())
+    {
+        if(result.name == "pbr")
+            (prepass ? m_pbrFragmentsWithPrepass : m_pbrFragmentsWithoutPrepass) = result.fragmentShaderInvocations;
+    }
+
+    if(m_pbrFragmentsWithPrepass != 0 && m_pbrFragmentsWithoutPrepass != 0)
+    {
+        const auto saved{ static_cast<std::int64_t>(m_pbrFragmentsWithoutPrepass)
+                          - static_cast<std::int64_t>(m_pbrFragmentsWithPrepass) };
+        spdlog::info(
+            "Depth prepass saves {} PBR fragment shader invocations ({:.1f}%)",
+            saved,
+            100.0 * static_cast<double>(saved) / static_cast<double>(m_pbrFragmentsWithoutPrepass)
+        );
+    }
+
+    m_pbrRenderSystem->setDepthPrepass(!prepass);
+}
+
+/// \brief Add randomly placed lights to the scene until it contains a certain amount of lights
+///
+/// The lights are small and dim so that each of them only reaches a few clusters, like the many local lights that
+/// clustered shading is meant for
+///
+/// \param lightCount how many lights the scene should contain
+void Application::addStressLights(std::size_t lightCount)
+{
+    std::uniform_real_distribution<float> horizontal{ -6.f, 6.f };
+    std::uniform_real_distribution<float> vertical{ -1.5f, 0.3f };
+    std::uniform_real_distribution<float> color{ 0.2f, 1.f };
+
+    for(std::size_t i{ m_scene->getPointLights().size() }; i < lightCount; ++i)
+    {
+        const glm::vec3 position{ horizontal(m_stressLightRandom),
+                                  vertical(m_stressLightRandom),
+                                  horizontal(m_stressLightRandom) };
+        const glm::vec3 lightColor{ color(m_stressLightRandom),
+                                    color(m_stressLightRandom),
+                                    color(m_stressLightRandom) };
+        m_scene->addPointlight(
+            ObjectBuilder().withPointLight(STRESS_LIGHT_INTENSITY, lightColor).withTransform(position).build()
+        );
+    }
+}
+
 void Application::initScene()
 {
+    UploadManager& uploads{ m_device->uploadManager() };
+    const std::size_t batchesBefore{ uploads.getSubmittedBatches() };
+    const VkDeviceSize bytesBefore{ uploads.getUploadedBytes() };
+    const auto loadStart{ std::chrono::steady_clock::now() };
+
+    // NOTE: Every file is decoded on a worker right away. The scene is built in the meantime and waits for an asset
+    // only when it is needed, which then records its upload into the current upload batch. Files that the scene has
+    // cached or that are already in flight are not loaded again
+    AssetLoader assets{
+        m_device, m_benchmarks.serialAssetLoading ? 1 : ::hardwareThreadCount(MAX_ASSET_LOADER_THREADS)
+    };
+    const auto rustedAlbedo{ m_scene->loadTexture(assets, MATERIAL_ALBEDO_PATH_RUSTED, TextureConfig::albedo()) };
+    const auto rustedNormal{ m_scene->loadTexture(assets, MATERIAL_NORMAL_PATH_RUSTED, TextureConfig::normal()) };
+    const auto rustedMetallicRoughness{
+        m_scene->loadTexture(assets, MATERIAL_METALLIC_ROUGHNESS_PATH_RUSTED, TextureConfig::albedo())
+    };
+    const auto brickAlbedo{ m_scene->loadTexture(assets, MATERIAL_ALBEDO_PATH_BRICK, TextureConfig::albedo()) };
+    const auto brickNormal{ m_scene->loadTexture(assets, MATERIAL_NORMAL_PATH_BRICK, TextureConfig::normal()) };
+    const auto brickMetallicRoughness{
+        m_scene->loadTexture(assets, MATERIAL_METALLIC_ROUGHNESS_PATH_BRICK, TextureConfig::albedo())
+    };
+    const auto brickOcclusion{ m_scene->loadTexture(assets, MATERIAL_OCCLUSION_PATH_BRICK, TextureConfig::albedo()) };
+    const auto sphereModel{ m_scene->loadModel(assets, SPHERE_PATH) };
+    const auto quadModel{ m_scene->loadModel(assets, QUAD_PATH) };
+    const std::size_t assetCount{ assets.getPendingCount() };
+
     constexpr glm::vec3 OBJ_SACLE{
         glm::vec3{ 0.5f, 0.5f, 0.5f }
     };
@@ -142,31 +608,43 @@ void Application::initScene()
         glm::vec3{ 0.f, 0.f, 0.f }
     };
     MaterialConfig matConfigMetal{};
-    std::shared_ptr<Texture2D> texture{ std::make_shared<Texture2D>(
-        Texture2D::loadFromFile(m_device, MATERIAL_ALBEDO_PATH_RUSTED, TextureConfig::albedo())
-    ) };
-    matConfigMetal.albedoTexture = texture;
-    texture = std::make_shared<Texture2D>(
-        Texture2D::loadFromFile(m_device, MATERIAL_NORMAL_PATH_RUSTED, TextureConfig::normal())
-    );
-    matConfigMetal.normalTexture = texture;
-    texture = std::make_shared<Texture2D>(
-        Texture2D::loadFromFile(m_device, MATERIAL_METALLIC_ROUGHNESS_PATH_RUSTED, TextureConfig::albedo())
-    );
-    matConfigMetal.metallicRoughnessTexture = texture;
+    matConfigMetal.albedoTexture = assets.get(rustedAlbedo);
+    matConfigMetal.normalTexture = assets.get(rustedNormal);
+    matConfigMetal.metallicRoughnessTexture = assets.get(rustedMetallicRoughness);
     // texture = std::make_shared<Texture2D>(
     //     Texture2D::loadFromFile(m_device, MATERIAL_OCCLUSION_PATH_METAL, TextureConfig::albedo())
     // );
     // matConfigMetal.occlusionTexture = texture;
 
     auto material = m_scene->createMaterial(matConfigMetal);
-    std::shared_ptr<Model> model = Model::loadFromFile(m_device, SPHERE_PATH);
+    std::shared_ptr<Model> model{ assets.get(sphereModel) };
     Object smoothVase{
         ObjectBuilder().withModel(model).withTransform(OBJ_POS, OBJ_SACLE).withMaterial(material).build()
     };
 
     m_scene->addObject(std::move(smoothVase));
 
+    // NOTE: A grid of small spheres that share the model and material above, which the batched PBR render modes
+    // draw with a single instanced draw
+    constexpr float GRID_SPACING{ 0.5f };
+    constexpr float GRID_SPHERE_SCALE{ 0.1f };
+    constexpr float GRID_HEIGHT{ 0.4f };
+    const float gridOffset{ static_cast<float>(SPHERE_GRID_SIZE - 1) * GRID_SPACING / 2.f };
+    for(std::uint32_t x{ 0 }; x < SPHERE_GRID_SIZE; ++x)
+    {
+        for(std::uint32_t z{ 0 }; z < SPHERE_GRID_SIZE; ++z)
+        {
+            const glm::vec3 position{ (static_cast<float>(x) * GRID_SPACING) - gridOffset,
+                                      GRID_HEIGHT,
+                                      (static_cast<float>(z) * GRID_SPACING) - gridOffset };
+            m_scene->addObject(ObjectBuilder()
+                                   .withModel(model)
+                                   .withTransform(position, glm::vec3{ GRID_SPHERE_SCALE })
+                                   .withMaterial(material)
+                                   .build());
+        }
+    }
+
     constexpr glm::vec3 floorPos{
         glm::vec3{ 0.f, 0.5f, 0.f }
     };
@@ -175,31 +653,37 @@ void Application::initScene()
     };
 
     MaterialConfig matConfigBrick{};
-    texture = std::make_shared<Texture2D>(
-        Texture2D::loadFromFile(m_device, MATERIAL_ALBEDO_PATH_BRICK, TextureConfig::albedo())
-    );
-    matConfigMetal.albedoTexture = texture;
-    texture = std::make_shared<Texture2D>(
-        Texture2D::loadFromFile(m_device, MATERIAL_NORMAL_PATH_BRICK, TextureConfig::normal())
-    );
-    matConfigMetal.normalTexture = texture;
-    texture = std::make_shared<Texture2D>(
-        Texture2D::loadFromFile(m_device, MATERIAL_METALLIC_ROUGHNESS_PATH_BRICK, TextureConfig::albedo())
-    );
-    matConfigMetal.metallicRoughnessTexture = texture;
-    texture = std::make_shared<Texture2D>(
-        Texture2D::loadFromFile(m_device, MATERIAL_OCCLUSION_PATH_BRICK, TextureConfig::albedo())
-    );
-    matConfigMetal.occlusionTexture = texture;
+    matConfigMetal.albedoTexture = assets.get(brickAlbedo);
+    matConfigMetal.normalTexture = assets.get(brickNormal);
+    matConfigMetal.metallicRoughnessTexture = assets.get(brickMetallicRoughness);
+    matConfigMetal.occlusionTexture = assets.get(brickOcclusion);
     material = m_scene->createMaterial(matConfigMetal);
 
-    model = Model::loadFromFile(m_device, QUAD_PATH);
+    model = assets.get(quadModel);
     Object floor{ ObjectBuilder().withModel(model).withTransform(floorPos, floorScale).withMaterial(material).build() };
     m_scene->addObject(std::move(floor));
 
     m_scene->addPointlight(
         ObjectBuilder().withPointLight(50.f, glm::vec3(1.f, 1.f, 1.f)).withTransform(glm::vec3(2.f, -2.f, -1.f)).build()
     );
+
+    const auto recorded{ std::chrono::steady_clock::now() };
+    uploads.flushAndWait();
+    const auto loadEnd{ std::chrono::steady_clock::now() };
+
+    spdlog::info(
+        "Scene load: {} assets on {} threads in {:.3f} ms, {:.3f} ms of it waiting for {} upload batches with {} byte",
+        assetCount,
+        assets.getThreadCount(),
+        std::chrono::duration<double, std::milli>(loadEnd - loadStart).count(),
+        std::chrono::duration<double, std::milli>(loadEnd - recorded).count(),
+        uploads.getSubmittedBatches() - batchesBefore,
+        uploads.getUploadedBytes() - bytesBefore
+    );
+
+    // NOTE: Files that were loaded but are not used by the scene are not kept around
+    m_scene->trimCaches();
+
     // m_scene->addPointlight(ObjectBuilder().withPointLight(20.f, glm::vec3(0.8f, 0.8f, 1.f)).withTransform(glm::vec3(-2.f, -1.f, 0.f)).build());
 
     // constexpr auto COLOR_RED{
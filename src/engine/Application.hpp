@@ -1,22 +1,58 @@
 #ifndef VULKAN_VOXELS_SRC_ENGINE_APPLICATION_HPP
 #define VULKAN_VOXELS_SRC_ENGINE_APPLICATION_HPP
 
+#include "core/DepthPyramid.hpp"
 #include "core/DescriptorPool.hpp"
 #include "core/Device.hpp"
+#include "core/LightClusterer.hpp"
+#include "core/RenderGraph.hpp"
 #include "core/Renderer.hpp"
+#include "core/Swapchain.hpp"
 #include "core/Window.hpp"
 #include "renderSystems/BasicRenderSystem.hpp"
 #include "renderSystems/PBRRenderSystem.hpp"
 #include "renderSystems/PointLightRenderSystem.hpp"
+#include "utility/FrameInfo.hpp"
 #include "utility/Scene.hpp"
+#include "utility/ThreadPool.hpp"
 
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <random>
+#include <string_view>
+#include <vector>
 
 
 namespace vv
 {
 
+/// \brief Benchmarks that the \ref Application runs, each of them logs its results together with the frame stats
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct BenchmarkOptions
+{
+    /// \brief Fill the scene with more and more random lights, one step per stats log, to time the clustered shading
+    bool lightStressTest{ false };
+    /// \brief Toggle the depth prepass at every stats log and report how many fragment shader invocations it saves
+    ///
+    /// Needs the pipeline statistics, so the main render pass is recorded on one thread while it runs
+    bool depthPrepassComparison{ false };
+    /// \brief Use more and more recording threads, one step per stats log, to time the multithreaded recording
+    ///
+    /// Most telling with \ref PBRRenderMode::PerObject and a large \ref Application::SPHERE_GRID_SIZE, since the
+    /// batched modes record only one draw per model
+    bool recordingBenchmark{ false };
+    /// \brief Decode the scene's files on a single worker, to compare the load time that the scene setup logs
+    bool serialAssetLoading{ false };
+};
+
 /// \brief The Application coordinates everything to work with each other
 ///
 /// \author Felix Hommel
@@ -24,7 +60,14 @@ namespace vv
 class Application
 {
 public:
-    Application();
+    /// \brief Create a new \ref Application
+    ///
+    /// \param framesInFlight how many frames the CPU may record ahead of the GPU. 1 gives the lowest latency, up to
+    /// \ref Swapchain::MAX_FRAMES_IN_FLIGHT the highest throughput
+    /// \param benchmarks the \ref BenchmarkOptions to run
+    explicit Application(
+        std::uint32_t framesInFlight = Swapchain::DEFAULT_FRAMES_IN_FLIGHT, const BenchmarkOptions& benchmarks = {}
+    );
     ~Application() = default;
 
     Application(const Application&) = delete;
@@ -48,6 +91,27 @@ private:
     static constexpr auto QUAD_PATH{ PROJECT_ROOT "resources/models/quad.obj" };
     static constexpr auto POINT_LIGHT_INTENSITY{ 10.f };
     static constexpr auto CAMERA_START_OFFSET_Z{ -2.5f };
+    static constexpr float FRAME_STATS_LOG_INTERVAL{ 5.f };
+    static constexpr PBRRenderMode PBR_RENDER_MODE{ PBRRenderMode::GpuCulled };
+    static constexpr bool PBR_DEPTH_PREPASS{ true };
+    /// \brief Record the main render pass into secondary command buffers on multiple threads
+    ///
+    /// Pipeline statistics are not collected then, because their queries cannot span secondary command buffers
+    /// without the inheritedQueries feature. The depth prepass comparison needs them, so it falls back to recording
+    /// on one thread
+    static constexpr bool MULTITHREADED_RECORDING{ true };
+    static constexpr std::size_t MAX_RECORDING_THREADS{ 8 };
+    /// \brief Draws below which another recording thread costs more than it saves
+    static constexpr std::size_t MIN_DRAWS_PER_RECORDING_THREAD{ 64 };
+    static constexpr std::array<std::size_t, 4> RECORDING_BENCHMARK_STEPS{ 1, 2, 4, 8 };
+    static constexpr std::uint32_t SPHERE_GRID_SIZE{ 6 };
+    static constexpr std::size_t MAX_ASSET_LOADER_THREADS{ 8 };
+    static constexpr float CAMERA_FOV{ 50.f };
+    static constexpr float CAMERA_NEAR_PLANE{ 0.1f };
+    static constexpr float CAMERA_FAR_PLANE{ 100.f };
+    static constexpr std::array<std::size_t, 5> LIGHT_STRESS_STEPS{ 16, 64, 256, 1024, 4096 };
+    static constexpr float STRESS_LIGHT_INTENSITY{ 0.2f };
+    static constexpr std::uint32_t STRESS_LIGHT_SEED{ 1337 };
     static constexpr auto MATERIAL_ALBEDO_PATH_METAL{
         PROJECT_ROOT "resources/textures/worn-shiny-metal-bl/worn-shiny-metal_albedo.png"
     };
@@ -90,6 +154,7 @@ private:
 
     std::shared_ptr<Window> m_window;
     std::shared_ptr<Device> m_device;
+    std::unique_ptr<ThreadPool> m_threadPool;
     std::unique_ptr<DescriptorPool> m_globalPool;
     std::unique_ptr<Renderer> m_renderer;
     std::vector<std::unique_ptr<Buffer>> m_uboBuffers;
@@ -98,9 +163,39 @@ private:
     std::unique_ptr<BasicRenderSystem> m_basicRenderSystem;
     std::unique_ptr<PointLightRenderSystem> m_pointLightRenderSystem;
     std::unique_ptr<PBRRenderSystem> m_pbrRenderSystem;
+    std::unique_ptr<DepthPyramid> m_depthPyramid;
+    std::unique_ptr<LightClusterer> m_lightClusterer;
+    std::unique_ptr<RenderGraph> m_renderGraph;
     std::unique_ptr<Scene> m_scene;
+    BenchmarkOptions m_benchmarks;
+
+    std::mt19937 m_stressLightRandom{ STRESS_LIGHT_SEED };
+    std::size_t m_lightStressStep{ 0 };
+    std::uint64_t m_pbrFragmentsWithPrepass{ 0 };
+    std::uint64_t m_pbrFragmentsWithoutPrepass{ 0 };
+
+    bool m_multithreadedRecording{ MULTITHREADED_RECORDING };
+    std::size_t m_recordingThreads{ 1 }; ///< Threads that record the main render pass, at most the pool's threads
+    std::size_t m_recordingBenchmarkStep{ 0 };
+    std::vector<VkCommandBuffer> m_secondaryCommandBuffers;
+    std::vector<VkCommandBuffer> m_rangeCommandBuffers;
+    std::chrono::duration<double, std::milli> m_recordingTime{ 0.0 }; ///< Summed up since the last stats log
+    std::size_t m_recordedFrames{ 0 };
 
     void initScene();
+    void addStressLights(std::size_t lightCount);
+    void declareRenderGraph(const FrameInfo& frameInfo);
+    void recordMainPass(const FrameInfo& frameInfo);
+    void recordMainPassInParallel(const FrameInfo& frameInfo);
+    void recordInParallel(
+        const FrameInfo& frameInfo,
+        std::string_view scope,
+        std::size_t drawCount,
+        const std::function<void(const FrameInfo&, std::size_t, std::size_t)>& record
+    );
+    void logFrameStats() const;
+    void compareDepthPrepass();
+    void logRecordingTime();
 };
 
 } // namespace vv
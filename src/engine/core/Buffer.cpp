@@ -54,6 +54,51 @@ Buffer Buffer::createStorageBuffer(std::shared_ptr<Device> device, VkDeviceSize
     return { std::move(device), elementSize, elementCount, usage, allocInfo };
 }
 
+Buffer Buffer::createHostStorageBuffer(
+    std::shared_ptr<Device> device, VkDeviceSize elementSize, std::uint32_t elementCount
+)
+{
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    return { std::move(device), elementSize, elementCount, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, allocInfo };
+}
+
+Buffer Buffer::createIndirectBuffer(
+    std::shared_ptr<Device> device, VkDeviceSize elementSize, std::uint32_t elementCount
+)
+{
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    return { std::move(device), elementSize, elementCount, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, allocInfo };
+}
+
+Buffer Buffer::createGpuIndirectBuffer(
+    std::shared_ptr<Device> device, VkDeviceSize elementSize, std::uint32_t elementCount
+)
+{
+    VkBufferUsageFlags usage{ VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
+                              | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT };
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+    return { std::move(device), elementSize, elementCount, usage, allocInfo };
+}
+
+Buffer Buffer::createReadbackBuffer(
+    std::shared_ptr<Device> device, VkDeviceSize elementSize, std::uint32_t elementCount
+)
+{
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    return { std::move(device), elementSize, elementCount, VK_BUFFER_USAGE_TRANSFER_DST_BIT, allocInfo };
+}
+
 Buffer Buffer::createStagingBuffer(std::shared_ptr<Device> device, VkDeviceSize elementSize, std::uint32_t elementCount)
 {
     VmaAllocationCreateInfo allocInfo{};
@@ -109,7 +154,13 @@ Buffer::Buffer(
 Buffer::~Buffer()
 {
     unmap();
-    vmaDestroyBuffer(device->allocator(), m_buffer, m_allocation);
+    if(m_buffer == VK_NULL_HANDLE)
+        return;
+
+    // NOTE: Pending uploads and frames that are still in flight may use the buffer
+    device->destroyLater([allocator = device->allocator(), buffer = m_buffer, allocation = m_allocation]() {
+        vmaDestroyBuffer(allocator, buffer, allocation);
+    });
 }
 
 Buffer::Buffer(Buffer&& other) noexcept
@@ -198,6 +249,22 @@ void Buffer::writeToBufferRaw(const void* pData, VkDeviceSize size, VkDeviceSize
     }
 }
 
+/// \brief Read data from the buffer
+///
+/// \param pData pointer to CPU memory that receives the data
+/// \param size how much data is read (in bytes)
+/// \param offset (optional) offset in to the buffer from where to start reading (in bytes)
+void Buffer::readFromBufferRaw(void* pData, VkDeviceSize size, VkDeviceSize offset) const
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(m_mapped != nullptr && "Cannot read from unmapped buffer");
+    assert(offset + size <= m_bufferSize && "The data that is being read exceeds the buffer's size");
+#endif
+
+    const auto* memOffset{ std::next(static_cast<const std::byte*>(m_mapped), static_cast<std::ptrdiff_t>(offset)) };
+    std::memcpy(pData, memOffset, size);
+}
+
 /// \brief Determine the minimum sice that a element needs to be stored in the buffer
 ///
 /// To fulfill alignment requirements the raw size of the element might not be suitable and therefore an extra
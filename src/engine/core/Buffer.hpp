@@ -92,6 +92,54 @@ public:
     static Buffer createStorageBuffer(
         std::shared_ptr<Device> device, VkDeviceSize elementSize, std::uint32_t elementCount
     );
+    /// \brief Create a storage buffer that is written to by the host every frame
+    ///
+    /// \note Writeable to from Host and automatically mapped on creation
+    ///
+    /// \param device the \ref Device where the buffer is created on
+    /// \param elementSize how big a single element of data is (in byte)
+    /// \param elementCount how many elements of data can fit in the buffer maximally
+    ///
+    /// \returns newly allocated \ref Buffer
+    static Buffer createHostStorageBuffer(
+        std::shared_ptr<Device> device, VkDeviceSize elementSize, std::uint32_t elementCount
+    );
+    /// \brief Create a buffer that holds indirect draw commands that are written by the host
+    ///
+    /// \note Writeable to from Host and automatically mapped on creation
+    ///
+    /// \param device the \ref Device where the buffer is created on
+    /// \param elementSize how big a single element of data is (in byte)
+    /// \param elementCount how many elements of data can fit in the buffer maximally
+    ///
+    /// \returns newly allocated \ref Buffer
+    static Buffer createIndirectBuffer(
+        std::shared_ptr<Device> device, VkDeviceSize elementSize, std::uint32_t elementCount
+    );
+    /// \brief Create a device local buffer that holds indirect draw commands or counts that are written by shaders
+    ///
+    /// \note Can be cleared with vkCmdFillBuffer and copied from
+    ///
+    /// \param device the \ref Device where the buffer is created on
+    /// \param elementSize how big a single element of data is (in byte)
+    /// \param elementCount how many elements of data can fit in the buffer maximally
+    ///
+    /// \returns newly allocated \ref Buffer
+    static Buffer createGpuIndirectBuffer(
+        std::shared_ptr<Device> device, VkDeviceSize elementSize, std::uint32_t elementCount
+    );
+    /// \brief Create a buffer that the GPU copies results into, so that they can be read by the host
+    ///
+    /// \note Readable from the Host and automatically mapped on creation
+    ///
+    /// \param device the \ref Device where the buffer is created on
+    /// \param elementSize how big a single element of data is (in byte)
+    /// \param elementCount how many elements of data can fit in the buffer maximally
+    ///
+    /// \returns newly allocated \ref Buffer
+    static Buffer createReadbackBuffer(
+        std::shared_ptr<Device> device, VkDeviceSize elementSize, std::uint32_t elementCount
+    );
     /// \brief Create a staging buffer
     ///
     /// \note Writeable to from Host and automatically mapped on creation
@@ -124,6 +172,8 @@ public:
 
     [[nodiscard]] VkBuffer getBuffer() const noexcept { return m_buffer; }
     [[nodiscard]] bool isCoherent() const noexcept { return m_isCoherent; }
+    /// \brief Size of the whole buffer, including the alignment of every element (in byte)
+    [[nodiscard]] VkDeviceSize getBufferSize() const noexcept { return m_bufferSize; }
 
     /// \brief Map the memory of the buffer so that it can be accessed by the CPU
     ///
@@ -155,6 +205,23 @@ public:
         writeToBufferRaw(data.data(), sizeof(T) * data.size(), offset);
     }
 
+    /// \brief Read data from the buffer
+    ///
+    /// \note Call \ref invalidate before reading from non-coherent memory
+    ///
+    /// \tparam T can be any single data type (struct, built-in, ...) as long as it is trivially copyable
+    /// \param offset (optional) offset into the buffer from where to begin reading memory (in byte)
+    ///
+    /// \returns the data that was read
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    [[nodiscard]] T readFromBuffer(VkDeviceSize offset = 0) const
+    {
+        T data{};
+        readFromBufferRaw(&data, sizeof(data), offset);
+        return data;
+    }
+
     /// \brief Flush a range of memory to make it available to the GPU.
     ///
     /// \note Only required for non-coherent memory
@@ -194,6 +261,7 @@ private:
     VmaAllocation m_allocation{ VK_NULL_HANDLE };
 
     void writeToBufferRaw(const void* pData, VkDeviceSize size, VkDeviceSize offset = 0) const;
+    void readFromBufferRaw(void* pData, VkDeviceSize size, VkDeviceSize offset = 0) const;
 
     static VkDeviceSize getAlignment(VkDeviceSize elementSize, VkDeviceSize minOffsetAlignment);
 };
@@ -0,0 +1,97 @@
+#include "CommandPoolRing.hpp"
+
+#include "core/Device.hpp"
+#include "utility/exceptions/Exception.hpp"
+#include "utility/exceptions/VulkanException.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace vv
+{
+
+CommandPoolRing::CommandPoolRing(std::shared_ptr<Device> device, std::size_t frameCount, std::size_t threadCount)
+    : device{ std::move(device) }, m_threadCount{ threadCount }, m_pools(frameCount * threadCount)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(frameCount > 0 && threadCount > 0 && "A command pool ring needs at least one frame and one thread");
+#endif
+
+    const QueueFamilyIndices indices{ this->device->findPhysicalQueueFamilies() };
+    if(!indices.graphicsFamily.has_value())
+        throw Exception("Failed to find graphics queue family");
+
+    VkCommandPoolCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    createInfo.queueFamilyIndex = indices.graphicsFamily.value();
+
+    for(auto& pool : m_pools)
+    {
+        const VkResult result{ vkCreateCommandPool(this->device->device(), &createInfo, nullptr, &pool.pool) };
+        if(result != VK_SUCCESS)
+            throw VulkanException("Failed to create command pool", result);
+    }
+}
+
+CommandPoolRing::~CommandPoolRing()
+{
+    for(const auto& pool : m_pools)
+        vkDestroyCommandPool(device->device(), pool.pool, nullptr);
+}
+
+void CommandPoolRing::reset(std::size_t frame)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(frame < getFrameCount() && "Frame index exceeds the amount of frames in flight");
+#endif
+
+    for(std::size_t thread{ 0 }; thread < m_threadCount; ++thread)
+    {
+        auto& pool{ m_pools[(frame * m_threadCount) + thread] };
+        if(pool.levels[0].used == 0 && pool.levels[1].used == 0)
+            continue;
+
+        const VkResult result{ vkResetCommandPool(device->device(), pool.pool, 0) };
+        if(result != VK_SUCCESS)
+            throw VulkanException("Failed to reset command pool", result);
+
+        for(auto& level : pool.levels)
+            level.used = 0;
+    }
+}
+
+VkCommandBuffer CommandPoolRing::allocate(std::size_t frame, std::size_t thread, VkCommandBufferLevel level)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(frame < getFrameCount() && "Frame index exceeds the amount of frames in flight");
+    assert(thread < m_threadCount && "Thread index exceeds the amount of recording threads");
+#endif
+
+    auto& pool{ m_pools[(frame * m_threadCount) + thread] };
+    auto& buffers{ pool.levels[level == VK_COMMAND_BUFFER_LEVEL_PRIMARY ? 0 : 1] };
+
+    if(buffers.used == buffers.commandBuffers.size())
+    {
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = pool.pool;
+        allocInfo.level = level;
+        allocInfo.commandBufferCount = 1;
+
+        VkCommandBuffer commandBuffer{ VK_NULL_HANDLE };
+        const VkResult result{ vkAllocateCommandBuffers(device->device(), &allocInfo, &commandBuffer) };
+        if(result != VK_SUCCESS)
+            throw VulkanException("Failed to allocate command buffer", result);
+
+        buffers.commandBuffers.push_back(commandBuffer);
+    }
+
+    return buffers.commandBuffers[buffers.used++];
+}
+
+} // namespace vv
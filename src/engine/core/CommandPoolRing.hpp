@@ -0,0 +1,85 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_CORE_COMMAND_POOL_RING_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_CORE_COMMAND_POOL_RING_HPP
+
+#include "core/Device.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace vv
+{
+
+/// \brief Command pools for every frame in flight and recording thread that are reset as a whole
+///
+/// Command buffers are handed out linearly: each request of a frame gets the next command buffer of its pool, and
+/// new command buffers are only allocated when a frame needs more than any frame before it. Once the GPU is done with
+/// a frame, all of its pools are reset with vkResetCommandPool, which recycles every command buffer at once. After
+/// the first frames, recording therefore neither allocates nor frees command buffers.
+///
+/// Every thread has its own pool, so threads never share a pool and never have to lock.
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+class CommandPoolRing
+{
+public:
+    /// \brief Create a new \ref CommandPoolRing
+    ///
+    /// \param device the \ref Device on which the pools are created, they use the graphics queue family
+    /// \param frameCount how many frames can be in flight
+    /// \param threadCount how many threads record at once
+    CommandPoolRing(std::shared_ptr<Device> device, std::size_t frameCount, std::size_t threadCount);
+    ~CommandPoolRing();
+
+    CommandPoolRing(const CommandPoolRing&) = delete;
+    CommandPoolRing(CommandPoolRing&&) = delete;
+    CommandPoolRing& operator=(const CommandPoolRing&) = delete;
+    CommandPoolRing& operator=(CommandPoolRing&&) = delete;
+
+    [[nodiscard]] std::size_t getFrameCount() const noexcept { return m_pools.size() / m_threadCount; }
+    [[nodiscard]] std::size_t getThreadCount() const noexcept { return m_threadCount; }
+
+    /// \brief Recycle every command buffer of a frame
+    ///
+    /// The previous submission of the frame has to be finished, i.e., its in flight fence has to be signaled
+    ///
+    /// \param frame index of the frame in flight
+    void reset(std::size_t frame);
+    /// \brief Get the next unused command buffer of a thread's pool in a frame
+    ///
+    /// Can be called from multiple threads at once as long as each of them uses its own thread index
+    ///
+    /// \param frame index of the frame in flight
+    /// \param thread index of the recording thread
+    /// \param level whether a primary or a secondary command buffer is needed
+    ///
+    /// \returns a command buffer in the initial state, valid until the frame is reset
+    [[nodiscard]] VkCommandBuffer allocate(std::size_t frame, std::size_t thread, VkCommandBufferLevel level);
+
+private:
+    /// \brief Command buffers of one level that are handed out front to back
+    struct LinearCommandBuffers
+    {
+        std::vector<VkCommandBuffer> commandBuffers;
+        std::size_t used{ 0 }; ///< Command buffers that were handed out since the last reset
+    };
+
+    /// \brief The pool of one thread in one frame, with one allocator per command buffer level
+    struct Pool
+    {
+        VkCommandPool pool{ VK_NULL_HANDLE };
+        std::array<LinearCommandBuffers, 2> levels{}; ///< Indexed by VkCommandBufferLevel
+    };
+
+    std::shared_ptr<Device> device;
+    std::size_t m_threadCount{ 1 };
+    std::vector<Pool> m_pools; ///< Indexed by frame * m_threadCount + thread
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_CORE_COMMAND_POOL_RING_HPP
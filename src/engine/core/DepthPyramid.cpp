@@ -0,0 +1,314 @@
+#include "DepthPyramid.hpp"
+
+#include "core/ComputePipeline.hpp"
+#include "core/DescriptorAllocator.hpp"
+#include "core/DescriptorSetLayout.hpp"
+#include "core/DescriptorWriter.hpp"
+#include "core/Device.hpp"
+#include "core/SamplerCache.hpp"
+#include "utility/exceptions/Exception.hpp"
+#include "utility/exceptions/VulkanException.hpp"
+
+#include "vk_mem_alloc.h"
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace vv
+{
+
+DepthPyramid::DepthPyramid(std::shared_ptr<Device> device)
+    : device{ std::move(device) }
+    , m_setLayout{ DescriptorSetLayout::Builder(this->device)
+                       .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT)
+                       .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_COMPUTE_BIT)
+                       .buildShared() }
+    , m_descriptorAllocator{ std::make_unique<DescriptorAllocator>(this->device, INITIAL_LEVEL_SETS, SET_RATIOS) }
+{
+    createPipeline();
+    createSampler();
+}
+
+DepthPyramid::~DepthPyramid()
+{
+    destroyImage();
+    m_pipeline.reset();
+    vkDestroyPipelineLayout(device->device(), m_pipelineLayout, nullptr);
+}
+
+void DepthPyramid::prepare(VkCommandBuffer commandBuffer, VkExtent2D depthExtent)
+{
+    m_depthExtent = depthExtent;
+
+    const VkExtent2D extent{ .width = std::max(std::bit_floor(depthExtent.width), 1u),
+                             .height = std::max(std::bit_floor(depthExtent.height), 1u) };
+    if(m_image != VK_NULL_HANDLE && extent.width == m_extent.width && extent.height == m_extent.height)
+        return;
+
+    // NOTE: The extent only changes together with the swapchain, which waits for the device to be idle before it is
+    // recreated. Therefore, the old image is not in use anymore
+    destroyImage();
+    createImage(extent);
+    writeLevelSets();
+
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = m_image;
+    barrier.subresourceRange = { .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                                 .baseMipLevel = 0,
+                                 .levelCount = m_mipLevels,
+                                 .baseArrayLayer = 0,
+                                 .layerCount = 1 };
+
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0,
+        0,
+        nullptr,
+        0,
+        nullptr,
+        1,
+        &barrier
+    );
+
+    m_valid = false;
+}
+
+void DepthPyramid::build(VkCommandBuffer commandBuffer, DescriptorAllocator& frameAllocator, VkImageView depthView)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(m_image != VK_NULL_HANDLE && "prepare() has to be called before the pyramid is built");
+#endif
+
+    // NOTE: The depth image changes with the swapchain image, so the first level reads it through a set that lives
+    // as long as the frame
+    VkDescriptorImageInfo depthInfo{ .sampler = m_sampler,
+                                     .imageView = depthView,
+                                     .imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL };
+    VkDescriptorImageInfo outputInfo{ .sampler = VK_NULL_HANDLE,
+                                      .imageView = m_mipViews.front(),
+                                      .imageLayout = VK_IMAGE_LAYOUT_GENERAL };
+    VkDescriptorSet frameSet{ VK_NULL_HANDLE };
+    if(!DescriptorWriter{ m_setLayout.get(), &frameAllocator }
+            .writeImage(0, &depthInfo)
+            .writeImage(1, &outputInfo)
+            .build(frameSet))
+        throw Exception("Failed to allocate depth pyramid descriptor set");
+
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    barrier.image = m_image;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    barrier.subresourceRange = getSubresourceRange();
+
+    m_pipeline->bind(commandBuffer);
+
+    VkExtent2D srcExtent{ m_depthExtent };
+    for(std::uint32_t level{ 0 }; level < m_mipLevels; ++level)
+    {
+        const VkExtent2D dstExtent{ .width = std::max(m_extent.width >> level, 1u),
+                                    .height = std::max(m_extent.height >> level, 1u) };
+        const VkDescriptorSet set{ level == 0 ? frameSet : m_levelSets[level] };
+
+        vkCmdBindDescriptorSets(
+            commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, 1, &set, 0, nullptr
+        );
+
+        const DownsamplePushConstants push{ .srcWidth = srcExtent.width,
+                                            .srcHeight = srcExtent.height,
+                                            .dstWidth = dstExtent.width,
+                                            .dstHeight = dstExtent.height };
+        vkCmdPushConstants(
+            commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(DownsamplePushConstants), &push
+        );
+
+        vkCmdDispatch(
+            commandBuffer,
+            (dstExtent.width + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE,
+            (dstExtent.height + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE,
+            1
+        );
+
+        srcExtent = dstExtent;
+        if(level + 1 == m_mipLevels)
+            break;
+
+        // NOTE: The next level reads this one. Later readers of the whole pyramid synchronize through the render graph
+        barrier.subresourceRange.baseMipLevel = level;
+        barrier.subresourceRange.levelCount = 1;
+        vkCmdPipelineBarrier(
+            commandBuffer,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0,
+            0,
+            nullptr,
+            0,
+            nullptr,
+            1,
+            &barrier
+        );
+    }
+
+    m_valid = true;
+}
+
+/// \brief Create the pipeline layout and the compute pipeline of the downsample shader
+void DepthPyramid::createPipeline()
+{
+    constexpr VkPushConstantRange pushConstantRange{ .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+                                                     .offset = 0,
+                                                     .size = sizeof(DownsamplePushConstants) };
+    const VkDescriptorSetLayout setLayout{ m_setLayout->getDescriptorLayout() };
+
+    VkPipelineLayoutCreateInfo layoutCI{};
+    layoutCI.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutCI.setLayoutCount = 1;
+    layoutCI.pSetLayouts = &setLayout;
+    layoutCI.pushConstantRangeCount = 1;
+    layoutCI.pPushConstantRanges = &pushConstantRange;
+
+    const VkResult result{ vkCreatePipelineLayout(device->device(), &layoutCI, nullptr, &m_pipelineLayout) };
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to create depth pyramid pipeline layout", result);
+
+    m_pipeline = std::make_unique<ComputePipeline>(device, DEPTH_PYRAMID_SHADER_PATH, m_pipelineLayout);
+}
+
+/// \brief Get the nearest sampler that is used to read the depth image and the pyramid levels
+void DepthPyramid::createSampler()
+{
+    VkSamplerCreateInfo samplerCI{};
+    samplerCI.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerCI.minFilter = VK_FILTER_NEAREST;
+    samplerCI.magFilter = VK_FILTER_NEAREST;
+    samplerCI.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerCI.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCI.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCI.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCI.anisotropyEnable = VK_FALSE;
+    samplerCI.maxAnisotropy = 1.f;
+    samplerCI.compareEnable = VK_FALSE;
+    samplerCI.unnormalizedCoordinates = VK_FALSE;
+    samplerCI.minLod = 0.f;
+    samplerCI.maxLod = VK_LOD_CLAMP_NONE;
+    samplerCI.mipLodBias = 0.f;
+
+    m_sampler = device->samplerCache().getSampler(samplerCI);
+}
+
+/// \brief Create the pyramid image with a view of all levels and one view per level
+///
+/// \param extent size of the first level
+void DepthPyramid::createImage(VkExtent2D extent)
+{
+    m_extent = extent;
+    m_mipLevels = static_cast<std::uint32_t>(std::bit_width(std::max(extent.width, extent.height)));
+
+    VkImageCreateInfo imageCI{};
+    imageCI.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageCI.imageType = VK_IMAGE_TYPE_2D;
+    imageCI.extent = { .width = extent.width, .height = extent.height, .depth = 1 };
+    imageCI.mipLevels = m_mipLevels;
+    imageCI.arrayLayers = 1;
+    imageCI.format = VK_FORMAT_R32_SFLOAT;
+    imageCI.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageCI.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageCI.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT;
+    imageCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageCI.samples = VK_SAMPLE_COUNT_1_BIT;
+
+    device->createImage(imageCI, m_image, m_allocation);
+
+    VkImageViewCreateInfo viewCI{};
+    viewCI.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewCI.image = m_image;
+    viewCI.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewCI.format = VK_FORMAT_R32_SFLOAT;
+    viewCI.subresourceRange = { .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                                .baseMipLevel = 0,
+                                .levelCount = m_mipLevels,
+                                .baseArrayLayer = 0,
+                                .layerCount = 1 };
+
+    VkResult result{ vkCreateImageView(device->device(), &viewCI, nullptr, &m_view) };
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to create depth pyramid image view", result);
+
+    m_mipViews.resize(m_mipLevels, VK_NULL_HANDLE);
+    for(std::uint32_t level{ 0 }; level < m_mipLevels; ++level)
+    {
+        viewCI.subresourceRange.baseMipLevel = level;
+        viewCI.subresourceRange.levelCount = 1;
+
+        result = vkCreateImageView(device->device(), &viewCI, nullptr, &m_mipViews[level]);
+        if(result != VK_SUCCESS)
+            throw VulkanException("Failed to create depth pyramid mip view", result);
+    }
+}
+
+/// \brief Destroy the pyramid image and its views
+void DepthPyramid::destroyImage()
+{
+    for(const VkImageView view : m_mipViews)
+        vkDestroyImageView(device->device(), view, nullptr);
+    m_mipViews.clear();
+
+    vkDestroyImageView(device->device(), m_view, nullptr);
+    m_view = VK_NULL_HANDLE;
+
+    if(m_image != VK_NULL_HANDLE)
+        vmaDestroyImage(device->allocator(), m_image, m_allocation);
+    m_image = VK_NULL_HANDLE;
+    m_allocation = VK_NULL_HANDLE;
+}
+
+/// \brief Point the descriptor sets of the levels after the first one to the views of the current image
+void DepthPyramid::writeLevelSets()
+{
+    if(m_levelSets.size() < m_mipLevels)
+        m_levelSets.resize(m_mipLevels, VK_NULL_HANDLE);
+
+    // NOTE: Level 0 reads the depth image and uses a set of the frame's descriptor allocator instead
+    for(std::uint32_t level{ 1 }; level < m_mipLevels; ++level)
+    {
+        VkDescriptorImageInfo inputInfo{ .sampler = m_sampler,
+                                         .imageView = m_mipViews[level - 1],
+                                         .imageLayout = VK_IMAGE_LAYOUT_GENERAL };
+        VkDescriptorImageInfo outputInfo{ .sampler = VK_NULL_HANDLE,
+                                          .imageView = m_mipViews[level],
+                                          .imageLayout = VK_IMAGE_LAYOUT_GENERAL };
+
+        DescriptorWriter writer{ m_setLayout.get(), m_descriptorAllocator.get() };
+        writer.writeImage(0, &inputInfo).writeImage(1, &outputInfo);
+
+        if(m_levelSets[level] == VK_NULL_HANDLE)
+        {
+            if(!writer.build(m_levelSets[level]))
+                throw Exception("Failed to allocate depth pyramid descriptor set");
+        }
+        else
+            writer.overwrite(m_levelSets[level]);
+    }
+}
+
+} // namespace vv
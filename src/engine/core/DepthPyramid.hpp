@@ -0,0 +1,133 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_CORE_DEPTH_PYRAMID_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_CORE_DEPTH_PYRAMID_HPP
+
+#include "core/ComputePipeline.hpp"
+#include "core/DescriptorAllocator.hpp"
+#include "core/DescriptorSetLayout.hpp"
+#include "core/Device.hpp"
+
+#include "vk_mem_alloc.h"
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace vv
+{
+
+/// \brief Hierarchical depth buffer (Hi-Z) built from the depth attachment of a frame
+///
+/// Every texel of a mip level stores the farthest depth of the texels it covers in the level below, so a single
+/// sample of a coarse level tells whether anything in that screen area is closer than a given depth. The first level
+/// has the size of the depth image rounded down to a power of two and covers the whole image conservatively.
+///
+/// The pyramid is kept in VK_IMAGE_LAYOUT_GENERAL and is read by the next frame, i.e., for occlusion culling.
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+class DepthPyramid
+{
+public:
+    static constexpr std::uint32_t WORKGROUP_SIZE{ 8 };
+
+    /// \brief Create a new \ref DepthPyramid. The image itself is created by the first call to \ref prepare
+    ///
+    /// \param device the \ref Device on which the pyramid is created
+    explicit DepthPyramid(std::shared_ptr<Device> device);
+    ~DepthPyramid();
+
+    DepthPyramid(const DepthPyramid&) = delete;
+    DepthPyramid(DepthPyramid&&) = delete;
+    DepthPyramid& operator=(const DepthPyramid&) = delete;
+    DepthPyramid& operator=(DepthPyramid&&) = delete;
+
+    /// \brief Whether the pyramid contains the depth of a previous frame
+    [[nodiscard]] bool isValid() const noexcept { return m_valid; }
+    [[nodiscard]] VkExtent2D getExtent() const noexcept { return m_extent; }
+    [[nodiscard]] std::uint32_t getMipLevels() const noexcept { return m_mipLevels; }
+    /// \brief Descriptor to sample every level of the pyramid with a nearest sampler
+    [[nodiscard]] VkDescriptorImageInfo descriptorInfo() const noexcept
+    {
+        return { .sampler = m_sampler, .imageView = m_view, .imageLayout = VK_IMAGE_LAYOUT_GENERAL };
+    }
+    [[nodiscard]] VkImage getImage() const noexcept { return m_image; }
+    /// \brief Every level of the pyramid
+    [[nodiscard]] VkImageSubresourceRange getSubresourceRange() const noexcept
+    {
+        return { .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                 .baseMipLevel = 0,
+                 .levelCount = m_mipLevels,
+                 .baseArrayLayer = 0,
+                 .layerCount = 1 };
+    }
+
+    /// \brief Make sure that the pyramid matches the size of the depth image
+    ///
+    /// Has to be recorded outside of a render pass, before the pyramid is used in the frame. If the size changed the
+    /// pyramid is recreated and invalid until it is built again.
+    ///
+    /// \param commandBuffer the command buffer of the current frame
+    /// \param depthExtent extent of the depth image the pyramid is built from
+    void prepare(VkCommandBuffer commandBuffer, VkExtent2D depthExtent);
+    /// \brief Build every level of the pyramid from a depth image
+    ///
+    /// Has to be recorded outside of a render pass. Only the levels are synchronized with each other, the depth
+    /// writes and earlier reads of the pyramid have to be waited for by the caller, e.g., through a \ref RenderGraph
+    ///
+    /// \param commandBuffer the command buffer of the current frame
+    /// \param frameAllocator the \ref DescriptorAllocator of the current frame, the set that reads the depth image is
+    /// allocated from it
+    /// \param depthView view of the depth aspect of the depth image in VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL
+    void build(VkCommandBuffer commandBuffer, DescriptorAllocator& frameAllocator, VkImageView depthView);
+
+private:
+    static constexpr auto DEPTH_PYRAMID_SHADER_PATH{ PROJECT_ROOT "resources/compiledShaders/depthPyramidComp.spv" };
+    /// \brief Sets of the first pool, enough for the levels of pyramids up to 16384x16384
+    static constexpr std::uint32_t INITIAL_LEVEL_SETS{ 14 };
+    /// \brief Every set reads one image and writes another
+    static constexpr std::array<PoolSizeRatio, 2> SET_RATIOS{
+        { { .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .ratio = 1.f },
+          { .type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, .ratio = 1.f } }
+    };
+
+    /// \brief Push constants of the downsample shader
+    struct DownsamplePushConstants
+    {
+        std::uint32_t srcWidth;
+        std::uint32_t srcHeight;
+        std::uint32_t dstWidth;
+        std::uint32_t dstHeight;
+    };
+
+    std::shared_ptr<Device> device;
+    std::shared_ptr<DescriptorSetLayout> m_setLayout;
+    std::unique_ptr<DescriptorAllocator> m_descriptorAllocator; ///< Grows with the levels of the pyramid
+    VkPipelineLayout m_pipelineLayout{ VK_NULL_HANDLE };
+    std::unique_ptr<ComputePipeline> m_pipeline;
+    VkSampler m_sampler{ VK_NULL_HANDLE }; ///< Owned by the \ref SamplerCache
+
+    VkImage m_image{ VK_NULL_HANDLE };
+    VmaAllocation m_allocation{ VK_NULL_HANDLE };
+    VkImageView m_view{ VK_NULL_HANDLE };
+    std::vector<VkImageView> m_mipViews;
+
+    std::vector<VkDescriptorSet> m_levelSets; ///< Reads level i - 1 and writes level i
+
+    VkExtent2D m_depthExtent{};
+    VkExtent2D m_extent{};
+    std::uint32_t m_mipLevels{ 0 };
+    bool m_valid{ false };
+
+    void createPipeline();
+    void createSampler();
+    void createImage(VkExtent2D extent);
+    void destroyImage();
+    void writeLevelSets();
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_CORE_DEPTH_PYRAMID_HPP
@@ -0,0 +1,130 @@
+#include "DescriptorAllocator.hpp"
+
+#include "core/Device.hpp"
+#include "utility/exceptions/VulkanException.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace vv
+{
+
+DescriptorAllocator::DescriptorAllocator(
+    std::shared_ptr<Device> device,
+    std::uint32_t initialSets,
+    std::span<const PoolSizeRatio> ratios,
+    VkDescriptorPoolCreateFlags createFlags
+)
+    : device{ std::move(device) }
+    , m_ratios(ratios.begin(), ratios.end())
+    , m_createFlags{ createFlags }
+    , m_setsPerPool{ std::clamp(initialSets, 1u, MAX_SETS_PER_POOL) }
+{}
+
+DescriptorAllocator::~DescriptorAllocator()
+{
+    for(VkDescriptorPool pool : m_readyPools)
+        vkDestroyDescriptorPool(device->device(), pool, nullptr);
+    for(VkDescriptorPool pool : m_fullPools)
+        vkDestroyDescriptorPool(device->device(), pool, nullptr);
+}
+
+VkDescriptorSet DescriptorAllocator::allocate(VkDescriptorSetLayout descriptorLayout, const void* pNext)
+{
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.pNext = pNext;
+    allocInfo.descriptorPool = getPool();
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &descriptorLayout;
+
+    VkDescriptorSet set{ VK_NULL_HANDLE };
+    VkResult result{ vkAllocateDescriptorSets(device->device(), &allocInfo, &set) };
+
+    // NOTE: A pool that is out of memory stays full until the next reset, so the set is allocated from a fresh pool
+    if(result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL)
+    {
+        m_fullPools.push_back(m_readyPools.back());
+        m_readyPools.pop_back();
+
+        allocInfo.descriptorPool = getPool();
+        result = vkAllocateDescriptorSets(device->device(), &allocInfo, &set);
+    }
+
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to allocate descriptor set", result);
+
+    return set;
+}
+
+void DescriptorAllocator::reset()
+{
+    for(VkDescriptorPool pool : m_readyPools)
+        vkResetDescriptorPool(device->device(), pool, 0);
+    for(VkDescriptorPool pool : m_fullPools)
+    {
+        vkResetDescriptorPool(device->device(), pool, 0);
+        m_readyPools.push_back(pool);
+    }
+
+    m_fullPools.clear();
+}
+
+/// \brief Get a pool that may still have space, create a new one if every pool is full
+///
+/// Every new pool holds more sets than the previous one, up to \ref MAX_SETS_PER_POOL
+///
+/// \returns the pool
+VkDescriptorPool DescriptorAllocator::getPool()
+{
+    if(m_readyPools.empty())
+    {
+        m_readyPools.push_back(createPool(m_setsPerPool));
+        m_setsPerPool = std::min(
+            static_cast<std::uint32_t>(std::ceil(static_cast<float>(m_setsPerPool) * GROWTH_FACTOR)), MAX_SETS_PER_POOL
+        );
+    }
+
+    return m_readyPools.back();
+}
+
+/// \brief Create a descriptor pool with the ratios of the allocator
+///
+/// \param setCount how many sets the pool holds
+///
+/// \returns the pool
+VkDescriptorPool DescriptorAllocator::createPool(std::uint32_t setCount) const
+{
+    std::vector<VkDescriptorPoolSize> poolSizes{};
+    poolSizes.reserve(m_ratios.size());
+    for(const PoolSizeRatio& ratio : m_ratios)
+    {
+        poolSizes.push_back(
+            { .type = ratio.type,
+              .descriptorCount = std::max(static_cast<std::uint32_t>(ratio.ratio * static_cast<float>(setCount)), 1u) }
+        );
+    }
+
+    VkDescriptorPoolCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    createInfo.flags = m_createFlags;
+    createInfo.maxSets = setCount;
+    createInfo.poolSizeCount = static_cast<std::uint32_t>(poolSizes.size());
+    createInfo.pPoolSizes = poolSizes.data();
+
+    VkDescriptorPool pool{ VK_NULL_HANDLE };
+    const VkResult result{ vkCreateDescriptorPool(device->device(), &createInfo, nullptr, &pool) };
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to create descriptor pool", result);
+
+    return pool;
+}
+
+} // namespace vv
@@ -0,0 +1,92 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_CORE_DESCRIPTOR_ALLOCATOR_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_CORE_DESCRIPTOR_ALLOCATOR_HPP
+
+#include "core/Device.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace vv
+{
+
+/// \brief How many descriptors of a type a pool of the \ref DescriptorAllocator holds per descriptor set
+struct PoolSizeRatio
+{
+    VkDescriptorType type;
+    float ratio;
+};
+
+/// \brief Allocates descriptor sets from a list of pools that grows with the demand
+///
+/// Starts with a small pool and creates another one, with more sets than the previous, whenever the current pool runs
+/// out of memory. So the number of descriptor sets is not limited and the pools do not have to be sized for the worst
+/// case up front. Full pools are kept until \ref reset, which recycles every pool at once. An allocator that holds
+/// the transient sets of one frame in flight is reset once the previous submission of that frame has finished.
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+class DescriptorAllocator
+{
+public:
+    /// \brief Upper limit of the sets per pool, later pools have the same size
+    static constexpr std::uint32_t MAX_SETS_PER_POOL{ 4096 };
+
+    /// \brief Create a new \ref DescriptorAllocator
+    ///
+    /// \param device the \ref Device where the pools are created on
+    /// \param initialSets how many sets the first pool holds
+    /// \param ratios how many descriptors of each type the pools hold per set
+    /// \param createFlags configuration flags of every pool
+    DescriptorAllocator(
+        std::shared_ptr<Device> device,
+        std::uint32_t initialSets,
+        std::span<const PoolSizeRatio> ratios,
+        VkDescriptorPoolCreateFlags createFlags = 0
+    );
+    ~DescriptorAllocator();
+
+    DescriptorAllocator(const DescriptorAllocator&) = delete;
+    DescriptorAllocator(DescriptorAllocator&&) = delete;
+    DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+    DescriptorAllocator& operator=(DescriptorAllocator&&) = delete;
+
+    /// \brief How many pools have been created so far
+    [[nodiscard]] std::size_t getPoolCount() const noexcept { return m_readyPools.size() + m_fullPools.size(); }
+    /// \brief How many sets the next pool that is created holds
+    [[nodiscard]] std::uint32_t getSetsPerPool() const noexcept { return m_setsPerPool; }
+
+    /// \brief Allocate a descriptor set, creating a new pool if every pool is full
+    ///
+    /// \param descriptorLayout the layout of the descriptor set
+    /// \param pNext (optional) extension of the allocate info, i.e., for variable descriptor counts
+    ///
+    /// \returns the descriptor set, throws a \ref VulkanException if it can not be allocated from a new pool either
+    [[nodiscard]] VkDescriptorSet allocate(VkDescriptorSetLayout descriptorLayout, const void* pNext = nullptr);
+    /// \brief Reset every pool, which frees all of the sets allocated from the allocator
+    ///
+    /// None of the sets may be in use by the GPU anymore
+    void reset();
+
+private:
+    static constexpr float GROWTH_FACTOR{ 1.5f };
+
+    std::shared_ptr<Device> device;
+    std::vector<PoolSizeRatio> m_ratios;
+    VkDescriptorPoolCreateFlags m_createFlags;
+    std::uint32_t m_setsPerPool;
+
+    std::vector<VkDescriptorPool> m_readyPools; ///< Pools that may still have space, the last one is used first
+    std::vector<VkDescriptorPool> m_fullPools;  ///< Pools that ran out of memory since the last reset
+
+    [[nodiscard]] VkDescriptorPool getPool();
+    [[nodiscard]] VkDescriptorPool createPool(std::uint32_t setCount) const;
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_CORE_DESCRIPTOR_ALLOCATOR_HPP
@@ -71,7 +71,7 @@ bool DescriptorPool::allocateDescriptor(VkDescriptorSetLayout descriptorLayout,
     allocInfo.descriptorSetCount = 1;
     allocInfo.pSetLayouts = &descriptorLayout;
 
-    // TODO: Implement a more robust system to handle the case that the pool is full. https://vkguide.dev/docs/new_chapter_4/descriptor_abstractions/
+    // NOTE: A full pool fails the allocation, sets whose number is not known up front use a DescriptorAllocator
     return vkAllocateDescriptorSets(m_device->device(), &allocInfo, &descriptor) == VK_SUCCESS;
 }
 
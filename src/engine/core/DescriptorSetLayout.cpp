@@ -34,29 +34,67 @@ DescriptorSetLayout::Builder& DescriptorSetLayout::Builder::addBinding(
     return *this;
 }
 
+DescriptorSetLayout::Builder& DescriptorSetLayout::Builder::setBindingFlags(
+    std::uint32_t binding, VkDescriptorBindingFlags bindingFlags
+)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(m_bindings.contains(binding) && "Binding flags can only be set for bindings that were added");
+#endif
+
+    m_bindingFlags[binding] = bindingFlags;
+
+    return *this;
+}
+
+DescriptorSetLayout::Builder& DescriptorSetLayout::Builder::setLayoutFlags(VkDescriptorSetLayoutCreateFlags layoutFlags)
+{
+    m_layoutFlags = layoutFlags;
+
+    return *this;
+}
+
 std::unique_ptr<DescriptorSetLayout> DescriptorSetLayout::Builder::build() const
 {
-    return std::make_unique<DescriptorSetLayout>(device, m_bindings);
+    return std::make_unique<DescriptorSetLayout>(device, m_bindings, m_bindingFlags, m_layoutFlags);
 }
 
 std::shared_ptr<DescriptorSetLayout> DescriptorSetLayout::Builder::buildShared() const
 {
-    return std::make_shared<DescriptorSetLayout>(device, m_bindings);
+    return std::make_shared<DescriptorSetLayout>(device, m_bindings, m_bindingFlags, m_layoutFlags);
 }
 
 DescriptorSetLayout::DescriptorSetLayout(
-    std::shared_ptr<Device> device, std::unordered_map<std::uint32_t, VkDescriptorSetLayoutBinding> bindings
+    std::shared_ptr<Device> device,
+    std::unordered_map<std::uint32_t, VkDescriptorSetLayoutBinding> bindings,
+    const std::unordered_map<std::uint32_t, VkDescriptorBindingFlags>& bindingFlags,
+    VkDescriptorSetLayoutCreateFlags layoutFlags
 )
     : m_device{ std::move(device) }, m_bindings{ bindings }
 {
     std::vector<VkDescriptorSetLayoutBinding> layoutBindings{};
-    for(auto [_, b] : m_bindings)
+    std::vector<VkDescriptorBindingFlags> layoutBindingFlags{};
+    for(auto [binding, b] : m_bindings)
+    {
         layoutBindings.push_back(b);
 
+        const auto flags{ bindingFlags.find(binding) };
+        layoutBindingFlags.push_back(flags != bindingFlags.end() ? flags->second : 0);
+    }
+
+    // NOTE: The flags are parallel to the bindings
+    VkDescriptorSetLayoutBindingFlagsCreateInfo flagsCreateInfo = {};
+    flagsCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    flagsCreateInfo.bindingCount = static_cast<std::uint32_t>(layoutBindingFlags.size());
+    flagsCreateInfo.pBindingFlags = layoutBindingFlags.data();
+
     VkDescriptorSetLayoutCreateInfo createInfo = {};
     createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
     createInfo.bindingCount = static_cast<std::uint32_t>(layoutBindings.size());
     createInfo.pBindings = layoutBindings.data();
+    createInfo.flags = layoutFlags;
+    if(!bindingFlags.empty())
+        createInfo.pNext = &flagsCreateInfo;
 
     const VkResult result{
         vkCreateDescriptorSetLayout(m_device->device(), &createInfo, nullptr, &m_descriptorSetLayout)
@@ -44,6 +44,15 @@ public:
             VkShaderStageFlags stageFlags,
             std::uint32_t count = 1
         );
+        /// \brief Set additional flags for a binding that was added before, i.e., for descriptor indexing
+        ///
+        /// \param binding the binding location
+        /// \param bindingFlags the VkDescriptorBindingFlags of the binding
+        Builder& setBindingFlags(std::uint32_t binding, VkDescriptorBindingFlags bindingFlags);
+        /// \brief Configure the flags that are used to create the descriptor set layout
+        ///
+        /// \param layoutFlags configuration flags
+        Builder& setLayoutFlags(VkDescriptorSetLayoutCreateFlags layoutFlags);
         /// \brief build the \ref DescriptorSetLayout
         ///
         /// \returns \ref DescriptorSetLayout wrapped in a unique_ptr
@@ -56,14 +65,21 @@ public:
     private:
         std::shared_ptr<Device> device;
         std::unordered_map<std::uint32_t, VkDescriptorSetLayoutBinding> m_bindings;
+        std::unordered_map<std::uint32_t, VkDescriptorBindingFlags> m_bindingFlags;
+        VkDescriptorSetLayoutCreateFlags m_layoutFlags{ 0 };
     };
 
     /// \brief Construct a new DescriptorSetLayout
     ///
     /// \param device \ref Device where the Descriptor set layout is created on
     /// \param bindings a map containing the layout bindings
+    /// \param bindingFlags (optional) a map containing the flags of bindings that need any
+    /// \param layoutFlags (optional) configuration flags for construction
     DescriptorSetLayout(
-        std::shared_ptr<Device> device, std::unordered_map<std::uint32_t, VkDescriptorSetLayoutBinding> bindings
+        std::shared_ptr<Device> device,
+        std::unordered_map<std::uint32_t, VkDescriptorSetLayoutBinding> bindings,
+        const std::unordered_map<std::uint32_t, VkDescriptorBindingFlags>& bindingFlags = {},
+        VkDescriptorSetLayoutCreateFlags layoutFlags = 0
     );
     ~DescriptorSetLayout();
 
@@ -1,5 +1,6 @@
 #include "DescriptorWriter.hpp"
 
+#include "core/DescriptorAllocator.hpp"
 #include "core/DescriptorPool.hpp"
 #include "core/DescriptorSetLayout.hpp"
 
@@ -15,6 +16,10 @@ DescriptorWriter::DescriptorWriter(DescriptorSetLayout* setLayout, DescriptorPoo
     : setLayout{ setLayout }, pool{ pool }
 {}
 
+DescriptorWriter::DescriptorWriter(DescriptorSetLayout* setLayout, DescriptorAllocator* allocator)
+    : setLayout{ setLayout }, allocator{ allocator }
+{}
+
 DescriptorWriter& DescriptorWriter::writeBuffer(std::uint32_t binding, VkDescriptorBufferInfo* bufferInfo)
 {
 #if defined(VV_ENABLE_ASSERTS)
@@ -63,11 +68,39 @@ DescriptorWriter& DescriptorWriter::writeImage(std::uint32_t binding, VkDescript
     return *this;
 }
 
-bool DescriptorWriter::build(VkDescriptorSet& set)
+DescriptorWriter& DescriptorWriter::writeImageArrayElement(
+    std::uint32_t binding, std::uint32_t arrayElement, VkDescriptorImageInfo* imageInfo
+)
 {
-    bool success{ pool->allocateDescriptor(setLayout->getDescriptorLayout(), set) };
+#if defined(VV_ENABLE_ASSERTS)
+    assert(setLayout->m_bindings.contains(binding) && "Layout does not contain specified binding");
+#endif
 
-    if(!success)
+    auto& bindingDescription{ setLayout->m_bindings[binding] };
+
+#if defined(VV_ENABLE_ASSERTS)
+    assert(arrayElement < bindingDescription.descriptorCount && "Array element exceeds the size of the binding");
+#endif
+
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.descriptorType = bindingDescription.descriptorType;
+    write.dstBinding = binding;
+    write.dstArrayElement = arrayElement;
+    write.pImageInfo = imageInfo;
+    write.descriptorCount = 1;
+
+    m_writes.push_back(write);
+
+    return *this;
+}
+
+bool DescriptorWriter::build(VkDescriptorSet& set)
+{
+    // NOTE: The allocator grows instead of running out of sets, so only a pool can fail here
+    if(allocator != nullptr)
+        set = allocator->allocate(setLayout->getDescriptorLayout());
+    else if(!pool->allocateDescriptor(setLayout->getDescriptorLayout(), set))
         return false;
 
     overwrite(set);
@@ -80,8 +113,9 @@ void DescriptorWriter::overwrite(VkDescriptorSet& set)
     for(auto& write : m_writes)
         write.dstSet = set;
 
+    // NOTE: The layout is known for both a pool and an allocator, so its device is used
     vkUpdateDescriptorSets(
-        pool->m_device->device(), static_cast<std::uint32_t>(m_writes.size()), m_writes.data(), 0, nullptr
+        setLayout->m_device->device(), static_cast<std::uint32_t>(m_writes.size()), m_writes.data(), 0, nullptr
     );
 }
 
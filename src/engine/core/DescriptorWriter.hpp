@@ -1,6 +1,7 @@
 #ifndef VULKAN_VOXELS_SRC_ENGINE_CORE_DESCRIPTOR_WRITER_HPP
 #define VULKAN_VOXELS_SRC_ENGINE_CORE_DESCRIPTOR_WRITER_HPP
 
+#include "core/DescriptorAllocator.hpp"
 #include "core/DescriptorPool.hpp"
 #include "core/DescriptorSetLayout.hpp"
 
@@ -27,6 +28,11 @@ public:
     /// \param setLayout a \ref DescriptorSetLayout describes the layout of the descriptor
     /// \param pool the \ref DescriptorPool where the descriptor sets are allocated on
     DescriptorWriter(DescriptorSetLayout* setLayout, DescriptorPool* pool);
+    /// \brief Construct a new \ref DescriptorWriter
+    ///
+    /// \param setLayout a \ref DescriptorSetLayout describes the layout of the descriptor
+    /// \param allocator the \ref DescriptorAllocator where the descriptor sets are allocated on
+    DescriptorWriter(DescriptorSetLayout* setLayout, DescriptorAllocator* allocator);
     ~DescriptorWriter() = default;
 
     DescriptorWriter(const DescriptorWriter&) = default;
@@ -44,6 +50,14 @@ public:
     /// \param binding the binding number where the buffer is accessible
     /// \param imageInfo the VkDescriptorImageInfo struct that contains the descriptors details
     DescriptorWriter& writeImage(std::uint32_t binding, VkDescriptorImageInfo* imageInfo);
+    /// \brief add a new image descriptor to a single element of an array binding
+    ///
+    /// \param binding the binding number of the array
+    /// \param arrayElement the index in the array where the image is accessible
+    /// \param imageInfo the VkDescriptorImageInfo struct that contains the descriptors details
+    DescriptorWriter& writeImageArrayElement(
+        std::uint32_t binding, std::uint32_t arrayElement, VkDescriptorImageInfo* imageInfo
+    );
 
     /// \brief build the descriptor set
     ///
@@ -58,7 +72,8 @@ public:
 
 private:
     DescriptorSetLayout* setLayout;
-    DescriptorPool* pool;
+    DescriptorPool* pool{ nullptr };
+    DescriptorAllocator* allocator{ nullptr };
     std::vector<VkWriteDescriptorSet> m_writes;
 };
 
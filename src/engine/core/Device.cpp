@@ -1,5 +1,7 @@
 #include "Device.hpp"
 
+#include "core/SamplerCache.hpp"
+#include "core/UploadManager.hpp"
 #include "core/Window.hpp"
 #include "utility/exceptions/Exception.hpp"
 #include "utility/exceptions/VulkanException.hpp"
@@ -11,10 +13,14 @@
 #include <vulkan/vk_platform.h>
 #include <vulkan/vulkan_core.h>
 
+#include <array>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <iterator>
 #include <memory>
+#include <optional>
 #include <set>
 #include <span>
 #include <stdexcept>
@@ -84,6 +90,83 @@ void DestroyDebugUtilsMessengerEXT(
         func(instance, debugMessenger, pAllocator);
 }
 
+/// \brief Check if a physical device supports timeline semaphores, which are core since Vulkan 1.2
+///
+/// \param phDevice the physical device to check
+///
+/// \returns true if timeline semaphores can be enabled
+bool supportsTimelineSemaphores(VkPhysicalDevice phDevice)
+{
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(phDevice, &properties);
+    if(properties.apiVersion < VK_API_VERSION_1_2)
+        return false;
+
+    VkPhysicalDeviceVulkan12Features features12{};
+    features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+    VkPhysicalDeviceFeatures2 features2{};
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features2.pNext = &features12;
+    vkGetPhysicalDeviceFeatures2(phDevice, &features2);
+
+    return features12.timelineSemaphore != VK_FALSE;
+}
+
+/// \brief Find a queue family for uploads that does not support graphics
+///
+/// A family that only supports transfers is preferred, it usually maps to a DMA engine that copies without taking
+/// time from the shader cores. Otherwise an async compute family is used, which supports transfers implicitly.
+///
+/// \param queueFamilies the queue families of the physical device
+///
+/// \returns index of the transfer family, std::nullopt if every family with transfer support also supports graphics
+std::optional<std::uint32_t> findTransferFamily(std::span<const VkQueueFamilyProperties> queueFamilies)
+{
+    std::optional<std::uint32_t> computeFamily{};
+    for(std::uint32_t i{ 0 }; const auto& queueFamily : queueFamilies)
+    {
+        const VkQueueFlags flags{ queueFamily.queueFlags };
+        if(queueFamily.queueCount > 0 && (flags & VK_QUEUE_GRAPHICS_BIT) == 0)
+        {
+            if((flags & VK_QUEUE_COMPUTE_BIT) == 0 && (flags & VK_QUEUE_TRANSFER_BIT) != 0)
+                return i;
+
+            if((flags & VK_QUEUE_COMPUTE_BIT) != 0 && !computeFamily.has_value())
+                computeFamily = i;
+        }
+
+        ++i;
+    }
+
+    return computeFamily;
+}
+
+/// \brief Create a timeline semaphore that starts at 0
+///
+/// \param device the logical device to create the semaphore on
+/// \param name what the semaphore is used for, for the error message
+///
+/// \returns the new semaphore
+VkSemaphore createTimelineSemaphore(VkDevice device, const char* name)
+{
+    VkSemaphoreTypeCreateInfo typeInfo{};
+    typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    createInfo.pNext = &typeInfo;
+
+    VkSemaphore semaphore{ VK_NULL_HANDLE };
+    const VkResult result{ vkCreateSemaphore(device, &createInfo, nullptr, &semaphore) };
+    if(result != VK_SUCCESS)
+        throw vv::VulkanException(std::string("Failed to create ") + name + " timeline semaphore", result);
+
+    return semaphore;
+}
+
 } // namespace
 
 namespace vv
@@ -97,7 +180,10 @@ Device::Device(std::shared_ptr<Window> window) : window{ std::move(window) }
     pickPhysicalDevice();
     createLogicalDevice();
     createAllocator();
+    createTimelineSemaphores();
     createCommandPool();
+    createUploadManager();
+    createSamplerCache();
 }
 
 Device::Device(bool headless) : window{ nullptr }, m_headless{ headless }
@@ -110,11 +196,21 @@ Device::Device(bool headless) : window{ nullptr }, m_headless{ headless }
     pickPhysicalDevice();
     createLogicalDevice();
     createAllocator();
+    createTimelineSemaphores();
     createCommandPool();
+    createUploadManager();
+    createSamplerCache();
 }
 
 Device::~Device()
 {
+    vkDeviceWaitIdle(m_device);
+    m_uploadManager.reset();
+    m_deletionQueue.flush();
+    m_samplerCache.reset();
+
+    vkDestroySemaphore(m_device, m_transferTimeline, nullptr);
+    vkDestroySemaphore(m_device, m_graphicsTimeline, nullptr);
     vkDestroyCommandPool(m_device, m_commandPool, nullptr);
     vmaDestroyAllocator(m_allocator);
     vkDestroyDevice(m_device, nullptr);
@@ -181,16 +277,103 @@ void Device::createBuffer(
         throw VulkanException("Failed to allocate buffer", result);
 }
 
-VkCommandBuffer Device::beginSingleTimeCommand() const
+std::uint64_t Device::completedGraphicsValue() const
+{
+    return queryTimelineValue(m_graphicsTimeline);
+}
+
+void Device::waitForGraphicsValue(std::uint64_t value) const
+{
+    waitForTimelineValue(m_graphicsTimeline, value);
+}
+
+std::uint64_t Device::submitGraphics(
+    VkCommandBuffer commandBuffer,
+    VkSemaphore waitSemaphore,
+    VkPipelineStageFlags waitStage,
+    VkSemaphore signalSemaphore,
+    std::uint64_t waitValue
+)
+{
+    return submit(
+        m_graphicsQueue,
+        m_graphicsTimeline,
+        m_graphicsTimelineValue,
+        commandBuffer,
+        waitSemaphore,
+        waitValue,
+        waitStage,
+        signalSemaphore
+    );
+}
+
+std::uint64_t Device::completedTransferValue() const
+{
+    return queryTimelineValue(transferTimeline());
+}
+
+void Device::waitForTransferValue(std::uint64_t value) const
 {
-    VkCommandBufferAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.commandPool = m_commandPool;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandBufferCount = 1;
+    waitForTimelineValue(transferTimeline(), value);
+}
 
-    VkCommandBuffer commandBuffer{};
-    vkAllocateCommandBuffers(m_device, &allocInfo, &commandBuffer);
+std::uint64_t Device::submitTransfer(VkCommandBuffer commandBuffer)
+{
+    if(!hasDedicatedTransferQueue())
+        return submitGraphics(commandBuffer);
+
+    return submit(
+        m_transferQueue,
+        m_transferTimeline,
+        m_transferTimelineValue,
+        commandBuffer,
+        VK_NULL_HANDLE,
+        0,
+        0,
+        VK_NULL_HANDLE
+    );
+}
+
+void Device::destroyLater(DeletionQueue::Deleter deleter)
+{
+    // NOTE: The upload batch is only submitted at the next flush, single time commands that are submitted meanwhile
+    // would let the deletion run while the batch still uses the resource
+    if(m_uploadManager != nullptr && m_uploadManager->hasPendingUploads())
+    {
+        m_uploadManager->destroyAfterBatch(std::move(deleter));
+        return;
+    }
+
+    // NOTE: The command buffer that is currently being recorded might still use the resource, so wait for it as well
+    m_deletionQueue.push(m_graphicsTimelineValue + 1, std::move(deleter));
+}
+
+void Device::collectDeletions()
+{
+    if(!m_deletionQueue.empty())
+        m_deletionQueue.collect(completedGraphicsValue());
+}
+
+VkCommandBuffer Device::beginSingleTimeCommand()
+{
+    if(m_usedSingleTimeCommandBuffers == m_singleTimeCommandBuffers.size())
+    {
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = m_commandPool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+
+        VkCommandBuffer allocated{};
+        const VkResult result{ vkAllocateCommandBuffers(m_device, &allocInfo, &allocated) };
+        if(result != VK_SUCCESS)
+            throw VulkanException("Failed to allocate single time command buffer", result);
+
+        m_singleTimeCommandBuffers.push_back(allocated);
+    }
+
+    VkCommandBuffer commandBuffer{ m_singleTimeCommandBuffers[m_usedSingleTimeCommandBuffers++] };
+    ++m_openSingleTimeCommands;
 
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -201,22 +384,25 @@ VkCommandBuffer Device::beginSingleTimeCommand() const
     return commandBuffer;
 }
 
-void Device::endSingleTimeCommand(VkCommandBuffer commandBuffer) const
+void Device::endSingleTimeCommand(VkCommandBuffer commandBuffer)
 {
-    vkEndCommandBuffer(commandBuffer);
+#if defined(VV_ENABLE_ASSERTS)
+    assert(m_openSingleTimeCommands > 0 && "No single time command is being recorded");
+#endif
 
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
+    vkEndCommandBuffer(commandBuffer);
 
-    vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(m_graphicsQueue);
+    waitForGraphicsValue(submitGraphics(commandBuffer));
 
-    vkFreeCommandBuffers(m_device, m_commandPool, 1, &commandBuffer);
+    // NOTE: Every submitted command has finished, but commands that are still being recorded must not be reset
+    if(--m_openSingleTimeCommands == 0)
+    {
+        vkResetCommandPool(m_device, m_commandPool, 0);
+        m_usedSingleTimeCommandBuffers = 0;
+    }
 }
 
-void Device::copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size) const
+void Device::copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size)
 {
     VkCommandBuffer commandBuffer{ beginSingleTimeCommand() };
 
@@ -229,7 +415,7 @@ void Device::copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize siz
 
 void Device::copyBufferToImage(
     VkBuffer buffer, VkImage image, std::uint32_t width, std::uint32_t height, std::uint32_t layerCount
-) const
+)
 {
     VkCommandBuffer commandBuffer{ beginSingleTimeCommand() };
 
@@ -388,7 +574,9 @@ void Device::createLogicalDevice()
         throw Exception("Failed to find queues");
 
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-    const std::set<std::uint32_t> uniqueQueueFamilies{ indices.graphicsFamily.value(), indices.presentFamily.value() };
+    std::set<std::uint32_t> uniqueQueueFamilies{ indices.graphicsFamily.value(), indices.presentFamily.value() };
+    if(indices.transferFamily.has_value())
+        uniqueQueueFamilies.insert(indices.transferFamily.value());
 
     constexpr float queuePriority{ 1.f };
     for(std::uint32_t queueFamily : uniqueQueueFamilies)
@@ -402,15 +590,51 @@ void Device::createLogicalDevice()
         queueCreateInfos.push_back(queueCreateInfo);
     }
 
-    VkPhysicalDeviceFeatures deviceFeatures{};
-    deviceFeatures.samplerAnisotropy = VK_TRUE;
+    VkPhysicalDeviceFeatures supportedFeatures{};
+    vkGetPhysicalDeviceFeatures(m_physicalDevice, &supportedFeatures);
+
+    m_enabledFeatures.samplerAnisotropy = VK_TRUE;
+    // NOTE: Optional, used by the GPU driven rendering path if available
+    m_enabledFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;
+    // NOTE: Optional, used to count shader invocations if available
+    m_enabledFeatures.pipelineStatisticsQuery = supportedFeatures.pipelineStatisticsQuery;
+
+    // NOTE: Vulkan 1.2 features, only queried if the physical device supports Vulkan 1.2
+    const bool supportsVulkan12{ properties.apiVersion >= VK_API_VERSION_1_2 };
+    if(supportsVulkan12)
+    {
+        VkPhysicalDeviceVulkan12Features supportedFeatures12{};
+        supportedFeatures12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+        VkPhysicalDeviceFeatures2 supportedFeatures2{};
+        supportedFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        supportedFeatures2.pNext = &supportedFeatures12;
+        vkGetPhysicalDeviceFeatures2(m_physicalDevice, &supportedFeatures2);
+
+        // NOTE: Required, every queue submission signals a timeline semaphore
+        m_enabledFeatures12.timelineSemaphore = VK_TRUE;
+        m_enabledFeatures12.drawIndirectCount = supportedFeatures12.drawIndirectCount;
+        // NOTE: Descriptor indexing, used for bindless material textures
+        m_enabledFeatures12.runtimeDescriptorArray = supportedFeatures12.runtimeDescriptorArray;
+        m_enabledFeatures12.descriptorBindingPartiallyBound = supportedFeatures12.descriptorBindingPartiallyBound;
+        m_enabledFeatures12.shaderSampledImageArrayNonUniformIndexing
+            = supportedFeatures12.shaderSampledImageArrayNonUniformIndexing;
+        m_enabledFeatures12.descriptorBindingSampledImageUpdateAfterBind
+            = supportedFeatures12.descriptorBindingSampledImageUpdateAfterBind;
+        m_enabledFeatures12.descriptorBindingStorageBufferUpdateAfterBind
+            = supportedFeatures12.descriptorBindingStorageBufferUpdateAfterBind;
+    }
+    m_enabledFeatures12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    m_enabledFeatures12.pNext = nullptr;
 
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
     createInfo.queueCreateInfoCount = static_cast<std::uint32_t>(queueCreateInfos.size());
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
     createInfo.enabledLayerCount = 0;
-    createInfo.pEnabledFeatures = &deviceFeatures;
+    createInfo.pEnabledFeatures = &m_enabledFeatures;
+    if(supportsVulkan12)
+        createInfo.pNext = &m_enabledFeatures12;
 
     // NOTE: Headless mode does not need swapchain extensions
     if(!m_headless)
@@ -436,6 +660,16 @@ void Device::createLogicalDevice()
         vkGetDeviceQueue(m_device, indices.presentFamily.value(), 0, &m_presentQueue);
     else
         m_presentQueue = m_graphicsQueue;
+
+    // NOTE: Without a family of its own, uploads are recorded and submitted like any other graphics work
+    if(indices.transferFamily.has_value())
+        vkGetDeviceQueue(m_device, indices.transferFamily.value(), 0, &m_transferQueue);
+    else
+        m_transferQueue = m_graphicsQueue;
+
+    spdlog::info(
+        "Uploads use {}", indices.transferFamily.has_value() ? "a dedicated transfer queue" : "the graphics queue"
+    );
 }
 
 void Device::createAllocator()
@@ -451,6 +685,14 @@ void Device::createAllocator()
         throw VulkanException("Failed to create allocator", result);
 }
 
+void Device::createTimelineSemaphores()
+{
+    m_graphicsTimeline = ::createTimelineSemaphore(m_device, "graphics");
+
+    if(m_transferQueue != m_graphicsQueue)
+        m_transferTimeline = ::createTimelineSemaphore(m_device, "transfer");
+}
+
 void Device::createCommandPool()
 {
     const QueueFamilyIndices indices{ findPhysicalQueueFamilies() };
@@ -460,7 +702,7 @@ void Device::createCommandPool()
 
     VkCommandPoolCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-    createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
     createInfo.queueFamilyIndex = indices.graphicsFamily.value();
 
     const VkResult result{ vkCreateCommandPool(m_device, &createInfo, nullptr, &m_commandPool) };
@@ -468,6 +710,16 @@ void Device::createCommandPool()
         throw VulkanException("Failed to create command pool", result);
 }
 
+void Device::createUploadManager()
+{
+    m_uploadManager = std::make_unique<UploadManager>(*this);
+}
+
+void Device::createSamplerCache()
+{
+    m_samplerCache = std::make_unique<SamplerCache>(*this);
+}
+
 bool Device::isDeviceSuitable(VkPhysicalDevice phDevice) const
 {
     QueueFamilyIndices indices{ findQueueFamilies(phDevice) };
@@ -491,7 +743,7 @@ bool Device::isDeviceSuitable(VkPhysicalDevice phDevice) const
     vkGetPhysicalDeviceFeatures(phDevice, &supportedFeatures);
 
     return indices.isComplete() && extensionsSupported && swapchainAdequate
-        && (supportedFeatures.samplerAnisotropy != VK_FALSE);
+        && (supportedFeatures.samplerAnisotropy != VK_FALSE) && ::supportsTimelineSemaphores(phDevice);
 }
 
 std::vector<const char*> Device::getRequiredExtensions()
@@ -575,6 +827,8 @@ QueueFamilyIndices Device::findQueueFamilies(VkPhysicalDevice phDevice) const
         ++i;
     }
 
+    indices.transferFamily = ::findTransferFamily(queueFamilies);
+
     return indices;
 }
 
@@ -657,4 +911,95 @@ SwapchainSupportDetails Device::querySwapchainSupport(VkPhysicalDevice phDevice)
     return details;
 }
 
+/// \brief Query the value a timeline semaphore has reached
+///
+/// \param timeline the timeline semaphore
+///
+/// \returns the current value of the timeline
+std::uint64_t Device::queryTimelineValue(VkSemaphore timeline) const
+{
+    std::uint64_t value{ 0 };
+    const VkResult result{ vkGetSemaphoreCounterValue(m_device, timeline, &value) };
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to query a timeline semaphore", result);
+
+    return value;
+}
+
+/// \brief Block until a timeline semaphore has reached a value
+///
+/// \param timeline the timeline semaphore
+/// \param value the value to wait for
+void Device::waitForTimelineValue(VkSemaphore timeline, std::uint64_t value) const
+{
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &timeline;
+    waitInfo.pValues = &value;
+
+    const VkResult result{ vkWaitSemaphores(m_device, &waitInfo, UINT64_MAX) };
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to wait for a timeline semaphore", result);
+}
+
+/// \brief Submit a command buffer to a queue and signal the next value of the queue's timeline
+///
+/// \param queue the queue to submit to
+/// \param timeline the timeline semaphore of the queue
+/// \param timelineValue the last value signaled on the timeline, advanced by the submission
+/// \param commandBuffer the command buffer to submit
+/// \param waitSemaphore optional binary or timeline semaphore the submission waits on
+/// \param waitValue the value to wait for, ignored for binary semaphores
+/// \param waitStage the stage that waits on the waitSemaphore
+/// \param signalSemaphore optional binary semaphore that is signaled alongside the timeline
+///
+/// \returns the timeline value that is signaled once the submission has finished
+std::uint64_t Device::submit(
+    VkQueue queue,
+    VkSemaphore timeline,
+    std::uint64_t& timelineValue,
+    VkCommandBuffer commandBuffer,
+    VkSemaphore waitSemaphore,
+    std::uint64_t waitValue,
+    VkPipelineStageFlags waitStage,
+    VkSemaphore signalSemaphore
+)
+{
+    const std::uint64_t signalValue{ timelineValue + 1 };
+
+    // NOTE: Binary semaphores ignore their value, the timeline is always signaled last
+    const std::uint64_t binaryValue{ 0 };
+    const std::array<VkSemaphore, 2> signalSemaphores{ signalSemaphore, timeline };
+    const std::array<std::uint64_t, 2> signalValues{ binaryValue, signalValue };
+    const std::uint32_t signalOffset{ signalSemaphore == VK_NULL_HANDLE ? 1U : 0U };
+    const bool waits{ waitSemaphore != VK_NULL_HANDLE };
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo{};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.waitSemaphoreValueCount = waits ? 1 : 0;
+    timelineInfo.pWaitSemaphoreValues = waits ? &waitValue : nullptr;
+    timelineInfo.signalSemaphoreValueCount = 2 - signalOffset;
+    timelineInfo.pSignalSemaphoreValues = std::next(signalValues.data(), signalOffset);
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext = &timelineInfo;
+    submitInfo.waitSemaphoreCount = waits ? 1 : 0;
+    submitInfo.pWaitSemaphores = waits ? &waitSemaphore : nullptr;
+    submitInfo.pWaitDstStageMask = waits ? &waitStage : nullptr;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+    submitInfo.signalSemaphoreCount = 2 - signalOffset;
+    submitInfo.pSignalSemaphores = std::next(signalSemaphores.data(), signalOffset);
+
+    const VkResult result{ vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE) };
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to submit to a queue", result);
+
+    timelineValue = signalValue;
+
+    return signalValue;
+}
+
 } // namespace vv
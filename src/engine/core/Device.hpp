@@ -2,10 +2,12 @@
 #define VULKAN_VOXELS_SRC_ENGINE_CORE_DEVICE_HPP
 
 #include "Window.hpp"
+#include "utility/DeletionQueue.hpp"
 
 #include "vk_mem_alloc.h"
 #include <vulkan/vulkan_core.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -14,6 +16,9 @@
 namespace vv
 {
 
+class SamplerCache;
+class UploadManager;
+
 /// \brief Save information of what the swapchain is supporting
 ///
 /// \author Felix Hommel
@@ -27,12 +32,15 @@ struct SwapchainSupportDetails
 
 /// \brief Save the indices of the used queues
 ///
+/// The transfer family is optional and never supports graphics. Without one, uploads share the graphics queue
+///
 /// \author Felix Hommel
 /// \date 11/10/2025
 struct QueueFamilyIndices
 {
     std::optional<std::uint32_t> graphicsFamily;
     std::optional<std::uint32_t> presentFamily;
+    std::optional<std::uint32_t> transferFamily;
 
     [[nodiscard]] constexpr bool isComplete() const noexcept
     {
@@ -71,6 +79,32 @@ public:
     [[nodiscard]] VkSurfaceKHR surface() const noexcept { return m_surface; }
     [[nodiscard]] VkQueue graphicsQueue() const noexcept { return m_graphicsQueue; }
     [[nodiscard]] VkQueue presentQueue() const noexcept { return m_presentQueue; }
+    /// \brief Queue that uploads are submitted to, the graphics queue if there is no dedicated transfer queue
+    [[nodiscard]] VkQueue transferQueue() const noexcept { return m_transferQueue; }
+    /// \brief Whether uploads run on a queue family of their own and need queue family ownership transfers
+    [[nodiscard]] bool hasDedicatedTransferQueue() const noexcept { return m_transferTimeline != VK_NULL_HANDLE; }
+    /// \brief Timeline semaphore that is signaled by every submission to the graphics queue
+    [[nodiscard]] VkSemaphore graphicsTimeline() const noexcept { return m_graphicsTimeline; }
+    /// \brief Timeline value the last submission to the graphics queue is going to signal
+    [[nodiscard]] std::uint64_t submittedGraphicsValue() const noexcept { return m_graphicsTimelineValue; }
+    /// \brief Timeline semaphore that is signaled by every transfer submission
+    ///
+    /// \note This is the graphics timeline if there is no dedicated transfer queue
+    [[nodiscard]] VkSemaphore transferTimeline() const noexcept
+    {
+        return hasDedicatedTransferQueue() ? m_transferTimeline : m_graphicsTimeline;
+    }
+    /// \brief Batches uploads to device local memory, submitted once per frame by the \ref Renderer
+    [[nodiscard]] UploadManager& uploadManager() const noexcept { return *m_uploadManager; }
+    /// \brief Samplers shared by every texture with the same sampler state
+    [[nodiscard]] SamplerCache& samplerCache() const noexcept { return *m_samplerCache; }
+    /// \brief Core features enabled on the logical device. Optional features are only enabled if supported
+    [[nodiscard]] const VkPhysicalDeviceFeatures& enabledFeatures() const noexcept { return m_enabledFeatures; }
+    /// \brief Vulkan 1.2 features enabled on the logical device. All except timeline semaphores are optional
+    [[nodiscard]] const VkPhysicalDeviceVulkan12Features& enabledVulkan12Features() const noexcept
+    {
+        return m_enabledFeatures12;
+    }
 
     /// \brief Query the physical device for its swapchain support
     ///
@@ -88,6 +122,9 @@ public:
     [[nodiscard]] std::uint32_t findMemoryType(std::uint32_t filter, VkMemoryPropertyFlags properties) const;
     /// \brief Find appropriate queues on the physical device
     ///
+    /// Graphics and present use the first families that support them. For uploads a family without graphics support
+    /// is preferred, first one that only supports transfers (usually a DMA engine), then an async compute family
+    ///
     /// \return \ref QueueFamilyIndices the chosen queues
     [[nodiscard]] QueueFamilyIndices findPhysicalQueueFamilies() const { return findQueueFamilies(m_physicalDevice); }
     /// \brief Determine the best fitting format from a selection
@@ -117,20 +154,72 @@ public:
         VkBuffer& buffer,
         VmaAllocation& allocation
     ) const;
+    /// \brief Query the timeline value the graphics queue has reached
+    ///
+    /// \returns every submission with a value less or equal has finished
+    [[nodiscard]] std::uint64_t completedGraphicsValue() const;
+    /// \brief Block until the graphics queue has reached a timeline value
+    ///
+    /// \param value the value to wait for
+    void waitForGraphicsValue(std::uint64_t value) const;
+    /// \brief Submit a command buffer to the graphics queue and signal the next graphics timeline value
+    ///
+    /// \param commandBuffer the command buffer to submit
+    /// \param waitSemaphore optional binary semaphore the submission waits on
+    /// \param waitStage the stage that waits on the waitSemaphore
+    /// \param signalSemaphore optional binary semaphore that is signaled alongside the timeline
+    /// \param waitValue the value to wait for if the waitSemaphore is a timeline semaphore
+    ///
+    /// \returns the timeline value that is signaled once the submission has finished
+    std::uint64_t submitGraphics(
+        VkCommandBuffer commandBuffer,
+        VkSemaphore waitSemaphore = VK_NULL_HANDLE,
+        VkPipelineStageFlags waitStage = 0,
+        VkSemaphore signalSemaphore = VK_NULL_HANDLE,
+        std::uint64_t waitValue = 0
+    );
+    /// \brief Query the timeline value the transfer queue has reached
+    ///
+    /// \returns every transfer submission with a value less or equal has finished
+    [[nodiscard]] std::uint64_t completedTransferValue() const;
+    /// \brief Block until the transfer queue has reached a timeline value
+    ///
+    /// \param value the value to wait for
+    void waitForTransferValue(std::uint64_t value) const;
+    /// \brief Submit a command buffer to the transfer queue and signal the next transfer timeline value
+    ///
+    /// Falls back to \ref submitGraphics if there is no dedicated transfer queue
+    ///
+    /// \param commandBuffer the command buffer to submit, allocated from a pool of the transfer family
+    ///
+    /// \returns the transfer timeline value that is signaled once the submission has finished
+    std::uint64_t submitTransfer(VkCommandBuffer commandBuffer);
+    /// \brief Destroy something once the graphics submissions made so far and the next one have finished
+    ///
+    /// While an upload batch is being recorded, the deletion waits for that batch to be submitted and finished too
+    ///
+    /// \param deleter destroys the resource
+    void destroyLater(DeletionQueue::Deleter deleter);
+    /// \brief Run the deletions whose submissions have finished
+    void collectDeletions();
     /// \brief Start recording a command
     ///
+    /// The command buffers are taken front to back from a list that is only allocated once. The command pool is
+    /// reset as a whole when the last open command has finished, instead of freeing every command buffer on its own.
+    /// Not thread safe
+    ///
     /// \return \ref VkCommandBuffer handle to the command buffer that is being recorded to
-    [[nodiscard]] VkCommandBuffer beginSingleTimeCommand() const;
-    /// \brief End recording a command
+    [[nodiscard]] VkCommandBuffer beginSingleTimeCommand();
+    /// \brief End recording a command, submit it and wait until it has finished
     ///
     /// \param commandBuffer \ref VkCommandBuffer which command buffer should stop recording
-    void endSingleTimeCommand(VkCommandBuffer commandBuffer) const;
+    void endSingleTimeCommand(VkCommandBuffer commandBuffer);
     /// \brief Copy data from one buffer to another
     ///
     /// \param srcBuffer buffer to copy from
     /// \param dstBuffer buffer to copy to
     /// \param size how big the copied data is
-    void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size) const;
+    void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
     /// \brief Copy buffer data to an image
     ///
     /// \param buffer the buffer to copy from
@@ -140,7 +229,7 @@ public:
     /// \param layerCount how many layers the image has
     void copyBufferToImage(
         VkBuffer buffer, VkImage image, std::uint32_t width, std::uint32_t height, std::uint32_t layerCount
-    ) const;
+    );
 
     /// \brief Create a new Image
     ///
@@ -176,11 +265,24 @@ private:
     VkDebugUtilsMessengerEXT m_debugMessenger{ VK_NULL_HANDLE };
     VkPhysicalDevice m_physicalDevice{ VK_NULL_HANDLE };
     VkCommandPool m_commandPool{ VK_NULL_HANDLE };
+    std::vector<VkCommandBuffer> m_singleTimeCommandBuffers;
+    std::size_t m_usedSingleTimeCommandBuffers{ 0 }; ///< Handed out since the command pool was reset
+    std::size_t m_openSingleTimeCommands{ 0 };
     VkDevice m_device{ VK_NULL_HANDLE };
     VkSurfaceKHR m_surface{ VK_NULL_HANDLE };
     VmaAllocator m_allocator{ VK_NULL_HANDLE };
     VkQueue m_graphicsQueue{ VK_NULL_HANDLE };
     VkQueue m_presentQueue{ VK_NULL_HANDLE };
+    VkQueue m_transferQueue{ VK_NULL_HANDLE };
+    VkSemaphore m_graphicsTimeline{ VK_NULL_HANDLE };
+    std::uint64_t m_graphicsTimelineValue{ 0 }; ///< Value signaled by the last graphics submission
+    VkSemaphore m_transferTimeline{ VK_NULL_HANDLE }; ///< Only created with a dedicated transfer queue
+    std::uint64_t m_transferTimelineValue{ 0 }; ///< Value signaled by the last transfer submission
+    DeletionQueue m_deletionQueue;
+    std::unique_ptr<UploadManager> m_uploadManager;
+    std::unique_ptr<SamplerCache> m_samplerCache;
+    VkPhysicalDeviceFeatures m_enabledFeatures{};
+    VkPhysicalDeviceVulkan12Features m_enabledFeatures12{};
 
     std::shared_ptr<Window> window;
     bool m_headless{ false };
@@ -191,12 +293,27 @@ private:
     void pickPhysicalDevice();
     void createLogicalDevice();
     void createAllocator();
+    void createTimelineSemaphores();
     void createCommandPool();
+    void createUploadManager();
+    void createSamplerCache();
 
     bool isDeviceSuitable(VkPhysicalDevice phDevice) const;
     static std::vector<const char*> getRequiredExtensions();
     [[nodiscard]] bool checkValidationLayerSupport() const;
     QueueFamilyIndices findQueueFamilies(VkPhysicalDevice phDevice) const;
+    [[nodiscard]] std::uint64_t queryTimelineValue(VkSemaphore timeline) const;
+    void waitForTimelineValue(VkSemaphore timeline, std::uint64_t value) const;
+    std::uint64_t submit(
+        VkQueue queue,
+        VkSemaphore timeline,
+        std::uint64_t& timelineValue,
+        VkCommandBuffer commandBuffer,
+        VkSemaphore waitSemaphore,
+        std::uint64_t waitValue,
+        VkPipelineStageFlags waitStage,
+        VkSemaphore signalSemaphore
+    );
     static void populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo);
     static void hasGlfwRequiredInstanceExtensions();
     bool checkDeviceExtensionSupport(VkPhysicalDevice phDevice) const;
@@ -0,0 +1,276 @@
+#include "GpuCuller.hpp"
+
+#include "core/Buffer.hpp"
+#include "core/ComputePipeline.hpp"
+#include "core/DepthPyramid.hpp"
+#include "core/DescriptorPool.hpp"
+#include "core/DescriptorSetLayout.hpp"
+#include "core/DescriptorWriter.hpp"
+#include "core/Device.hpp"
+#include "utility/exceptions/Exception.hpp"
+#include "utility/exceptions/VulkanException.hpp"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include "glm/glm.hpp"
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+
+namespace vv
+{
+
+GpuCuller::GpuCuller(std::shared_ptr<Device> device, std::uint32_t framesInFlight)
+    : device{ std::move(device) }
+    , m_setLayout{ DescriptorSetLayout::Builder(this->device)
+                       .addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                       .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                       .addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                       .addBinding(3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                       .addBinding(4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                       .addBinding(5, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT)
+                       .buildShared() }
+    , m_pool{ DescriptorPool::Builder(this->device)
+                  .setMaxSets(framesInFlight)
+                  .addPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight)
+                  .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4 * framesInFlight)
+                  .addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, framesInFlight)
+                  .build() }
+    , m_frames(framesInFlight)
+{
+    createPipeline();
+
+    for(auto& frame : m_frames)
+    {
+        frame.uniformBuffer = std::make_unique<Buffer>(
+            Buffer::createUniformBuffer(this->device, sizeof(CullUniforms), 1)
+        );
+        frame.readbackBuffer = std::make_unique<Buffer>(
+            Buffer::createReadbackBuffer(this->device, sizeof(GpuCullStats), 1)
+        );
+
+        if(!m_pool->allocateDescriptor(m_setLayout->getDescriptorLayout(), frame.descriptorSet))
+            throw Exception("Failed to allocate GPU culling descriptor set");
+    }
+}
+
+GpuCuller::~GpuCuller()
+{
+    m_pipeline.reset();
+    vkDestroyPipelineLayout(device->device(), m_pipelineLayout, nullptr);
+}
+
+bool GpuCuller::isSupported(const Device& device) noexcept
+{
+    return device.enabledFeatures().drawIndirectFirstInstance == VK_TRUE
+           && device.enabledVulkan12Features().drawIndirectCount == VK_TRUE;
+}
+
+void GpuCuller::update(
+    std::size_t frameIndex,
+    std::span<const GpuCullObject> objects,
+    std::span<const GpuCullBatch> batches,
+    const glm::mat4& viewProjection
+)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(frameIndex < m_frames.size() && "Frame index exceeds the amount of frames in flight");
+#endif
+
+    auto& frame{ m_frames[frameIndex] };
+
+    // NOTE: The previous submission of this frame has finished, so its statistics can be read without waiting
+    if(frame.hasResults)
+    {
+        if(!frame.readbackBuffer->isCoherent())
+            static_cast<void>(frame.readbackBuffer->invalidate());
+        m_stats = frame.readbackBuffer->readFromBuffer<GpuCullStats>();
+    }
+
+    frame.objectCount = static_cast<std::uint32_t>(objects.size());
+    frame.batchCount = static_cast<std::uint32_t>(batches.size());
+    reserveFrameResources(frame, frame.objectCount, frame.batchCount);
+
+    m_frustum.setFrustum(viewProjection);
+    CullUniforms uniforms{ .occlusionViewProjection = m_previousViewProjection,
+                           .frustumPlanes = m_frustum.getPlanes(),
+                           .objectCount = frame.objectCount };
+    frame.uniformBuffer->writeToBuffer(uniforms);
+    frame.uniformBuffer->flush();
+
+    // NOTE: The depth pyramid that is tested against in the next frame is built from this frame's depth
+    m_previousViewProjection = viewProjection;
+
+    if(objects.empty())
+        return;
+
+    frame.objectBuffer->writeToBuffer(objects);
+    frame.objectBuffer->flush();
+    frame.batchBuffer->writeToBuffer(batches);
+    frame.batchBuffer->flush();
+}
+
+void GpuCuller::cull(VkCommandBuffer commandBuffer, std::size_t frameIndex, const DepthPyramid& depthPyramid)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(frameIndex < m_frames.size() && "Frame index exceeds the amount of frames in flight");
+#endif
+
+    auto& frame{ m_frames[frameIndex] };
+    if(frame.objectCount == 0)
+        return;
+
+    // NOTE: The pyramid image is recreated together with the swapchain, so its view is written every frame
+    auto uniformInfo{ frame.uniformBuffer->descriptorInfo() };
+    auto objectInfo{ frame.objectBuffer->descriptorInfo() };
+    auto batchInfo{ frame.batchBuffer->descriptorInfo() };
+    auto commandInfo{ frame.commandBuffer->descriptorInfo() };
+    auto countInfo{ frame.countBuffer->descriptorInfo() };
+    auto pyramidInfo{ depthPyramid.descriptorInfo() };
+    DescriptorWriter{ m_setLayout.get(), m_pool.get() }
+        .writeBuffer(0, &uniformInfo)
+        .writeBuffer(1, &objectInfo)
+        .writeBuffer(2, &batchInfo)
+        .writeBuffer(3, &commandInfo)
+        .writeBuffer(4, &countInfo)
+        .writeImage(5, &pyramidInfo)
+        .overwrite(frame.descriptorSet);
+
+    vkCmdFillBuffer(commandBuffer, frame.countBuffer->getBuffer(), 0, countOffset(frame.batchCount), 0);
+
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0,
+        1,
+        &barrier,
+        0,
+        nullptr,
+        0,
+        nullptr
+    );
+
+    m_pipeline->bind(commandBuffer);
+    vkCmdBindDescriptorSets(
+        commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, 1, &frame.descriptorSet, 0, nullptr
+    );
+
+    const VkExtent2D pyramidExtent{ depthPyramid.getExtent() };
+    const CullPushConstants push{
+        .pyramidSize = { static_cast<float>(pyramidExtent.width), static_cast<float>(pyramidExtent.height) },
+        .pyramidLevels = depthPyramid.getMipLevels(),
+        .occlusionEnabled = depthPyramid.isValid() ? 1u : 0u
+    };
+    vkCmdPushConstants(
+        commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants), &push
+    );
+
+    vkCmdDispatch(commandBuffer, (frame.objectCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+
+    // NOTE: Only the statistics copy below waits here, the draws synchronize with the pass through the render graph
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0,
+        1,
+        &barrier,
+        0,
+        nullptr,
+        0,
+        nullptr
+    );
+
+    const VkBufferCopy statsRegion{ .srcOffset = 0, .dstOffset = 0, .size = sizeof(GpuCullStats) };
+    vkCmdCopyBuffer(
+        commandBuffer, frame.countBuffer->getBuffer(), frame.readbackBuffer->getBuffer(), 1, &statsRegion
+    );
+
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_HOST_BIT,
+        0,
+        1,
+        &barrier,
+        0,
+        nullptr,
+        0,
+        nullptr
+    );
+
+    frame.hasResults = true;
+}
+
+/// \brief Create the pipeline layout and the compute pipeline of the cull shader
+void GpuCuller::createPipeline()
+{
+    constexpr VkPushConstantRange pushConstantRange{ .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+                                                     .offset = 0,
+                                                     .size = sizeof(CullPushConstants) };
+    const VkDescriptorSetLayout setLayout{ m_setLayout->getDescriptorLayout() };
+
+    VkPipelineLayoutCreateInfo layoutCI{};
+    layoutCI.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutCI.setLayoutCount = 1;
+    layoutCI.pSetLayouts = &setLayout;
+    layoutCI.pushConstantRangeCount = 1;
+    layoutCI.pPushConstantRanges = &pushConstantRange;
+
+    const VkResult result{ vkCreatePipelineLayout(device->device(), &layoutCI, nullptr, &m_pipelineLayout) };
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to create GPU culling pipeline layout", result);
+
+    m_pipeline = std::make_unique<ComputePipeline>(device, GPU_CULL_SHADER_PATH, m_pipelineLayout);
+}
+
+/// \brief Make sure that the buffers of a frame are big enough, recreate them with more capacity if not
+///
+/// The frame's previous submission has already finished when this is called, so its buffers can be replaced
+///
+/// \param frame the resources of the frame that is being recorded
+/// \param objectCount how many objects are culled
+/// \param batchCount how many batches the objects belong to
+void GpuCuller::reserveFrameResources(FrameResources& frame, std::uint32_t objectCount, std::uint32_t batchCount)
+{
+    if(objectCount > frame.objectCapacity || frame.objectBuffer == nullptr)
+    {
+        frame.objectCapacity = std::max(std::bit_ceil(objectCount), MIN_BUFFER_CAPACITY);
+        frame.objectBuffer = std::make_unique<Buffer>(
+            Buffer::createHostStorageBuffer(device, sizeof(GpuCullObject), frame.objectCapacity)
+        );
+        // NOTE: Every object has a slot for its command in its batch
+        frame.commandBuffer = std::make_unique<Buffer>(
+            Buffer::createGpuIndirectBuffer(device, COMMAND_STRIDE, frame.objectCapacity)
+        );
+    }
+
+    if(batchCount > frame.batchCapacity || frame.batchBuffer == nullptr)
+    {
+        frame.batchCapacity = std::max(std::bit_ceil(batchCount), MIN_BUFFER_CAPACITY);
+        frame.batchBuffer = std::make_unique<Buffer>(
+            Buffer::createHostStorageBuffer(device, sizeof(GpuCullBatch), frame.batchCapacity)
+        );
+        frame.countBuffer = std::make_unique<Buffer>(
+            Buffer::createGpuIndirectBuffer(device, 1, static_cast<std::uint32_t>(countOffset(frame.batchCapacity)))
+        );
+    }
+}
+
+} // namespace vv
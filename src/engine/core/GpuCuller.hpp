@@ -0,0 +1,193 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_CORE_GPU_CULLER_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_CORE_GPU_CULLER_HPP
+
+#include "core/Buffer.hpp"
+#include "core/ComputePipeline.hpp"
+#include "core/DepthPyramid.hpp"
+#include "core/DescriptorPool.hpp"
+#include "core/DescriptorSetLayout.hpp"
+#include "core/Device.hpp"
+#include "utility/FrustumCuller.hpp"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include "glm/glm.hpp"
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace vv
+{
+
+/// \brief An object that is tested by the \ref GpuCuller, matches the layout of the cull shader
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct GpuCullObject
+{
+    glm::vec4 sphere{ 0.f }; ///< World space center (xyz) and radius (w)
+    std::uint32_t batch{ 0 };
+    std::array<std::uint32_t, 3> padding{};
+};
+
+/// \brief A group of objects that is drawn with a single indirect count draw, matches the layout of the cull shader
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct GpuCullBatch
+{
+    std::uint32_t firstCommand{ 0 }; ///< First draw command of the batch in the command buffer
+    std::uint32_t elementCount{ 0 }; ///< Index count of indexed models, vertex count otherwise
+    std::uint32_t indexed{ 0 };
+    std::uint32_t padding{ 0 };
+};
+
+/// \brief Results of a culling pass
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct GpuCullStats
+{
+    std::uint32_t visible{ 0 };
+    std::uint32_t frustumCulled{ 0 };
+    std::uint32_t occlusionCulled{ 0 };
+    std::uint32_t padding{ 0 };
+};
+
+/// \brief Culls objects in a compute shader and writes the draw commands of the survivors
+///
+/// Every object is tested against the camera frustum and against a \ref DepthPyramid of the previous frame. Visible
+/// objects append a draw command with a single instance to their batch, so every batch is drawn by one
+/// vkCmdDrawIndexedIndirectCount with the number of survivors as draw count.
+///
+/// The statistics of a pass are copied into a host visible buffer and read when the same frame index is recorded
+/// again, so the host never waits for the GPU to finish culling.
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+class GpuCuller
+{
+public:
+    static constexpr std::uint32_t WORKGROUP_SIZE{ 64 };
+    /// \brief Stride of the commands in the command buffer, both indexed and non indexed commands use it
+    static constexpr VkDeviceSize COMMAND_STRIDE{ sizeof(VkDrawIndexedIndirectCommand) };
+
+    /// \brief Create a new \ref GpuCuller
+    ///
+    /// \param device the \ref Device on which the culling is done
+    /// \param framesInFlight how many frames can be recorded at the same time
+    GpuCuller(std::shared_ptr<Device> device, std::uint32_t framesInFlight);
+    ~GpuCuller();
+
+    GpuCuller(const GpuCuller&) = delete;
+    GpuCuller(GpuCuller&&) = delete;
+    GpuCuller& operator=(const GpuCuller&) = delete;
+    GpuCuller& operator=(GpuCuller&&) = delete;
+
+    /// \brief Whether the device supports the features needed to draw the culled commands
+    ///
+    /// \param device the \ref Device to check
+    [[nodiscard]] static bool isSupported(const Device& device) noexcept;
+
+    /// \brief Statistics of the most recent culling pass whose results reached the host
+    [[nodiscard]] const GpuCullStats& getStats() const noexcept { return m_stats; }
+    [[nodiscard]] VkBuffer getCommandBuffer(std::size_t frameIndex) const noexcept
+    {
+        return m_frames[frameIndex].commandBuffer->getBuffer();
+    }
+    [[nodiscard]] VkBuffer getCountBuffer(std::size_t frameIndex) const noexcept
+    {
+        return m_frames[frameIndex].countBuffer->getBuffer();
+    }
+    /// \brief Offset of the draw command at the given index in the command buffer (in byte)
+    [[nodiscard]] static VkDeviceSize commandOffset(std::uint32_t command) noexcept { return command * COMMAND_STRIDE; }
+    /// \brief Offset of the draw count of the given batch in the count buffer (in byte)
+    [[nodiscard]] static VkDeviceSize countOffset(std::uint32_t batch) noexcept
+    {
+        return sizeof(GpuCullStats) + (batch * sizeof(std::uint32_t));
+    }
+
+    /// \brief Upload the objects and batches that are culled in the current frame
+    ///
+    /// Also picks up the statistics of the last pass that was recorded with the same frame index
+    ///
+    /// \param frameIndex index of the frame in flight
+    /// \param objects the objects to cull
+    /// \param batches the batches the objects belong to. Their commands must not overlap
+    /// \param viewProjection projection * view of the camera that renders the current frame
+    void update(
+        std::size_t frameIndex,
+        std::span<const GpuCullObject> objects,
+        std::span<const GpuCullBatch> batches,
+        const glm::mat4& viewProjection
+    );
+    /// \brief Record the culling pass
+    ///
+    /// Has to be recorded outside of a render pass. The draws that read the command and count buffers have to wait
+    /// for the compute shader writes, e.g., by reading them as indirect commands in a later \ref RenderGraph pass
+    ///
+    /// \param commandBuffer the command buffer of the current frame
+    /// \param frameIndex index of the frame in flight
+    /// \param depthPyramid the \ref DepthPyramid of the previous frame, occlusion culling is skipped if it is invalid
+    void cull(VkCommandBuffer commandBuffer, std::size_t frameIndex, const DepthPyramid& depthPyramid);
+
+private:
+    static constexpr auto GPU_CULL_SHADER_PATH{ PROJECT_ROOT "resources/compiledShaders/gpuCullComp.spv" };
+    static constexpr std::uint32_t MIN_BUFFER_CAPACITY{ 64 };
+
+    /// \brief Uniforms of the cull shader
+    struct CullUniforms
+    {
+        glm::mat4 occlusionViewProjection{ 1.f };
+        std::array<glm::vec4, FrustumCuller::PLANE_COUNT> frustumPlanes{};
+        std::uint32_t objectCount{ 0 };
+    };
+
+    /// \brief Push constants of the cull shader
+    struct CullPushConstants
+    {
+        glm::vec2 pyramidSize;
+        std::uint32_t pyramidLevels;
+        std::uint32_t occlusionEnabled;
+    };
+
+    /// \brief Resources that exist once per frame in flight
+    struct FrameResources
+    {
+        std::unique_ptr<Buffer> uniformBuffer;
+        std::unique_ptr<Buffer> objectBuffer;
+        std::unique_ptr<Buffer> batchBuffer;
+        std::unique_ptr<Buffer> commandBuffer;
+        std::unique_ptr<Buffer> countBuffer;
+        std::unique_ptr<Buffer> readbackBuffer;
+        VkDescriptorSet descriptorSet{ VK_NULL_HANDLE };
+        std::uint32_t objectCapacity{ 0 };
+        std::uint32_t batchCapacity{ 0 };
+        std::uint32_t objectCount{ 0 };
+        std::uint32_t batchCount{ 0 };
+        bool hasResults{ false }; ///< Whether a pass was recorded that copies its stats into the readback buffer
+    };
+
+    std::shared_ptr<Device> device;
+    std::shared_ptr<DescriptorSetLayout> m_setLayout;
+    std::unique_ptr<DescriptorPool> m_pool;
+    VkPipelineLayout m_pipelineLayout{ VK_NULL_HANDLE };
+    std::unique_ptr<ComputePipeline> m_pipeline;
+
+    std::vector<FrameResources> m_frames;
+    FrustumCuller m_frustum;
+    glm::mat4 m_previousViewProjection{ 1.f };
+    GpuCullStats m_stats;
+
+    void createPipeline();
+    void reserveFrameResources(FrameResources& frame, std::uint32_t objectCount, std::uint32_t batchCount);
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_CORE_GPU_CULLER_HPP
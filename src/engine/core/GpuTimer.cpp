@@ -0,0 +1,155 @@
+#include "GpuTimer.hpp"
+
+#include "core/Device.hpp"
+#include "utility/exceptions/VulkanException.hpp"
+
+#include "spdlog/spdlog.h"
+#include <vulkan/vulkan_core.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace vv
+{
+
+GpuTimer::GpuTimer(std::shared_ptr<Device> device, std::uint32_t framesInFlight)
+    : device{ std::move(device) }, m_frames(framesInFlight)
+{
+    const QueueFamilyIndices indices{ this->device->findPhysicalQueueFamilies() };
+
+    std::uint32_t queueFamilyCount{ 0 };
+    vkGetPhysicalDeviceQueueFamilyProperties(this->device->physicalDevice(), &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(this->device->physicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+    if(!indices.graphicsFamily.has_value() || queueFamilies[indices.graphicsFamily.value()].timestampValidBits == 0)
+    {
+        spdlog::warn("Graphics queue does not support timestamps, GPU timings are disabled");
+        return;
+    }
+
+    m_timestampPeriod = static_cast<double>(this->device->properties.limits.timestampPeriod);
+
+    VkQueryPoolCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    createInfo.queryCount = framesInFlight * MAX_SCOPES * 2;
+
+    const VkResult result{ vkCreateQueryPool(this->device->device(), &createInfo, nullptr, &m_queryPool) };
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to create timestamp query pool", result);
+}
+
+GpuTimer::~GpuTimer()
+{
+    vkDestroyQueryPool(device->device(), m_queryPool, nullptr);
+}
+
+void GpuTimer::beginFrame(VkCommandBuffer commandBuffer, std::size_t frameIndex)
+{
+    if(!isSupported())
+        return;
+
+#if defined(VV_ENABLE_ASSERTS)
+    assert(frameIndex < m_frames.size() && "Frame index exceeds the amount of frames in flight");
+#endif
+
+    collectResults(frameIndex);
+
+    m_currentFrame = frameIndex;
+    m_frames[frameIndex].names.clear();
+    m_frames[frameIndex].openScopes.clear();
+
+    vkCmdResetQueryPool(commandBuffer, m_queryPool, firstQuery(frameIndex), MAX_SCOPES * 2);
+}
+
+void GpuTimer::beginScope(VkCommandBuffer commandBuffer, std::string_view name)
+{
+    if(!isSupported())
+        return;
+
+    auto& frame{ m_frames[m_currentFrame] };
+    if(frame.names.size() >= MAX_SCOPES)
+    {
+        spdlog::warn("GpuTimer: scope '{}' exceeds the maximum of {} scopes per frame", name, MAX_SCOPES);
+        return;
+    }
+
+    const auto scope{ static_cast<std::uint32_t>(frame.names.size()) };
+    frame.names.emplace_back(name);
+    frame.openScopes.push_back(scope);
+
+    vkCmdWriteTimestamp(
+        commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_queryPool, firstQuery(m_currentFrame) + (scope * 2)
+    );
+}
+
+void GpuTimer::endScope(VkCommandBuffer commandBuffer)
+{
+    if(!isSupported())
+        return;
+
+    auto& frame{ m_frames[m_currentFrame] };
+    if(frame.openScopes.empty())
+        return;
+
+    const std::uint32_t scope{ frame.openScopes.back() };
+    frame.openScopes.pop_back();
+
+    vkCmdWriteTimestamp(
+        commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_queryPool, firstQuery(m_currentFrame) + (scope * 2) + 1
+    );
+}
+
+/// \brief Read back the timestamps that were written the last time the frame index was in use
+///
+/// If a scope was left open or the results are not available yet (i.e., the swapchain was recreated and the frame
+/// indices of renderer and swapchain got out of sync) the previous results are kept
+void GpuTimer::collectResults(std::size_t frameIndex)
+{
+    const auto& frame{ m_frames[frameIndex] };
+    if(frame.names.empty())
+        return;
+
+    if(!frame.openScopes.empty())
+    {
+        spdlog::warn("GpuTimer: scope '{}' was never ended", frame.names[frame.openScopes.back()]);
+        return;
+    }
+
+    const auto queryCount{ static_cast<std::uint32_t>(frame.names.size() * 2) };
+    std::vector<std::uint64_t> timestamps(queryCount);
+
+    const VkResult result{ vkGetQueryPoolResults(
+        device->device(),
+        m_queryPool,
+        firstQuery(frameIndex),
+        queryCount,
+        timestamps.size() * sizeof(std::uint64_t),
+        timestamps.data(),
+        sizeof(std::uint64_t),
+        VK_QUERY_RESULT_64_BIT
+    ) };
+    if(result != VK_SUCCESS)
+        return;
+
+    constexpr double NANOSECONDS_PER_MILLISECOND{ 1'000'000.0 };
+
+    m_results.clear();
+    for(std::size_t i{ 0 }; i < frame.names.size(); ++i)
+    {
+        const auto ticks{ timestamps[(i * 2) + 1] - timestamps[i * 2] };
+        m_results.push_back(
+            { .name = frame.names[i],
+              .milliseconds = static_cast<double>(ticks) * m_timestampPeriod / NANOSECONDS_PER_MILLISECOND }
+        );
+    }
+}
+
+} // namespace vv
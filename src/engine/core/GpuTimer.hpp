@@ -0,0 +1,101 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_CORE_GPU_TIMER_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_CORE_GPU_TIMER_HPP
+
+#include "core/Device.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vv
+{
+
+/// \brief Measured GPU duration of one named scope
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct GpuTimerResult
+{
+    std::string name;
+    double milliseconds{ 0.0 };
+};
+
+/// \brief Measures GPU execution time of named scopes inside a frame using timestamp queries
+///
+/// Every frame in flight owns its own range of queries. The results of a frame are read back the next time the same
+/// frame index is started, at which point the in flight fence of that frame has already been waited on, so reading the
+/// queries never stalls the CPU.
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+class GpuTimer
+{
+public:
+    static constexpr std::uint32_t MAX_SCOPES{ 32 };
+
+    /// \brief Create a new \ref GpuTimer
+    ///
+    /// \param device the \ref Device on which the query pool is created
+    /// \param framesInFlight how many frames can be recorded before the results of the first one are read
+    GpuTimer(std::shared_ptr<Device> device, std::uint32_t framesInFlight);
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer(GpuTimer&&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+    GpuTimer& operator=(GpuTimer&&) = delete;
+
+    /// \brief Whether the graphics queue supports timestamps at all. If not, every call is a no-op
+    [[nodiscard]] bool isSupported() const noexcept { return m_queryPool != VK_NULL_HANDLE; }
+    /// \brief The timings of the most recently completed frame
+    [[nodiscard]] const std::vector<GpuTimerResult>& getResults() const noexcept { return m_results; }
+
+    /// \brief Collect the results of the previous use of this frame index and reset its queries
+    ///
+    /// Has to be recorded outside of a render pass, before any scope of the frame is started
+    ///
+    /// \param commandBuffer the command buffer of the frame that is being recorded
+    /// \param frameIndex index of the frame in flight
+    void beginFrame(VkCommandBuffer commandBuffer, std::size_t frameIndex);
+    /// \brief Start timing a new scope
+    ///
+    /// \param commandBuffer the command buffer of the current frame
+    /// \param name the name under which the timing is reported
+    void beginScope(VkCommandBuffer commandBuffer, std::string_view name);
+    /// \brief End the most recently started scope that is still open
+    ///
+    /// \param commandBuffer the command buffer of the current frame
+    void endScope(VkCommandBuffer commandBuffer);
+
+private:
+    /// \brief Bookkeeping of the scopes recorded into one frame
+    struct FrameScopes
+    {
+        std::vector<std::string> names;
+        std::vector<std::uint32_t> openScopes;
+    };
+
+    std::shared_ptr<Device> device;
+    VkQueryPool m_queryPool{ VK_NULL_HANDLE };
+    double m_timestampPeriod{ 1.0 };
+
+    std::vector<FrameScopes> m_frames;
+    std::size_t m_currentFrame{ 0 };
+    std::vector<GpuTimerResult> m_results;
+
+    [[nodiscard]] std::uint32_t firstQuery(std::size_t frameIndex) const noexcept
+    {
+        return static_cast<std::uint32_t>(frameIndex) * MAX_SCOPES * 2;
+    }
+
+    void collectResults(std::size_t frameIndex);
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_CORE_GPU_TIMER_HPP
@@ -34,10 +34,7 @@ GraphicsPipeline::GraphicsPipeline(
 #endif
 
     const auto vertCode{ readFile(vertexShaderPath) };
-    const auto fragCode{ readFile(fragmentShaderPath) };
-
     createShaderModule(vertCode, &m_vertexShaderModule);
-    createShaderModule(fragCode, &m_fragmentShaderModule);
 
     std::array<VkPipelineShaderStageCreateInfo, 2> shaderStages{};
     shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -45,10 +42,18 @@ GraphicsPipeline::GraphicsPipeline(
     shaderStages[0].module = m_vertexShaderModule;
     shaderStages[0].pName = "main";
 
-    shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-    shaderStages[1].module = m_fragmentShaderModule;
-    shaderStages[1].pName = "main";
+    // NOTE: Without a fragment stage only the depth of the fragments is written
+    const bool hasFragmentStage{ !fragmentShaderPath.empty() };
+    if(hasFragmentStage)
+    {
+        const auto fragCode{ readFile(fragmentShaderPath) };
+        createShaderModule(fragCode, &m_fragmentShaderModule);
+
+        shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+        shaderStages[1].module = m_fragmentShaderModule;
+        shaderStages[1].pName = "main";
+    }
 
     const auto& bindingDescriptions{ configInfo.bindingDescription };
     const auto& attributeDescriptions{ configInfo.attributeDescription };
@@ -61,7 +66,7 @@ GraphicsPipeline::GraphicsPipeline(
 
     VkGraphicsPipelineCreateInfo pipelineInfo{};
     pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    pipelineInfo.stageCount = shaderStages.size();
+    pipelineInfo.stageCount = hasFragmentStage ? 2 : 1;
     pipelineInfo.pStages = shaderStages.data();
     pipelineInfo.pVertexInputState = &vertexInputInfo;
     pipelineInfo.pInputAssemblyState = &configInfo.inputAssemblyInfo;
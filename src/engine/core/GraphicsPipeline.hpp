@@ -48,7 +48,8 @@ public:
     ///
     /// \param device \ref Device where the pipeline is created on
     /// \param vertexShaderPath filepath to the vertex shader in spir-v format
-    /// \param fragmentShaderPath filepath to the fragment shader in spir-v format
+    /// \param fragmentShaderPath filepath to the fragment shader in spir-v format, an empty path creates a pipeline
+    /// without a fragment stage, i.e., for depth only passes
     /// \param configInfo \ref GraphicsPipelineConfigInfo that contains information of how the pipeline should be configured
     GraphicsPipeline(
         std::shared_ptr<Device> device,
@@ -0,0 +1,190 @@
+#include "LightClusterer.hpp"
+
+#include "core/Buffer.hpp"
+#include "core/ComputePipeline.hpp"
+#include "core/DescriptorPool.hpp"
+#include "core/DescriptorSetLayout.hpp"
+#include "core/DescriptorWriter.hpp"
+#include "core/Device.hpp"
+#include "utility/FrameInfo.hpp"
+#include "utility/exceptions/Exception.hpp"
+#include "utility/exceptions/VulkanException.hpp"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include "glm/glm.hpp"
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+
+namespace vv
+{
+
+LightClusterer::LightClusterer(std::shared_ptr<Device> device, std::uint32_t framesInFlight)
+    : device{ std::move(device) }
+    , m_setLayout{ DescriptorSetLayout::Builder(this->device)
+                       .addBinding(
+                           0,
+                           VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                           VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_FRAGMENT_BIT
+                       )
+                       .addBinding(
+                           1,
+                           VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                           VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_FRAGMENT_BIT
+                       )
+                       .addBinding(
+                           2,
+                           VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                           VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_FRAGMENT_BIT
+                       )
+                       .addBinding(
+                           3,
+                           VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                           VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_FRAGMENT_BIT
+                       )
+                       .buildShared() }
+    , m_pool{ DescriptorPool::Builder(this->device)
+                  .setMaxSets(framesInFlight)
+                  .addPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, framesInFlight)
+                  .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3 * framesInFlight)
+                  .build() }
+    , m_frames(framesInFlight)
+{
+    createPipeline();
+
+    for(auto& frame : m_frames)
+    {
+        frame.uniformBuffer = std::make_unique<Buffer>(
+            Buffer::createUniformBuffer(this->device, sizeof(ClusterUniforms), 1)
+        );
+        frame.countBuffer = std::make_unique<Buffer>(
+            Buffer::createStorageBuffer(this->device, sizeof(std::uint32_t), CLUSTER_COUNT)
+        );
+        frame.indexBuffer = std::make_unique<Buffer>(
+            Buffer::createStorageBuffer(this->device, sizeof(std::uint32_t), CLUSTER_COUNT * MAX_LIGHTS_PER_CLUSTER)
+        );
+
+        if(!m_pool->allocateDescriptor(m_setLayout->getDescriptorLayout(), frame.descriptorSet))
+            throw Exception("Failed to allocate light cluster descriptor set");
+
+        reserveLights(frame, MIN_LIGHT_CAPACITY);
+    }
+}
+
+LightClusterer::~LightClusterer()
+{
+    m_pipeline.reset();
+    vkDestroyPipelineLayout(device->device(), m_pipelineLayout, nullptr);
+}
+
+void LightClusterer::update(
+    std::size_t frameIndex,
+    std::span<const PointLight> lights,
+    const glm::mat4& view,
+    const glm::mat4& projection,
+    float nearPlane,
+    float farPlane,
+    VkExtent2D extent
+)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(frameIndex < m_frames.size() && "Frame index exceeds the amount of frames in flight");
+    assert(nearPlane > 0.f && farPlane > nearPlane && "Clustering requires a perspective projection");
+#endif
+
+    auto& frame{ m_frames[frameIndex] };
+    frame.lightCount = static_cast<std::uint32_t>(lights.size());
+    reserveLights(frame, frame.lightCount);
+
+    // NOTE: slice = log(depth) * scale - bias maps the near plane to 0 and the far plane to GRID_SIZE_Z
+    const float logDepthRange{ std::log(farPlane / nearPlane) };
+    const float sliceScale{ static_cast<float>(GRID_SIZE_Z) / logDepthRange };
+    const float sliceBias{ static_cast<float>(GRID_SIZE_Z) * std::log(nearPlane) / logDepthRange };
+
+    const ClusterUniforms uniforms{
+        .view = view,
+        .projection = { projection[0][0], projection[1][1], nearPlane, farPlane },
+        .screen = { static_cast<float>(extent.width), static_cast<float>(extent.height), sliceScale, sliceBias },
+        .grid = { GRID_SIZE_X, GRID_SIZE_Y, GRID_SIZE_Z, frame.lightCount }
+    };
+    frame.uniformBuffer->writeToBuffer(uniforms);
+    frame.uniformBuffer->flush();
+
+    if(lights.empty())
+        return;
+
+    frame.lightBuffer->writeToBuffer(lights);
+    frame.lightBuffer->flush();
+}
+
+void LightClusterer::build(VkCommandBuffer commandBuffer, std::size_t frameIndex)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(frameIndex < m_frames.size() && "Frame index exceeds the amount of frames in flight");
+#endif
+
+    const auto& frame{ m_frames[frameIndex] };
+
+    // NOTE: Every cluster writes its count, so the pass also has to run without lights to clear the previous lists
+    m_pipeline->bind(commandBuffer);
+    vkCmdBindDescriptorSets(
+        commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, 1, &frame.descriptorSet, 0, nullptr
+    );
+    vkCmdDispatch(commandBuffer, (CLUSTER_COUNT + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+}
+
+/// \brief Create the pipeline layout and the compute pipeline of the cluster shader
+void LightClusterer::createPipeline()
+{
+    const VkDescriptorSetLayout setLayout{ m_setLayout->getDescriptorLayout() };
+
+    VkPipelineLayoutCreateInfo layoutCI{};
+    layoutCI.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutCI.setLayoutCount = 1;
+    layoutCI.pSetLayouts = &setLayout;
+
+    const VkResult result{ vkCreatePipelineLayout(device->device(), &layoutCI, nullptr, &m_pipelineLayout) };
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to create light cluster pipeline layout", result);
+
+    m_pipeline = std::make_unique<ComputePipeline>(device, LIGHT_CLUSTER_SHADER_PATH, m_pipelineLayout);
+}
+
+/// \brief Make sure that the light buffer of a frame is big enough, recreate it with more capacity if not
+///
+/// The frame's previous submission has already finished when this is called, so its set can be rewritten
+///
+/// \param frame the resources of the frame that is being recorded
+/// \param lightCount how many lights are binned
+void LightClusterer::reserveLights(FrameResources& frame, std::uint32_t lightCount)
+{
+    if(lightCount <= frame.lightCapacity && frame.lightBuffer != nullptr)
+        return;
+
+    frame.lightCapacity = std::max(std::bit_ceil(lightCount), MIN_LIGHT_CAPACITY);
+    frame.lightBuffer = std::make_unique<Buffer>(
+        Buffer::createHostStorageBuffer(device, sizeof(PointLight), frame.lightCapacity)
+    );
+
+    auto uniformInfo{ frame.uniformBuffer->descriptorInfo() };
+    auto lightInfo{ frame.lightBuffer->descriptorInfo() };
+    auto countInfo{ frame.countBuffer->descriptorInfo() };
+    auto indexInfo{ frame.indexBuffer->descriptorInfo() };
+    DescriptorWriter{ m_setLayout.get(), m_pool.get() }
+        .writeBuffer(0, &uniformInfo)
+        .writeBuffer(1, &lightInfo)
+        .writeBuffer(2, &countInfo)
+        .writeBuffer(3, &indexInfo)
+        .overwrite(frame.descriptorSet);
+}
+
+} // namespace vv
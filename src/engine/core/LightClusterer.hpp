@@ -0,0 +1,172 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_CORE_LIGHT_CLUSTERER_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_CORE_LIGHT_CLUSTERER_HPP
+
+#include "core/Buffer.hpp"
+#include "core/ComputePipeline.hpp"
+#include "core/DescriptorPool.hpp"
+#include "core/DescriptorSetLayout.hpp"
+#include "core/Device.hpp"
+#include "utility/FrameInfo.hpp"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include "glm/glm.hpp"
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace vv
+{
+
+/// \brief Bins point lights into a 3D grid of clusters (froxels) so that fragments only shade nearby lights
+///
+/// The view frustum is split into screen space tiles and logarithmic depth slices. A compute pass tests the range of
+/// every light against the view space bounds of every cluster and writes a list of light indices per cluster. The
+/// fragment shader finds its cluster from its screen position and depth and only loops over that list.
+///
+/// The descriptor set of a frame is used by the compute pass and by the shading pipelines, which bind it with the
+/// layout from \ref getSetLayout.
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+class LightClusterer
+{
+public:
+    static constexpr std::uint32_t GRID_SIZE_X{ 16 };
+    static constexpr std::uint32_t GRID_SIZE_Y{ 9 };
+    static constexpr std::uint32_t GRID_SIZE_Z{ 24 };
+    static constexpr std::uint32_t CLUSTER_COUNT{ GRID_SIZE_X * GRID_SIZE_Y * GRID_SIZE_Z };
+    /// \brief Lights beyond this count are dropped from a cluster, has to match the shaders
+    static constexpr std::uint32_t MAX_LIGHTS_PER_CLUSTER{ 256 };
+    static constexpr std::uint32_t WORKGROUP_SIZE{ 64 };
+
+    /// \brief Create a new \ref LightClusterer
+    ///
+    /// \param device the \ref Device on which the lights are binned
+    /// \param framesInFlight how many frames can be recorded at the same time
+    LightClusterer(std::shared_ptr<Device> device, std::uint32_t framesInFlight);
+    ~LightClusterer();
+
+    LightClusterer(const LightClusterer&) = delete;
+    LightClusterer(LightClusterer&&) = delete;
+    LightClusterer& operator=(const LightClusterer&) = delete;
+    LightClusterer& operator=(LightClusterer&&) = delete;
+
+    /// \brief Layout of the light set: cluster parameters, lights, light counts and light indices per cluster
+    [[nodiscard]] std::shared_ptr<DescriptorSetLayout> getSetLayout() const noexcept { return m_setLayout; }
+    [[nodiscard]] VkDescriptorSet getDescriptorSet(std::size_t frameIndex) const noexcept
+    {
+        return m_frames[frameIndex].descriptorSet;
+    }
+    [[nodiscard]] std::uint32_t getLightCount(std::size_t frameIndex) const noexcept
+    {
+        return m_frames[frameIndex].lightCount;
+    }
+    /// \brief Buffer with the amount of lights in every cluster, written by \ref build
+    [[nodiscard]] VkBuffer getCountBuffer(std::size_t frameIndex) const noexcept
+    {
+        return m_frames[frameIndex].countBuffer->getBuffer();
+    }
+    /// \brief Buffer with the light indices of every cluster, written by \ref build
+    [[nodiscard]] VkBuffer getIndexBuffer(std::size_t frameIndex) const noexcept
+    {
+        return m_frames[frameIndex].indexBuffer->getBuffer();
+    }
+
+    /// \brief Depth slice that contains a view space depth
+    ///
+    /// \param viewDepth distance along the view direction
+    /// \param nearPlane distance of the near plane
+    /// \param farPlane distance of the far plane
+    [[nodiscard]] static std::uint32_t depthSlice(float viewDepth, float nearPlane, float farPlane) noexcept
+    {
+        const float slice{ std::floor(
+            std::log(viewDepth / nearPlane) * static_cast<float>(GRID_SIZE_Z) / std::log(farPlane / nearPlane)
+        ) };
+
+        return static_cast<std::uint32_t>(std::clamp(slice, 0.f, static_cast<float>(GRID_SIZE_Z - 1)));
+    }
+    /// \brief View space depth where a slice begins
+    ///
+    /// \param slice index of the slice, \ref GRID_SIZE_Z is the far plane
+    /// \param nearPlane distance of the near plane
+    /// \param farPlane distance of the far plane
+    [[nodiscard]] static float sliceDepth(std::uint32_t slice, float nearPlane, float farPlane) noexcept
+    {
+        return nearPlane
+               * std::pow(farPlane / nearPlane, static_cast<float>(slice) / static_cast<float>(GRID_SIZE_Z));
+    }
+
+    /// \brief Upload the lights and camera parameters of the current frame
+    ///
+    /// \param frameIndex index of the frame in flight
+    /// \param lights the point lights, the w component of the position is the range of the light
+    /// \param view view matrix of the camera
+    /// \param projection perspective projection of the camera
+    /// \param nearPlane distance of the camera's near plane
+    /// \param farPlane distance of the camera's far plane
+    /// \param extent size of the rendered image
+    void update(
+        std::size_t frameIndex,
+        std::span<const PointLight> lights,
+        const glm::mat4& view,
+        const glm::mat4& projection,
+        float nearPlane,
+        float farPlane,
+        VkExtent2D extent
+    );
+    /// \brief Record the binning pass
+    ///
+    /// Has to be recorded outside of a render pass. The draws that shade with the light set have to wait for the
+    /// compute shader writes to the count and index buffers, e.g., by reading them in a later \ref RenderGraph pass
+    ///
+    /// \param commandBuffer the command buffer of the current frame
+    /// \param frameIndex index of the frame in flight
+    void build(VkCommandBuffer commandBuffer, std::size_t frameIndex);
+
+private:
+    static constexpr auto LIGHT_CLUSTER_SHADER_PATH{ PROJECT_ROOT "resources/compiledShaders/lightClusterComp.spv" };
+    static constexpr std::uint32_t MIN_LIGHT_CAPACITY{ 64 };
+
+    /// \brief Uniforms of the cluster and shading shaders
+    struct ClusterUniforms
+    {
+        glm::mat4 view{ 1.f };
+        glm::vec4 projection{ 0.f }; ///< x = projection[0][0], y = projection[1][1], z = near plane, w = far plane
+        glm::vec4 screen{ 0.f };     ///< xy = size of the image, z = depth slice scale, w = depth slice bias
+        glm::uvec4 grid{ 0 };        ///< xyz = clusters per axis, w = light count
+    };
+
+    /// \brief Resources that exist once per frame in flight
+    struct FrameResources
+    {
+        std::unique_ptr<Buffer> uniformBuffer;
+        std::unique_ptr<Buffer> lightBuffer;
+        std::unique_ptr<Buffer> countBuffer;
+        std::unique_ptr<Buffer> indexBuffer;
+        VkDescriptorSet descriptorSet{ VK_NULL_HANDLE };
+        std::uint32_t lightCapacity{ 0 };
+        std::uint32_t lightCount{ 0 };
+    };
+
+    std::shared_ptr<Device> device;
+    std::shared_ptr<DescriptorSetLayout> m_setLayout;
+    std::unique_ptr<DescriptorPool> m_pool;
+    VkPipelineLayout m_pipelineLayout{ VK_NULL_HANDLE };
+    std::unique_ptr<ComputePipeline> m_pipeline;
+
+    std::vector<FrameResources> m_frames;
+
+    void createPipeline();
+    void reserveLights(FrameResources& frame, std::uint32_t lightCount);
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_CORE_LIGHT_CLUSTERER_HPP
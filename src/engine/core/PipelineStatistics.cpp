@@ -0,0 +1,144 @@
+#include "PipelineStatistics.hpp"
+
+#include "core/Device.hpp"
+#include "utility/exceptions/VulkanException.hpp"
+
+#include "spdlog/spdlog.h"
+#include <vulkan/vulkan_core.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace vv
+{
+
+PipelineStatistics::PipelineStatistics(std::shared_ptr<Device> device, std::uint32_t framesInFlight)
+    : device{ std::move(device) }, m_frames(framesInFlight)
+{
+    if(this->device->enabledFeatures().pipelineStatisticsQuery == VK_FALSE)
+    {
+        spdlog::warn("Pipeline statistics queries are not supported, shader invocations are not counted");
+        return;
+    }
+
+    VkQueryPoolCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    createInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+    createInfo.queryCount = framesInFlight * MAX_SCOPES;
+    createInfo.pipelineStatistics = STATISTICS;
+
+    const VkResult result{ vkCreateQueryPool(this->device->device(), &createInfo, nullptr, &m_queryPool) };
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to create pipeline statistics query pool", result);
+}
+
+PipelineStatistics::~PipelineStatistics()
+{
+    vkDestroyQueryPool(device->device(), m_queryPool, nullptr);
+}
+
+void PipelineStatistics::beginFrame(VkCommandBuffer commandBuffer, std::size_t frameIndex)
+{
+    if(!isSupported())
+        return;
+
+#if defined(VV_ENABLE_ASSERTS)
+    assert(frameIndex < m_frames.size() && "Frame index exceeds the amount of frames in flight");
+#endif
+
+    collectResults(frameIndex);
+
+    m_currentFrame = frameIndex;
+    m_frames[frameIndex].names.clear();
+    m_frames[frameIndex].scopeOpen = false;
+
+    vkCmdResetQueryPool(commandBuffer, m_queryPool, firstQuery(frameIndex), MAX_SCOPES);
+}
+
+void PipelineStatistics::beginScope(VkCommandBuffer commandBuffer, std::string_view name)
+{
+    if(!isSupported())
+        return;
+
+    auto& frame{ m_frames[m_currentFrame] };
+#if defined(VV_ENABLE_ASSERTS)
+    assert(!frame.scopeOpen && "Pipeline statistics scopes can not be nested");
+#endif
+
+    if(frame.names.size() >= MAX_SCOPES)
+    {
+        spdlog::warn("PipelineStatistics: scope '{}' exceeds the maximum of {} scopes per frame", name, MAX_SCOPES);
+        return;
+    }
+
+    const auto scope{ static_cast<std::uint32_t>(frame.names.size()) };
+    frame.names.emplace_back(name);
+    frame.scopeOpen = true;
+
+    vkCmdBeginQuery(commandBuffer, m_queryPool, firstQuery(m_currentFrame) + scope, 0);
+}
+
+void PipelineStatistics::endScope(VkCommandBuffer commandBuffer)
+{
+    if(!isSupported())
+        return;
+
+    auto& frame{ m_frames[m_currentFrame] };
+    if(!frame.scopeOpen)
+        return;
+
+    frame.scopeOpen = false;
+
+    const auto scope{ static_cast<std::uint32_t>(frame.names.size() - 1) };
+    vkCmdEndQuery(commandBuffer, m_queryPool, firstQuery(m_currentFrame) + scope);
+}
+
+/// \brief Read back the counters that were written the last time the frame index was in use
+///
+/// If the scope was left open or the results are not available yet the previous results are kept
+void PipelineStatistics::collectResults(std::size_t frameIndex)
+{
+    const auto& frame{ m_frames[frameIndex] };
+    if(frame.names.empty())
+        return;
+
+    if(frame.scopeOpen)
+    {
+        spdlog::warn("PipelineStatistics: scope '{}' was never ended", frame.names.back());
+        return;
+    }
+
+    const auto queryCount{ static_cast<std::uint32_t>(frame.names.size()) };
+    std::vector<std::uint64_t> counters(static_cast<std::size_t>(queryCount) * STATISTICS_COUNT);
+
+    const VkResult result{ vkGetQueryPoolResults(
+        device->device(),
+        m_queryPool,
+        firstQuery(frameIndex),
+        queryCount,
+        counters.size() * sizeof(std::uint64_t),
+        counters.data(),
+        STATISTICS_COUNT * sizeof(std::uint64_t),
+        VK_QUERY_RESULT_64_BIT
+    ) };
+    if(result != VK_SUCCESS)
+        return;
+
+    m_results.clear();
+    for(std::size_t i{ 0 }; i < frame.names.size(); ++i)
+    {
+        m_results.push_back(
+            { .name = frame.names[i],
+              .vertexShaderInvocations = counters[i * STATISTICS_COUNT],
+              .fragmentShaderInvocations = counters[(i * STATISTICS_COUNT) + 1] }
+        );
+    }
+}
+
+} // namespace vv
@@ -0,0 +1,110 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_CORE_PIPELINE_STATISTICS_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_CORE_PIPELINE_STATISTICS_HPP
+
+#include "core/Device.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vv
+{
+
+/// \brief Shader invocations counted during one named scope
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct PipelineStatisticsResult
+{
+    std::string name;
+    std::uint64_t vertexShaderInvocations{ 0 };
+    std::uint64_t fragmentShaderInvocations{ 0 };
+};
+
+/// \brief Counts vertex and fragment shader invocations of named scopes inside a frame using pipeline statistics
+/// queries
+///
+/// Works like the \ref GpuTimer: every frame in flight owns its own range of queries and its results are read back
+/// the next time the same frame index is started. Unlike timer scopes, statistics scopes can not be nested.
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+class PipelineStatistics
+{
+public:
+    static constexpr std::uint32_t MAX_SCOPES{ 8 };
+
+    /// \brief Create a new \ref PipelineStatistics
+    ///
+    /// \param device the \ref Device on which the query pool is created
+    /// \param framesInFlight how many frames can be recorded before the results of the first one are read
+    PipelineStatistics(std::shared_ptr<Device> device, std::uint32_t framesInFlight);
+    ~PipelineStatistics();
+
+    PipelineStatistics(const PipelineStatistics&) = delete;
+    PipelineStatistics(PipelineStatistics&&) = delete;
+    PipelineStatistics& operator=(const PipelineStatistics&) = delete;
+    PipelineStatistics& operator=(PipelineStatistics&&) = delete;
+
+    /// \brief Whether the device supports pipeline statistics queries. If not, every call is a no-op
+    [[nodiscard]] bool isSupported() const noexcept { return m_queryPool != VK_NULL_HANDLE; }
+    /// \brief The statistics of the most recently completed frame
+    [[nodiscard]] const std::vector<PipelineStatisticsResult>& getResults() const noexcept { return m_results; }
+
+    /// \brief Collect the results of the previous use of this frame index and reset its queries
+    ///
+    /// Has to be recorded outside of a render pass, before any scope of the frame is started
+    ///
+    /// \param commandBuffer the command buffer of the frame that is being recorded
+    /// \param frameIndex index of the frame in flight
+    void beginFrame(VkCommandBuffer commandBuffer, std::size_t frameIndex);
+    /// \brief Start counting a new scope
+    ///
+    /// A scope that is started inside a render pass has to end in the same subpass
+    ///
+    /// \param commandBuffer the command buffer of the current frame
+    /// \param name the name under which the statistics are reported
+    void beginScope(VkCommandBuffer commandBuffer, std::string_view name);
+    /// \brief End the scope that is currently open
+    ///
+    /// \param commandBuffer the command buffer of the current frame
+    void endScope(VkCommandBuffer commandBuffer);
+
+private:
+    /// \brief Counters written per query, in the order of their bits
+    static constexpr VkQueryPipelineStatisticFlags STATISTICS{
+        VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT
+        | VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT
+    };
+    static constexpr std::uint32_t STATISTICS_COUNT{ 2 };
+
+    /// \brief Bookkeeping of the scopes recorded into one frame
+    struct FrameScopes
+    {
+        std::vector<std::string> names;
+        bool scopeOpen{ false };
+    };
+
+    std::shared_ptr<Device> device;
+    VkQueryPool m_queryPool{ VK_NULL_HANDLE };
+
+    std::vector<FrameScopes> m_frames;
+    std::size_t m_currentFrame{ 0 };
+    std::vector<PipelineStatisticsResult> m_results;
+
+    [[nodiscard]] std::uint32_t firstQuery(std::size_t frameIndex) const noexcept
+    {
+        return static_cast<std::uint32_t>(frameIndex) * MAX_SCOPES;
+    }
+
+    void collectResults(std::size_t frameIndex);
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_CORE_PIPELINE_STATISTICS_HPP
@@ -0,0 +1,414 @@
+#include "RenderGraph.hpp"
+
+#include "core/Device.hpp"
+#include "utility/RenderGraphCompiler.hpp"
+#include "utility/exceptions/VulkanException.hpp"
+
+#include "vk_mem_alloc.h"
+#include <vulkan/vulkan_core.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace vv
+{
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::read(RenderGraphImage image, const RenderGraphAccess& access)
+{
+    return use(image.index, access, false);
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::read(RenderGraphBuffer buffer, const RenderGraphAccess& access)
+{
+    return use(buffer.index, access, false);
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::write(RenderGraphImage image, const RenderGraphAccess& access)
+{
+    return use(image.index, access, true);
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::write(RenderGraphBuffer buffer, const RenderGraphAccess& access)
+{
+    return use(buffer.index, access, true);
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::setSideEffects()
+{
+    m_graph.m_passInfos[m_pass].sideEffects = true;
+
+    return *this;
+}
+
+/// \brief Add an access to the pass
+///
+/// \param resource index of the resource in the graph
+/// \param access how the pass uses the resource
+/// \param write whether the pass writes the resource, overrides the write flag of \p access
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::use(std::uint32_t resource, RenderGraphAccess access, bool write)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(resource < m_graph.m_resources.size() && "Resource does not belong to the graph");
+#endif
+
+    access.write = write;
+    m_graph.m_passInfos[m_pass].accesses.push_back({ .resource = resource, .access = access });
+
+    return *this;
+}
+
+RenderGraph::RenderGraph(std::shared_ptr<Device> device)
+    : device{ std::move(device) }
+{}
+
+RenderGraph::~RenderGraph()
+{
+    destroyTransientImages();
+}
+
+std::size_t RenderGraph::getBarrierCount() const noexcept
+{
+    std::size_t count{ 0 };
+    for(const auto& barriers : m_plan.barriers)
+        count += barriers.size();
+
+    return count;
+}
+
+VkImage RenderGraph::getImage(RenderGraphImage image) const
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(m_compiled && "Transient images only exist after the graph was compiled");
+    assert(m_resources[image.index].transient != NO_TRANSIENT && "Only transient images are owned by the graph");
+#endif
+
+    return m_transientImages[m_resources[image.index].transient].image;
+}
+
+VkImageView RenderGraph::getImageView(RenderGraphImage image) const
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(m_compiled && "Transient images only exist after the graph was compiled");
+    assert(m_resources[image.index].transient != NO_TRANSIENT && "Only transient images are owned by the graph");
+#endif
+
+    return m_transientImages[m_resources[image.index].transient].view;
+}
+
+void RenderGraph::reset()
+{
+    m_resources.clear();
+    m_resourceInfos.clear();
+    m_passes.clear();
+    m_passInfos.clear();
+    m_transientDescs.clear();
+    m_compiled = false;
+}
+
+RenderGraphImage RenderGraph::importImage(
+    VkImage image, const VkImageSubresourceRange& range, const RenderGraphAccess& initialAccess
+)
+{
+    const auto index{ static_cast<std::uint32_t>(m_resources.size()) };
+    m_resources.push_back({ .image = image, .buffer = VK_NULL_HANDLE, .range = range, .transient = NO_TRANSIENT });
+    m_resourceInfos.push_back({ .image = true, .imported = true, .initialAccess = initialAccess });
+
+    return { .index = index };
+}
+
+RenderGraphBuffer RenderGraph::importBuffer(VkBuffer buffer, const RenderGraphAccess& initialAccess)
+{
+    const auto index{ static_cast<std::uint32_t>(m_resources.size()) };
+    m_resources.push_back({ .image = VK_NULL_HANDLE, .buffer = buffer, .range = {}, .transient = NO_TRANSIENT });
+    m_resourceInfos.push_back({ .image = false, .imported = true, .initialAccess = initialAccess });
+
+    return { .index = index };
+}
+
+RenderGraphImage RenderGraph::createImage(const RenderGraphImageDesc& desc)
+{
+    const auto index{ static_cast<std::uint32_t>(m_resources.size()) };
+    const VkImageSubresourceRange range{ .aspectMask = desc.aspectMask,
+                                         .baseMipLevel = 0,
+                                         .levelCount = 1,
+                                         .baseArrayLayer = 0,
+                                         .layerCount = 1 };
+
+    m_resources.push_back({ .image = VK_NULL_HANDLE,
+                            .buffer = VK_NULL_HANDLE,
+                            .range = range,
+                            .transient = static_cast<std::uint32_t>(m_transientDescs.size()) });
+    m_resourceInfos.push_back({ .image = true, .imported = false, .initialAccess = {} });
+    m_transientDescs.push_back(desc);
+
+    return { .index = index };
+}
+
+RenderGraph::PassBuilder RenderGraph::addPass(std::string name, ExecuteFunction execute)
+{
+    m_passes.push_back({ .name = std::move(name), .execute = std::move(execute) });
+    m_passInfos.emplace_back();
+
+    return { *this, m_passes.size() - 1 };
+}
+
+void RenderGraph::compile()
+{
+    m_plan = compileRenderGraph(m_resourceInfos, m_passInfos);
+
+    if(!transientImagesMatch())
+        createTransientImages();
+
+    m_compiled = true;
+}
+
+void RenderGraph::execute(VkCommandBuffer commandBuffer)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(m_compiled && "The graph has to be compiled before it is executed");
+#endif
+
+    for(std::size_t position{ 0 }; position < m_plan.passes.size(); ++position)
+    {
+        const std::uint32_t pass{ m_plan.passes[position] };
+
+        recordBarriers(commandBuffer, position);
+        m_passes[pass].execute(commandBuffer);
+
+        for(const auto& access : m_passInfos[pass].accesses)
+        {
+            const std::uint32_t transient{ m_resources[access.resource].transient };
+            if(transient != NO_TRANSIENT)
+                m_memorySlots[m_transientImages[transient].slot].stages |= access.access.stages;
+        }
+    }
+}
+
+/// \brief Whether the existing transient images were created for the current declarations and lifetimes
+bool RenderGraph::transientImagesMatch() const
+{
+    if(m_transientImages.size() != m_transientDescs.size())
+        return false;
+
+    for(std::size_t i{ 0 }; i < m_transientDescs.size(); ++i)
+    {
+        const auto& existing{ m_transientImages[i] };
+        const auto& desc{ m_transientDescs[i] };
+
+        if(existing.desc.extent.width != desc.extent.width || existing.desc.extent.height != desc.extent.height
+           || existing.desc.format != desc.format || existing.desc.usage != desc.usage
+           || existing.desc.aspectMask != desc.aspectMask)
+            return false;
+    }
+
+    for(std::size_t i{ 0 }; i < m_resources.size(); ++i)
+    {
+        const std::uint32_t transient{ m_resources[i].transient };
+        if(transient == NO_TRANSIENT)
+            continue;
+
+        const auto& existing{ m_transientImages[transient].lifetime };
+        const auto& lifetime{ m_plan.lifetimes[i] };
+        if(existing.firstPass != lifetime.firstPass || existing.lastPass != lifetime.lastPass)
+            return false;
+    }
+
+    return true;
+}
+
+/// \brief Create every used transient image and bind the images that are never alive at the same time to the same
+/// memory
+void RenderGraph::createTransientImages()
+{
+    destroyTransientImages();
+    m_transientImages.resize(m_transientDescs.size());
+
+    std::vector<std::uint32_t> used;
+    std::vector<RenderGraphLifetime> lifetimes;
+    std::vector<VkMemoryRequirements> requirements;
+
+    for(std::size_t i{ 0 }; i < m_resources.size(); ++i)
+    {
+        const std::uint32_t transient{ m_resources[i].transient };
+        if(transient == NO_TRANSIENT)
+            continue;
+
+        auto& image{ m_transientImages[transient] };
+        image.desc = m_transientDescs[transient];
+        image.lifetime = m_plan.lifetimes[i];
+
+        // NOTE: Images that are only used by culled passes are not created
+        if(!image.lifetime.isUsed())
+            continue;
+
+        VkImageCreateInfo imageCI{};
+        imageCI.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageCI.imageType = VK_IMAGE_TYPE_2D;
+        imageCI.format = image.desc.format;
+        imageCI.extent = { .width = image.desc.extent.width, .height = image.desc.extent.height, .depth = 1 };
+        imageCI.mipLevels = 1;
+        imageCI.arrayLayers = 1;
+        imageCI.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageCI.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageCI.usage = image.desc.usage;
+        imageCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageCI.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        const VkResult result{ vkCreateImage(device->device(), &imageCI, nullptr, &image.image) };
+        if(result != VK_SUCCESS)
+            throw VulkanException("Failed to create transient render graph image", result);
+
+        VkMemoryRequirements imageRequirements{};
+        vkGetImageMemoryRequirements(device->device(), image.image, &imageRequirements);
+
+        used.push_back(transient);
+        lifetimes.push_back(image.lifetime);
+        requirements.push_back(imageRequirements);
+    }
+
+    const std::vector<RenderGraphAliasSlot> slots{ assignAliasSlots(lifetimes, requirements) };
+    m_memorySlots.resize(slots.size());
+
+    for(std::size_t slot{ 0 }; slot < slots.size(); ++slot)
+    {
+        VmaAllocationCreateInfo allocInfo{};
+        allocInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+        VkResult result{ vmaAllocateMemory(
+            device->allocator(), &slots[slot].requirements, &allocInfo, &m_memorySlots[slot].allocation, nullptr
+        ) };
+        if(result != VK_SUCCESS)
+            throw VulkanException("Failed to allocate transient render graph memory", result);
+
+        m_transientMemorySize += slots[slot].requirements.size;
+
+        for(const std::uint32_t resource : slots[slot].resources)
+        {
+            auto& image{ m_transientImages[used[resource]] };
+            image.slot = static_cast<std::uint32_t>(slot);
+
+            result = vmaBindImageMemory(device->allocator(), m_memorySlots[slot].allocation, image.image);
+            if(result != VK_SUCCESS)
+                throw VulkanException("Failed to bind transient render graph image", result);
+
+            VkImageViewCreateInfo viewCI{};
+            viewCI.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            viewCI.image = image.image;
+            viewCI.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            viewCI.format = image.desc.format;
+            viewCI.subresourceRange = { .aspectMask = image.desc.aspectMask,
+                                        .baseMipLevel = 0,
+                                        .levelCount = 1,
+                                        .baseArrayLayer = 0,
+                                        .layerCount = 1 };
+
+            result = vkCreateImageView(device->device(), &viewCI, nullptr, &image.view);
+            if(result != VK_SUCCESS)
+                throw VulkanException("Failed to create transient render graph image view", result);
+        }
+    }
+}
+
+/// \brief Destroy every transient image and free their memory once the frames in flight are done with them
+void RenderGraph::destroyTransientImages()
+{
+    m_transientMemorySize = 0;
+    if(m_transientImages.empty() && m_memorySlots.empty())
+        return;
+
+    device->destroyLater([vkDevice = device->device(),
+                          allocator = device->allocator(),
+                          images = std::move(m_transientImages),
+                          slots = std::move(m_memorySlots)]() {
+        for(const auto& image : images)
+        {
+            if(image.view != VK_NULL_HANDLE)
+                vkDestroyImageView(vkDevice, image.view, nullptr);
+            if(image.image != VK_NULL_HANDLE)
+                vkDestroyImage(vkDevice, image.image, nullptr);
+        }
+
+        for(const auto& slot : slots)
+            vmaFreeMemory(allocator, slot.allocation);
+    });
+    m_transientImages.clear();
+    m_memorySlots.clear();
+}
+
+/// \brief Record the barriers of an executed pass as a single pipeline barrier
+///
+/// Buffers are synchronized with one global memory barrier, images with an image barrier each
+///
+/// \param commandBuffer the command buffer of the current frame
+/// \param position index of the pass among the executed passes
+void RenderGraph::recordBarriers(VkCommandBuffer commandBuffer, std::size_t position)
+{
+    const auto& barriers{ m_plan.barriers[position] };
+    if(barriers.empty())
+        return;
+
+    VkPipelineStageFlags srcStages{ 0 };
+    VkPipelineStageFlags dstStages{ 0 };
+    VkMemoryBarrier memoryBarrier{};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    bool hasMemoryBarrier{ false };
+    m_imageBarriers.clear();
+
+    for(const auto& barrier : barriers)
+    {
+        const auto& resource{ m_resources[barrier.resource] };
+        VkPipelineStageFlags stages{ barrier.srcStages };
+
+        // NOTE: The first use of a transient image also waits for the images that used its memory before
+        if(resource.transient != NO_TRANSIENT)
+        {
+            const auto& image{ m_transientImages[resource.transient] };
+            if(image.lifetime.firstPass == position)
+                stages |= m_memorySlots[image.slot].stages;
+        }
+
+        srcStages |= stages;
+        dstStages |= barrier.dstStages;
+
+        if(!m_resourceInfos[barrier.resource].image)
+        {
+            memoryBarrier.srcAccessMask |= barrier.srcAccessMask;
+            memoryBarrier.dstAccessMask |= barrier.dstAccessMask;
+            hasMemoryBarrier = true;
+            continue;
+        }
+
+        VkImageMemoryBarrier imageBarrier{};
+        imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        imageBarrier.srcAccessMask = barrier.srcAccessMask;
+        imageBarrier.dstAccessMask = barrier.dstAccessMask;
+        imageBarrier.oldLayout = barrier.oldLayout;
+        imageBarrier.newLayout = barrier.newLayout;
+        imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.image = resource.transient != NO_TRANSIENT ? m_transientImages[resource.transient].image
+                                                                : resource.image;
+        imageBarrier.subresourceRange = resource.range;
+        m_imageBarriers.push_back(imageBarrier);
+    }
+
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        srcStages,
+        dstStages,
+        0,
+        hasMemoryBarrier ? 1 : 0,
+        &memoryBarrier,
+        0,
+        nullptr,
+        static_cast<std::uint32_t>(m_imageBarriers.size()),
+        m_imageBarriers.data()
+    );
+}
+
+} // namespace vv
@@ -0,0 +1,225 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_CORE_RENDER_GRAPH_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_CORE_RENDER_GRAPH_HPP
+
+#include "core/Device.hpp"
+#include "utility/RenderGraphCompiler.hpp"
+
+#include "vk_mem_alloc.h"
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vv
+{
+
+/// \brief Handle of an image in a \ref RenderGraph, only valid until the graph is reset
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct RenderGraphImage
+{
+    std::uint32_t index{ 0 };
+};
+
+/// \brief Handle of a buffer in a \ref RenderGraph, only valid until the graph is reset
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct RenderGraphBuffer
+{
+    std::uint32_t index{ 0 };
+};
+
+/// \brief Description of an image that is created and owned by a \ref RenderGraph
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct RenderGraphImageDesc
+{
+    VkExtent2D extent{ .width = 0, .height = 0 };
+    VkFormat format{ VK_FORMAT_UNDEFINED };
+    VkImageUsageFlags usage{ 0 };
+    VkImageAspectFlags aspectMask{ VK_IMAGE_ASPECT_COLOR_BIT };
+};
+
+/// \brief Frame graph that orders the GPU work of a frame and synchronizes it
+///
+/// Every frame the passes are declared again together with the images and buffers that they read and write. When
+/// the graph is compiled, passes whose results are never used are culled and the barriers between the remaining
+/// passes are derived from the declared accesses, including the image layout transitions. The passes only record
+/// their own commands and need no barriers against other passes.
+///
+/// Resources either live outside of the graph and are imported, or they are transient images that only exist while
+/// the graph runs. Transient images persist between frames as long as the declarations do not change. Transient
+/// images that are never alive at the same time share the same VMA allocation. Sharing memory between frames in
+/// flight is safe because the first barrier of an image waits for every earlier use of its memory on the queue.
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+class RenderGraph
+{
+public:
+    using ExecuteFunction = std::function<void(VkCommandBuffer)>;
+
+    /// \brief Declares the resources of a pass that was added with \ref addPass
+    ///
+    /// \author Felix Hommel
+    /// \date 10/18/2026
+    class PassBuilder
+    {
+    public:
+        PassBuilder& read(RenderGraphImage image, const RenderGraphAccess& access);
+        PassBuilder& read(RenderGraphBuffer buffer, const RenderGraphAccess& access);
+        PassBuilder& write(RenderGraphImage image, const RenderGraphAccess& access);
+        PassBuilder& write(RenderGraphBuffer buffer, const RenderGraphAccess& access);
+        /// \brief Keep the pass even if nothing in the graph uses what it writes, e.g., because it presents
+        PassBuilder& setSideEffects();
+
+    private:
+        friend class RenderGraph;
+
+        RenderGraph& m_graph;
+        std::size_t m_pass;
+
+        PassBuilder(RenderGraph& graph, std::size_t pass)
+            : m_graph{ graph }
+            , m_pass{ pass }
+        {}
+
+        PassBuilder& use(std::uint32_t resource, RenderGraphAccess access, bool write);
+    };
+
+    /// \brief Create a new empty \ref RenderGraph
+    ///
+    /// \param device the \ref Device on which the transient images are created
+    explicit RenderGraph(std::shared_ptr<Device> device);
+    ~RenderGraph();
+
+    RenderGraph(const RenderGraph&) = delete;
+    RenderGraph(RenderGraph&&) = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+    RenderGraph& operator=(RenderGraph&&) = delete;
+
+    [[nodiscard]] std::size_t getPassCount() const noexcept { return m_passes.size(); }
+    /// \brief Amount of passes that survived culling in the last compilation
+    [[nodiscard]] std::size_t getExecutedPassCount() const noexcept { return m_plan.passes.size(); }
+    /// \brief Amount of buffer and image dependencies that the last compilation produced
+    [[nodiscard]] std::size_t getBarrierCount() const noexcept;
+    /// \brief Size of the memory that backs all transient images (in byte)
+    [[nodiscard]] VkDeviceSize getTransientMemorySize() const noexcept { return m_transientMemorySize; }
+    /// \brief The transient image behind a handle, only valid after \ref compile
+    [[nodiscard]] VkImage getImage(RenderGraphImage image) const;
+    /// \brief View of the whole transient image behind a handle, only valid after \ref compile
+    [[nodiscard]] VkImageView getImageView(RenderGraphImage image) const;
+
+    /// \brief Remove every pass and resource to declare the next frame. Transient images are kept for reuse
+    void reset();
+    /// \brief Add an image that is owned by someone else
+    ///
+    /// \param image the image
+    /// \param range the subresources that the passes use
+    /// \param initialAccess the last access to the image before the graph, a default access if it has no content
+    ///
+    /// \returns the handle of the image in the graph
+    RenderGraphImage importImage(
+        VkImage image, const VkImageSubresourceRange& range, const RenderGraphAccess& initialAccess = {}
+    );
+    /// \brief Add a buffer that is owned by someone else
+    ///
+    /// \param buffer the buffer
+    /// \param initialAccess the last access to the buffer before the graph, a default access if it has no content
+    ///
+    /// \returns the handle of the buffer in the graph
+    RenderGraphBuffer importBuffer(VkBuffer buffer, const RenderGraphAccess& initialAccess = {});
+    /// \brief Add an image that only lives while the graph runs. Its content is undefined at its first use
+    ///
+    /// \param desc the description of the image, the usage has to cover every access of the passes
+    ///
+    /// \returns the handle of the image in the graph
+    RenderGraphImage createImage(const RenderGraphImageDesc& desc);
+    /// \brief Add a pass, the passes run in the order in which they are added
+    ///
+    /// \param name the name of the pass
+    /// \param execute records the commands of the pass
+    ///
+    /// \returns the builder that declares the resources of the pass
+    PassBuilder addPass(std::string name, ExecuteFunction execute);
+    /// \brief Cull the passes, compute the barriers and create the transient images that are needed
+    ///
+    /// \note Replaced transient images are destroyed once the frames in flight that use them have finished
+    void compile();
+    /// \brief Record every pass that survived culling together with its barriers
+    ///
+    /// Has to be recorded outside of a render pass, after \ref compile
+    ///
+    /// \param commandBuffer the command buffer of the current frame
+    void execute(VkCommandBuffer commandBuffer);
+
+private:
+    static constexpr std::uint32_t NO_TRANSIENT{ std::numeric_limits<std::uint32_t>::max() };
+
+    /// \brief The Vulkan objects behind a resource
+    struct Resource
+    {
+        VkImage image{ VK_NULL_HANDLE };
+        VkBuffer buffer{ VK_NULL_HANDLE };
+        VkImageSubresourceRange range{};
+        std::uint32_t transient{ NO_TRANSIENT }; ///< Index into the transient images if the graph owns the image
+    };
+
+    /// \brief A declared pass
+    struct Pass
+    {
+        std::string name;
+        ExecuteFunction execute;
+    };
+
+    /// \brief A transient image together with the declaration it was created for
+    struct TransientImage
+    {
+        RenderGraphImageDesc desc{};
+        RenderGraphLifetime lifetime{};
+        VkImage image{ VK_NULL_HANDLE };
+        VkImageView view{ VK_NULL_HANDLE };
+        std::uint32_t slot{ 0 };
+    };
+
+    /// \brief Memory that is shared by transient images whose lifetimes do not overlap
+    struct MemorySlot
+    {
+        VmaAllocation allocation{ VK_NULL_HANDLE };
+        VkPipelineStageFlags stages{ 0 }; ///< Every stage that used the memory so far
+    };
+
+    std::shared_ptr<Device> device;
+
+    std::vector<Resource> m_resources;
+    std::vector<RenderGraphResourceInfo> m_resourceInfos;
+    std::vector<Pass> m_passes;
+    std::vector<RenderGraphPassInfo> m_passInfos;
+    std::vector<RenderGraphImageDesc> m_transientDescs;
+
+    RenderGraphPlan m_plan;
+    bool m_compiled{ false };
+
+    std::vector<TransientImage> m_transientImages;
+    std::vector<MemorySlot> m_memorySlots;
+    VkDeviceSize m_transientMemorySize{ 0 };
+
+    std::vector<VkImageMemoryBarrier> m_imageBarriers; ///< Reused between passes to avoid allocations
+
+    [[nodiscard]] bool transientImagesMatch() const;
+    void createTransientImages();
+    void destroyTransientImages();
+    void recordBarriers(VkCommandBuffer commandBuffer, std::size_t position);
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_CORE_RENDER_GRAPH_HPP
@@ -1,7 +1,12 @@
 #include "Renderer.hpp"
 
+#include "core/CommandPoolRing.hpp"
+#include "core/DescriptorAllocator.hpp"
 #include "core/Device.hpp"
+#include "core/GpuTimer.hpp"
+#include "core/PipelineStatistics.hpp"
 #include "core/Swapchain.hpp"
+#include "core/UploadManager.hpp"
 #include "core/Window.hpp"
 #include "utility/exceptions/VulkanException.hpp"
 
@@ -13,23 +18,45 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <utility>
 #include <vector>
 
 namespace vv
 {
 
-Renderer::Renderer(std::shared_ptr<Window> window, std::shared_ptr<Device> device)
-    : window{ std::move(window) }, device{ std::move(device) }
+Renderer::Renderer(
+    std::shared_ptr<Window> window,
+    std::shared_ptr<Device> device,
+    std::uint32_t framesInFlight,
+    std::size_t recordingThreads
+)
+    : window{ std::move(window) }
+    , device{ std::move(device) }
+    , m_framesInFlight{ framesInFlight }
+    , m_commandBuffers(framesInFlight)
+    , m_frameTimelineValues(framesInFlight, 0)
 {
+#if defined(VV_ENABLE_ASSERTS)
+    assert(
+        framesInFlight > 0 && framesInFlight <= Swapchain::MAX_FRAMES_IN_FLIGHT
+        && "Frames in flight out of the valid range"
+    );
+#endif
+
     recreateSwapchain();
-    createCommandBuffers();
+    m_gpuTimer = std::make_unique<GpuTimer>(this->device, m_framesInFlight);
+    m_pipelineStatistics = std::make_unique<PipelineStatistics>(this->device, m_framesInFlight);
+    m_commandPools = std::make_unique<CommandPoolRing>(this->device, m_framesInFlight, recordingThreads);
+
+    m_frameDescriptorAllocators.reserve(m_framesInFlight);
+    for(std::uint32_t i{ 0 }; i < m_framesInFlight; ++i)
+        m_frameDescriptorAllocators.push_back(
+            std::make_unique<DescriptorAllocator>(this->device, FRAME_DESCRIPTOR_SETS, FRAME_SET_RATIOS)
+        );
 }
 
-Renderer::~Renderer()
-{
-    freeCommandBuffers();
-}
+Renderer::~Renderer() = default;
 
 VkCommandBuffer Renderer::getCurrentCommandBuffer() const
 {
@@ -49,12 +76,30 @@ std::size_t Renderer::getFrameIndex() const
     return m_currentFrameIndex;
 }
 
+DescriptorAllocator& Renderer::getFrameDescriptorAllocator() const
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(m_isFrameStarted && "Cannot get the frame descriptor allocator when no frame is in progress");
+#endif
+
+    return *m_frameDescriptorAllocators[m_currentFrameIndex];
+}
+
 VkCommandBuffer Renderer::beginFrame()
 {
 #if defined(VV_ENABLE_ASSERTS)
     assert(!m_isFrameStarted && "Cannot call beginFrame() while a frame is already in progress");
 #endif
 
+    // NOTE: Uploads since the last frame are submitted as one batch ahead of the frame that uses them
+    device->uploadManager().flush();
+
+    // NOTE: Everything the frame used last time (command buffers, queries, per frame buffers, descriptor sets) is
+    // free afterwards
+    device->waitForGraphicsValue(m_frameTimelineValues[m_currentFrameIndex]);
+    device->collectDeletions();
+    m_frameDescriptorAllocators[m_currentFrameIndex]->reset();
+
     VkResult result{ m_swapchain->acquireNextImage(&m_currentImageIndex) };
     if(result == VK_ERROR_OUT_OF_DATE_KHR)
     {
@@ -67,14 +112,22 @@ VkCommandBuffer Renderer::beginFrame()
 
     m_isFrameStarted = true;
 
+    m_commandPools->reset(m_currentFrameIndex);
+    m_commandBuffers[m_currentFrameIndex]
+        = m_commandPools->allocate(m_currentFrameIndex, 0, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
     auto* const commandBuffer{ getCurrentCommandBuffer() };
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
     result = vkBeginCommandBuffer(commandBuffer, &beginInfo);
     if(result != VK_SUCCESS)
         throw VulkanException("Failed to begin recording command buffer", result);
 
+    m_gpuTimer->beginFrame(commandBuffer, m_currentFrameIndex);
+    m_pipelineStatistics->beginFrame(commandBuffer, m_currentFrameIndex);
+
     return commandBuffer;
 }
 
@@ -93,6 +146,7 @@ void Renderer::endFrame()
     }
 
     result = m_swapchain->submitCommandBuffer(&commandBuffer, &m_currentImageIndex);
+    m_frameTimelineValues[m_currentFrameIndex] = device->submittedGraphicsValue();
     if(result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || window->wasWindowResized())
     {
         window->resetWindowResizeFlag();
@@ -102,10 +156,10 @@ void Renderer::endFrame()
         throw VulkanException("Failed to present swapchain image", result);
 
     m_isFrameStarted = false;
-    m_currentFrameIndex = (m_currentFrameIndex + 1) % Swapchain::MAX_FRAMES_IN_FLIGHT;
+    m_currentFrameIndex = (m_currentFrameIndex + 1) % m_framesInFlight;
 }
 
-void Renderer::beginRenderPass(VkCommandBuffer commandBuffer) const
+void Renderer::beginRenderPass(VkCommandBuffer commandBuffer, VkSubpassContents contents) const
 {
 #if defined(VV_ENABLE_ASSERTS)
     assert(m_isFrameStarted && "Cannot call beginRenderPass() while there is no frame in progress");
@@ -130,22 +184,11 @@ void Renderer::beginRenderPass(VkCommandBuffer commandBuffer) const
     renderPassBeginInfo.clearValueCount = static_cast<std::uint32_t>(clearValues.size());
     renderPassBeginInfo.pClearValues = clearValues.data();
 
-    vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+    vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, contents);
 
-    const VkViewport viewport{ .x = 0.f,
-                               .y = 0.f,
-                               .width = static_cast<float>(m_swapchain->getExtent().width),
-                               .height = static_cast<float>(m_swapchain->getExtent().height),
-                               .minDepth = 0.f,
-                               .maxDepth = 1.f };
-
-    const VkRect2D scissor{
-        .offset = { .x = 0, .y = 0 },
-          .extent = m_swapchain->getExtent()
-    };
-
-    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
-    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+    // NOTE: Only vkCmdExecuteCommands may be recorded into a render pass that uses secondary command buffers
+    if(contents == VK_SUBPASS_CONTENTS_INLINE)
+        setViewportAndScissor(commandBuffer);
 }
 
 void Renderer::endRenderPass(VkCommandBuffer commandBuffer) const
@@ -160,32 +203,84 @@ void Renderer::endRenderPass(VkCommandBuffer commandBuffer) const
     vkCmdEndRenderPass(commandBuffer);
 }
 
-/// \brief Create as many command buffers as the amount of images that can be parallely in flight (supported by the swapchain)
-void Renderer::createCommandBuffers()
+VkCommandBuffer Renderer::beginSecondaryCommandBuffer(std::size_t thread)
 {
-    m_commandBuffers.resize(Swapchain::MAX_FRAMES_IN_FLIGHT);
+#if defined(VV_ENABLE_ASSERTS)
+    assert(m_isFrameStarted && "Cannot begin a secondary command buffer while there is no frame in progress");
+    assert(thread < getRecordingThreadCount() && "Thread index exceeds the recording thread count");
+#endif
+
+    auto* const commandBuffer{
+        m_commandPools->allocate(m_currentFrameIndex, thread, VK_COMMAND_BUFFER_LEVEL_SECONDARY)
+    };
 
-    VkCommandBufferAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.commandPool = device->commandPool();
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandBufferCount = static_cast<std::uint32_t>(m_commandBuffers.size());
+    VkCommandBufferInheritanceInfo inheritanceInfo{};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.renderPass = m_swapchain->getRenderPass();
+    inheritanceInfo.subpass = 0;
+    inheritanceInfo.framebuffer = m_swapchain->getFramebuffer(m_currentImageIndex);
 
-    const VkResult result{ vkAllocateCommandBuffers(device->device(), &allocInfo, m_commandBuffers.data()) };
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    const VkResult result{ vkBeginCommandBuffer(commandBuffer, &beginInfo) };
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to begin recording secondary command buffer", result);
+
+    // NOTE: Secondary command buffers do not inherit dynamic state from the primary command buffer
+    setViewportAndScissor(commandBuffer);
+
+    return commandBuffer;
+}
+
+void Renderer::endSecondaryCommandBuffer(VkCommandBuffer commandBuffer) const
+{
+    const VkResult result{ vkEndCommandBuffer(commandBuffer) };
     if(result != VK_SUCCESS)
-        throw VulkanException("Failed to allocate command buffers", result);
+        throw VulkanException("Failed to record secondary command buffer", result);
 }
 
-/// \brief Free the allocated command buffers
-void Renderer::freeCommandBuffers()
+void Renderer::executeSecondaryCommandBuffers(
+    VkCommandBuffer commandBuffer, std::span<const VkCommandBuffer> secondaryCommandBuffers
+) const
 {
-    vkFreeCommandBuffers(
-        device->device(),
-        device->commandPool(),
-        static_cast<std::uint32_t>(m_commandBuffers.size()),
-        m_commandBuffers.data()
+#if defined(VV_ENABLE_ASSERTS)
+    assert(m_isFrameStarted && "Cannot execute secondary command buffers while there is no frame in progress");
+    assert(
+        commandBuffer == getCurrentCommandBuffer()
+        && "Cannot execute secondary command buffers on command buffer from a different frame"
     );
-    m_commandBuffers.clear();
+#endif
+
+    if(secondaryCommandBuffers.empty())
+        return;
+
+    vkCmdExecuteCommands(
+        commandBuffer, static_cast<std::uint32_t>(secondaryCommandBuffers.size()), secondaryCommandBuffers.data()
+    );
+}
+
+/// \brief Set the viewport and scissor to cover the whole swapchain image
+///
+/// \param commandBuffer the command buffer that records draws into the render pass
+void Renderer::setViewportAndScissor(VkCommandBuffer commandBuffer) const
+{
+    const VkViewport viewport{ .x = 0.f,
+                               .y = 0.f,
+                               .width = static_cast<float>(m_swapchain->getExtent().width),
+                               .height = static_cast<float>(m_swapchain->getExtent().height),
+                               .minDepth = 0.f,
+                               .maxDepth = 1.f };
+
+    const VkRect2D scissor{
+        .offset = { .x = 0, .y = 0 },
+          .extent = m_swapchain->getExtent()
+    };
+
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 }
 
 /// \brief Recreate the swapchain
@@ -203,11 +298,11 @@ void Renderer::recreateSwapchain()
     vkDeviceWaitIdle(device->device());
 
     if(m_swapchain == nullptr)
-        m_swapchain = std::make_unique<Swapchain>(device, extent);
+        m_swapchain = std::make_unique<Swapchain>(device, extent, m_framesInFlight);
     else
     {
         std::shared_ptr<Swapchain> oldSwapchain{ std::move(m_swapchain) };
-        m_swapchain = std::make_unique<Swapchain>(device, extent, oldSwapchain);
+        m_swapchain = std::make_unique<Swapchain>(device, extent, m_framesInFlight, oldSwapchain);
 
         if(!oldSwapchain->compareSwapFormats(*m_swapchain))
             throw VulkanException("Swapchain image or depth format has changed", VK_ERROR_OUT_OF_DATE_KHR);
@@ -1,15 +1,21 @@
 #ifndef VULKAN_VOXELS_SRC_ENGINE_CORE_RENDERER_HPP
 #define VULKAN_VOXELS_SRC_ENGINE_CORE_RENDERER_HPP
 
+#include "CommandPoolRing.hpp"
+#include "DescriptorAllocator.hpp"
 #include "Device.hpp"
+#include "GpuTimer.hpp"
+#include "PipelineStatistics.hpp"
 #include "Swapchain.hpp"
 #include "Window.hpp"
 
 #include <vulkan/vulkan_core.h>
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <vector>
 
 namespace vv
@@ -20,6 +26,14 @@ namespace vv
 /// It manages synchronization between frame buffers on a user level and manages
 /// the beginning of frames and render passes as well as the ending of frames and render passes
 ///
+/// The command buffers of a frame come from a \ref CommandPoolRing that is reset when the frame begins again. Every
+/// recording thread has its own pools for secondary command buffers, so threads can record the render pass in
+/// parallel without any synchronization between them.
+///
+/// A frame is reused once the graphics timeline of the \ref Device has reached the value of its last submission.
+/// Descriptor sets that are only needed for a single frame come from a \ref DescriptorAllocator per frame in flight,
+/// which is reset at the same point.
+///
 /// \author Felix Hommel
 /// \date 11/19/2025
 class Renderer
@@ -29,7 +43,15 @@ public:
     ///
     /// \param window the \ref Window that is rendered to
     /// \param device the \ref Device that is used
-    Renderer(std::shared_ptr<Window> window, std::shared_ptr<Device> device);
+    /// \param framesInFlight how many frames the CPU may record ahead of the GPU. 1 gives the lowest latency, more
+    /// frames give a higher throughput
+    /// \param recordingThreads how many threads record secondary command buffers in parallel
+    Renderer(
+        std::shared_ptr<Window> window,
+        std::shared_ptr<Device> device,
+        std::uint32_t framesInFlight = Swapchain::DEFAULT_FRAMES_IN_FLIGHT,
+        std::size_t recordingThreads = 1
+    );
     ~Renderer();
 
     Renderer(const Renderer&) = delete;
@@ -39,9 +61,22 @@ public:
 
     [[nodiscard]] VkRenderPass getRenderPass() const noexcept { return m_swapchain->getRenderPass(); }
     [[nodiscard]] float getAspectRatio() const noexcept { return m_swapchain->extentAspectRatio(); }
+    [[nodiscard]] VkExtent2D getSwapchainExtent() const { return m_swapchain->getExtent(); }
     [[nodiscard]] bool isFrameStarted() const noexcept { return m_isFrameStarted; }
     [[nodiscard]] VkCommandBuffer getCurrentCommandBuffer() const;
     [[nodiscard]] std::size_t getFrameIndex() const;
+    [[nodiscard]] std::uint32_t getFramesInFlight() const noexcept { return m_framesInFlight; }
+    [[nodiscard]] std::size_t getRecordingThreadCount() const noexcept { return m_commandPools->getThreadCount(); }
+    /// \brief The \ref DescriptorAllocator of the current frame, its sets are freed when the frame begins again
+    [[nodiscard]] DescriptorAllocator& getFrameDescriptorAllocator() const;
+    [[nodiscard]] GpuTimer& getGpuTimer() const noexcept { return *m_gpuTimer; }
+    [[nodiscard]] PipelineStatistics& getPipelineStatistics() const noexcept { return *m_pipelineStatistics; }
+    [[nodiscard]] VkFormat getDepthFormat() const noexcept { return m_swapchain->getDepthFormat(); }
+    [[nodiscard]] VkImage getCurrentDepthImage() const { return m_swapchain->getDepthImage(m_currentImageIndex); }
+    [[nodiscard]] VkImageView getCurrentDepthImageView() const
+    {
+        return m_swapchain->getDepthImageView(m_currentImageIndex);
+    }
 
     /// \brief Prepares the command buffer for the next frame
     ///
@@ -54,31 +89,66 @@ public:
     void endFrame();
     /// \brief Start a new render pass
     ///
-    /// Start a new Render pass and then configure the viewport and scissor
+    /// Start a new Render pass and then configure the viewport and scissor. If the render pass is recorded in
+    /// secondary command buffers, they set the viewport and scissor themselves
     ///
     /// \param commandBuffer currently used VkCommandBuffer
-    void beginRenderPass(VkCommandBuffer commandBuffer) const;
+    /// \param contents whether the render pass is recorded inline or in secondary command buffers
+    void beginRenderPass(VkCommandBuffer commandBuffer, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE) const;
     /// \brief End the current render pass
     ///
     /// \param commandBuffer currently used VkCommandBuffer
     void endRenderPass(VkCommandBuffer commandBuffer) const;
+    /// \brief Begin a secondary command buffer that continues the render pass started by \ref beginRenderPass
+    ///
+    /// The viewport and scissor are already set. The command buffer is only valid during the current frame. Can be
+    /// called from multiple threads at once as long as each of them uses its own thread index
+    ///
+    /// \param thread index of the recording thread, less than \ref getRecordingThreadCount
+    ///
+    /// \returns the secondary command buffer in the recording state
+    [[nodiscard]] VkCommandBuffer beginSecondaryCommandBuffer(std::size_t thread);
+    /// \brief Finish the recording of a secondary command buffer
+    ///
+    /// \param commandBuffer a command buffer from \ref beginSecondaryCommandBuffer
+    void endSecondaryCommandBuffer(VkCommandBuffer commandBuffer) const;
+    /// \brief Execute secondary command buffers inside the render pass that was begun with
+    /// VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+    ///
+    /// \param commandBuffer currently used VkCommandBuffer
+    /// \param secondaryCommandBuffers the finished secondary command buffers, in the order in which they execute
+    void executeSecondaryCommandBuffers(
+        VkCommandBuffer commandBuffer, std::span<const VkCommandBuffer> secondaryCommandBuffers
+    ) const;
 
 private:
     static constexpr VkClearColorValue CLEAR_COLOR{
         { 0.1f, 0.1f, 0.1f, 1.f }
     };
+    static constexpr std::uint32_t FRAME_DESCRIPTOR_SETS{ 16 };
+    static constexpr std::array<PoolSizeRatio, 4> FRAME_SET_RATIOS{
+        { { .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .ratio = 1.f },
+          { .type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, .ratio = 1.f },
+          { .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, .ratio = 1.f },
+          { .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .ratio = 1.f } }
+    };
 
     std::shared_ptr<Window> window;
     std::shared_ptr<Device> device;
     std::unique_ptr<Swapchain> m_swapchain;
-    std::vector<VkCommandBuffer> m_commandBuffers;
+    std::unique_ptr<GpuTimer> m_gpuTimer;
+    std::unique_ptr<PipelineStatistics> m_pipelineStatistics;
+    std::unique_ptr<CommandPoolRing> m_commandPools;
+    std::vector<std::unique_ptr<DescriptorAllocator>> m_frameDescriptorAllocators; ///< One per frame in flight
+    std::uint32_t m_framesInFlight;
+    std::vector<VkCommandBuffer> m_commandBuffers; ///< The primary command buffer of each frame in flight
+    std::vector<std::uint64_t> m_frameTimelineValues; ///< Graphics timeline value of the last submit of each frame
 
     std::uint32_t m_currentImageIndex{};
     std::size_t m_currentFrameIndex{ 0 };
     bool m_isFrameStarted{ false };
 
-    void createCommandBuffers();
-    void freeCommandBuffers();
+    void setViewportAndScissor(VkCommandBuffer commandBuffer) const;
     void recreateSwapchain();
 };
 
@@ -0,0 +1,93 @@
+#include "SamplerCache.hpp"
+
+#include "core/Device.hpp"
+#include "utility/Utils.hpp"
+#include "utility/exceptions/VulkanException.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cassert>
+#include <cstddef>
+#include <mutex>
+
+namespace vv
+{
+
+SamplerCache::SamplerCache(Device& device) : device{ device } {}
+
+SamplerCache::~SamplerCache()
+{
+    for(const auto& [key, sampler] : m_samplers)
+        vkDestroySampler(device.device(), sampler, nullptr);
+}
+
+std::size_t SamplerCache::size() const
+{
+    const std::scoped_lock lock{ m_mutex };
+    return m_samplers.size();
+}
+
+VkSampler SamplerCache::getSampler(const VkSamplerCreateInfo& createInfo)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(createInfo.pNext == nullptr && "Extended sampler state is not part of the cache key");
+#endif
+
+    const SamplerKey key{ .flags = createInfo.flags,
+                          .magFilter = createInfo.magFilter,
+                          .minFilter = createInfo.minFilter,
+                          .mipmapMode = createInfo.mipmapMode,
+                          .addressModeU = createInfo.addressModeU,
+                          .addressModeV = createInfo.addressModeV,
+                          .addressModeW = createInfo.addressModeW,
+                          .mipLodBias = createInfo.mipLodBias,
+                          .anisotropyEnable = createInfo.anisotropyEnable,
+                          .maxAnisotropy = createInfo.maxAnisotropy,
+                          .compareEnable = createInfo.compareEnable,
+                          .compareOp = createInfo.compareOp,
+                          .minLod = createInfo.minLod,
+                          .maxLod = createInfo.maxLod,
+                          .borderColor = createInfo.borderColor,
+                          .unnormalizedCoordinates = createInfo.unnormalizedCoordinates };
+
+    const std::scoped_lock lock{ m_mutex };
+    if(const auto it{ m_samplers.find(key) }; it != m_samplers.end())
+        return it->second;
+
+    VkSampler sampler{ VK_NULL_HANDLE };
+    const VkResult result{ vkCreateSampler(device.device(), &createInfo, nullptr, &sampler) };
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to create sampler", result);
+
+    m_samplers.emplace(key, sampler);
+
+    return sampler;
+}
+
+std::size_t SamplerCache::SamplerKeyHash::operator()(const SamplerKey& key) const
+{
+    std::size_t seed{ 0 };
+    hashCombine(
+        seed,
+        key.flags,
+        key.magFilter,
+        key.minFilter,
+        key.mipmapMode,
+        key.addressModeU,
+        key.addressModeV,
+        key.addressModeW,
+        key.mipLodBias,
+        key.anisotropyEnable,
+        key.maxAnisotropy,
+        key.compareEnable,
+        key.compareOp,
+        key.minLod,
+        key.maxLod,
+        key.borderColor,
+        key.unnormalizedCoordinates
+    );
+
+    return seed;
+}
+
+} // namespace vv
@@ -0,0 +1,84 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_CORE_SAMPLER_CACHE_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_CORE_SAMPLER_CACHE_HPP
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+
+namespace vv
+{
+
+class Device;
+
+/// \brief Shares one VkSampler between everything that samples with the same state
+///
+/// Drivers limit how many samplers can exist at a time, often to 4000, while most textures use one of a few presets.
+/// Samplers are created on first use and live as long as the \ref Device. Only the sampler state is part of the key,
+/// so samplers must not depend on the image, i.e., maxLod should be VK_LOD_CLAMP_NONE instead of the mip count.
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+class SamplerCache
+{
+public:
+    /// \brief Create a new \ref SamplerCache
+    ///
+    /// \param device the \ref Device that owns the sampler cache
+    explicit SamplerCache(Device& device);
+    ~SamplerCache();
+
+    SamplerCache(const SamplerCache&) = delete;
+    SamplerCache(SamplerCache&&) = delete;
+    SamplerCache& operator=(const SamplerCache&) = delete;
+    SamplerCache& operator=(SamplerCache&&) = delete;
+
+    /// \brief How many distinct samplers have been created
+    [[nodiscard]] std::size_t size() const;
+
+    /// \brief Get the sampler with the state of the create info, creating it if it does not exist yet
+    ///
+    /// \param createInfo the sampler state, pNext has to be nullptr
+    ///
+    /// \returns the sampler, owned by the cache
+    [[nodiscard]] VkSampler getSampler(const VkSamplerCreateInfo& createInfo);
+
+private:
+    /// \brief The members of VkSamplerCreateInfo that make up the state of a sampler
+    struct SamplerKey
+    {
+        VkSamplerCreateFlags flags;
+        VkFilter magFilter;
+        VkFilter minFilter;
+        VkSamplerMipmapMode mipmapMode;
+        VkSamplerAddressMode addressModeU;
+        VkSamplerAddressMode addressModeV;
+        VkSamplerAddressMode addressModeW;
+        float mipLodBias;
+        VkBool32 anisotropyEnable;
+        float maxAnisotropy;
+        VkBool32 compareEnable;
+        VkCompareOp compareOp;
+        float minLod;
+        float maxLod;
+        VkBorderColor borderColor;
+        VkBool32 unnormalizedCoordinates;
+
+        bool operator==(const SamplerKey&) const = default;
+    };
+
+    struct SamplerKeyHash
+    {
+        std::size_t operator()(const SamplerKey& key) const;
+    };
+
+    Device& device;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<SamplerKey, VkSampler, SamplerKeyHash> m_samplers;
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_CORE_SAMPLER_CACHE_HPP
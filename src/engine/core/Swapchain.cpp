@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
@@ -19,8 +20,8 @@
 namespace vv
 {
 
-Swapchain::Swapchain(std::shared_ptr<Device> device, VkExtent2D windowExtent)
-    : device{ std::move(device) }, windowExtent(windowExtent)
+Swapchain::Swapchain(std::shared_ptr<Device> device, VkExtent2D windowExtent, std::uint32_t framesInFlight)
+    : device{ std::move(device) }, windowExtent(windowExtent), m_framesInFlight{ framesInFlight }
 {
     createSwapchain();
     createImageViews();
@@ -30,8 +31,16 @@ Swapchain::Swapchain(std::shared_ptr<Device> device, VkExtent2D windowExtent)
     createSyncObjects();
 }
 
-Swapchain::Swapchain(std::shared_ptr<Device> device, VkExtent2D windowExtent, std::shared_ptr<Swapchain> previous)
-    : device{ std::move(device) }, windowExtent(windowExtent), m_oldSwapchain{ std::move(previous) }
+Swapchain::Swapchain(
+    std::shared_ptr<Device> device,
+    VkExtent2D windowExtent,
+    std::uint32_t framesInFlight,
+    std::shared_ptr<Swapchain> previous
+)
+    : device{ std::move(device) }
+    , windowExtent(windowExtent)
+    , m_oldSwapchain{ std::move(previous) }
+    , m_framesInFlight{ framesInFlight }
 {
     createSwapchain();
     createImageViews();
@@ -71,18 +80,14 @@ Swapchain::~Swapchain()
         vkDestroySemaphore(device->device(), m_renderFinishedSemaphores[i], nullptr);
     }
 
-    for(std::size_t i{ 0 }; i < MAX_FRAMES_IN_FLIGHT; ++i)
-    {
-        vkDestroySemaphore(device->device(), m_imageAvailableSemaphores[i], nullptr);
-        vkDestroyFence(device->device(), m_inFlightFences[i], nullptr);
-    }
+    for(const auto& semaphore : m_imageAvailableSemaphores)
+        vkDestroySemaphore(device->device(), semaphore, nullptr);
 }
 
 VkResult Swapchain::acquireNextImage(std::uint32_t* imageIndex) const
 {
-    vkWaitForFences(
-        device->device(), 1, &m_inFlightFences[m_currentFrame], VK_TRUE, std::numeric_limits<std::uint64_t>::max()
-    );
+    // NOTE: The image available semaphore of the frame can only be reused once its last wait has executed
+    device->waitForGraphicsValue(m_frameTimelineValues[m_currentFrame]);
 
     return vkAcquireNextImageKHR(
         device->device(),
@@ -96,33 +101,18 @@ VkResult Swapchain::acquireNextImage(std::uint32_t* imageIndex) const
 
 VkResult Swapchain::submitCommandBuffer(const VkCommandBuffer* commandBuffer, const std::uint32_t* imageIndex)
 {
-    if(m_imagesInFlight[*imageIndex] != VK_NULL_HANDLE)
-        vkWaitForFences(
-            device->device(), 1, &m_imagesInFlight[*imageIndex], VK_TRUE, std::numeric_limits<std::uint64_t>::max()
-        );
+    device->waitForGraphicsValue(m_imageTimelineValues[*imageIndex]);
 
-    m_imagesInFlight[*imageIndex] = m_inFlightFences[m_currentFrame];
+    const std::uint64_t submitted{ device->submitGraphics(
+        *commandBuffer,
+        m_imageAvailableSemaphores[m_currentFrame],
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        m_renderFinishedSemaphores[*imageIndex]
+    ) };
+    m_frameTimelineValues[m_currentFrame] = submitted;
+    m_imageTimelineValues[*imageIndex] = submitted;
 
-    const std::array<VkSemaphore, 1> waitSemaphores{ m_imageAvailableSemaphores[m_currentFrame] };
-    constexpr std::array<VkPipelineStageFlags, 1> waitStages{ VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
     const std::array<VkSemaphore, 1> signalSemaphore{ m_renderFinishedSemaphores[*imageIndex] };
-
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.waitSemaphoreCount = static_cast<std::uint32_t>(waitSemaphores.size());
-    submitInfo.pWaitSemaphores = waitSemaphores.data();
-    submitInfo.pWaitDstStageMask = waitStages.data();
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = commandBuffer;
-    submitInfo.signalSemaphoreCount = static_cast<std::uint32_t>(signalSemaphore.size());
-    submitInfo.pSignalSemaphores = signalSemaphore.data();
-
-    vkResetFences(device->device(), 1, &m_inFlightFences[m_currentFrame]);
-
-    VkResult result{ vkQueueSubmit(device->graphicsQueue(), 1, &submitInfo, m_inFlightFences[m_currentFrame]) };
-    if(result != VK_SUCCESS)
-        throw VulkanException("Failed to submit command buffer", result);
-
     const std::array<VkSwapchainKHR, 1> swapchains{ m_swapchain };
 
     VkPresentInfoKHR presentInfo{};
@@ -133,9 +123,9 @@ VkResult Swapchain::submitCommandBuffer(const VkCommandBuffer* commandBuffer, co
     presentInfo.pSwapchains = swapchains.data();
     presentInfo.pImageIndices = imageIndex;
 
-    result = vkQueuePresentKHR(device->presentQueue(), &presentInfo);
+    const VkResult result{ vkQueuePresentKHR(device->presentQueue(), &presentInfo) };
 
-    m_currentFrame = (m_currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+    m_currentFrame = (m_currentFrame + 1) % m_framesInFlight;
 
     return result;
 }
@@ -148,6 +138,22 @@ VkFramebuffer Swapchain::getFramebuffer(const std::size_t index) const
     return m_swapchainFramebuffers[index];
 }
 
+VkImage Swapchain::getDepthImage(const std::size_t index) const
+{
+    if(index >= m_depthImages.size())
+        throw Exception("The element that was tried to access does not exist");
+
+    return m_depthImages[index];
+}
+
+VkImageView Swapchain::getDepthImageView(const std::size_t index) const
+{
+    if(index >= m_depthImageViews.size())
+        throw Exception("The element that was tried to access does not exist");
+
+    return m_depthImageViews[index];
+}
+
 bool Swapchain::compareSwapFormats(const Swapchain& swapchain) const noexcept
 {
     return swapchain.m_swapchainImageFormat == m_swapchainImageFormat
@@ -248,11 +254,12 @@ void Swapchain::createRenderPass()
     depthAttachment.format = findDepthFormat();
     depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
     depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    // NOTE: Depth is kept after the render pass so that later passes (i.e., the voxel raymarcher) can sample it
+    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
     depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
 
     VkAttachmentReference depthAttachmentRef{};
     depthAttachmentRef.attachment = 1;
@@ -281,13 +288,24 @@ void Swapchain::createRenderPass()
     VkSubpassDependency dependency{};
     dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
     dependency.dstSubpass = 0;
-    dependency.srcStageMask
-        = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+    // NOTE: The depth image may still be read by a compute shader of the frame that last used it (depth pyramid)
+    dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT
+                              | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
     dependency.dstStageMask
         = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
     dependency.srcAccessMask = 0;
     dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 
+    VkSubpassDependency depthReadDependency{};
+    depthReadDependency.srcSubpass = 0;
+    depthReadDependency.dstSubpass = VK_SUBPASS_EXTERNAL;
+    depthReadDependency.srcStageMask
+        = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    depthReadDependency.dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    depthReadDependency.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    depthReadDependency.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+    const std::array<VkSubpassDependency, 2> dependencies{ dependency, depthReadDependency };
     const std::array<VkAttachmentDescription, 2> attachments{ colorAttachment, depthAttachment };
     VkRenderPassCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
@@ -295,8 +313,8 @@ void Swapchain::createRenderPass()
     createInfo.pAttachments = attachments.data();
     createInfo.subpassCount = 1;
     createInfo.pSubpasses = &subpass;
-    createInfo.dependencyCount = 1;
-    createInfo.pDependencies = &dependency;
+    createInfo.dependencyCount = static_cast<std::uint32_t>(dependencies.size());
+    createInfo.pDependencies = dependencies.data();
 
     const VkResult result{ vkCreateRenderPass(device->device(), &createInfo, nullptr, &m_renderPass) };
     if(result != VK_SUCCESS)
@@ -327,7 +345,7 @@ void Swapchain::createDepthResources()
         imageCreateInfo.arrayLayers = 1;
         imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
         imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-        imageCreateInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+        imageCreateInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
         imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
         imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
@@ -384,22 +402,24 @@ void Swapchain::createFramebuffers()
 }
 
 /**
- *  Set up the semaphores and fences used during the presentation of frames.
+ *  Set up the semaphores used during the presentation of frames.
  */
 void Swapchain::createSyncObjects()
 {
-    m_imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
+#if defined(VV_ENABLE_ASSERTS)
+    assert(
+        m_framesInFlight > 0 && m_framesInFlight <= MAX_FRAMES_IN_FLIGHT && "Frames in flight out of the valid range"
+    );
+#endif
+
+    m_imageAvailableSemaphores.resize(m_framesInFlight);
     m_renderFinishedSemaphores.resize(imageCount());
-    m_inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
-    m_imagesInFlight.resize(imageCount(), VK_NULL_HANDLE);
+    m_frameTimelineValues.resize(m_framesInFlight, 0);
+    m_imageTimelineValues.resize(imageCount(), 0);
 
     VkSemaphoreCreateInfo semaphoreCreateInfo{};
     semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-    VkFenceCreateInfo fenceCreateInfo{};
-    fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-    fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-
     for(std::size_t i{ 0 }; i < m_renderFinishedSemaphores.size(); ++i)
     {
         const VkResult result{
@@ -409,17 +429,13 @@ void Swapchain::createSyncObjects()
             throw VulkanException("Failed to create semaphores", result);
     }
 
-    for(std::size_t i{ 0 }; i < MAX_FRAMES_IN_FLIGHT; ++i)
+    for(std::size_t i{ 0 }; i < m_imageAvailableSemaphores.size(); ++i)
     {
-        const VkResult semaphoreResult{
+        const VkResult result{
             vkCreateSemaphore(device->device(), &semaphoreCreateInfo, nullptr, &m_imageAvailableSemaphores[i])
         };
-        if(semaphoreResult != VK_SUCCESS)
-            throw VulkanException("Failed to create semaphores", semaphoreResult);
-
-        const VkResult fenceResult{ vkCreateFence(device->device(), &fenceCreateInfo, nullptr, &m_inFlightFences[i]) };
-        if(fenceResult != VK_SUCCESS)
-            throw VulkanException("Failed to create fence objects", fenceResult);
+        if(result != VK_SUCCESS)
+            throw VulkanException("Failed to create semaphores", result);
     }
 }
 
@@ -454,7 +470,7 @@ VkFormat Swapchain::findDepthFormat() const
     return device->findSupportedFormat(
         { VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT },
         VK_IMAGE_TILING_OPTIMAL,
-        VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT
+        VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT
     );
 }
 
@@ -15,6 +15,9 @@ namespace vv
 
 /// \brief Manages synchronization of command buffers on a low level
 ///
+/// Submissions are tracked with the graphics timeline semaphore of the \ref Device. Acquire and present can only
+/// work with binary semaphores, so those are still used between the swapchain and the graphics queue.
+///
 /// \author Felix Hommel
 /// \date 11/19/2025
 class Swapchain
@@ -24,7 +27,8 @@ public:
     ///
     /// \param device \ref Device that is used to create the Swapchain
     /// \param windowExtent size of the window used to set the size for frame buffers
-    Swapchain(std::shared_ptr<Device> device, VkExtent2D windowExtent);
+    /// \param framesInFlight how many frames the CPU may record ahead of the GPU, at most \ref MAX_FRAMES_IN_FLIGHT
+    Swapchain(std::shared_ptr<Device> device, VkExtent2D windowExtent, std::uint32_t framesInFlight);
     /// \brief Create a new \ref Swapchain
     ///
     /// This variant is used primarily for recreation of the swapchain therefore
@@ -32,8 +36,14 @@ public:
     ///
     /// \param device \ref Device that is used to create the Swapchain
     /// \param windowExtent size of the window to set the size for frame buffers
+    /// \param framesInFlight how many frames the CPU may record ahead of the GPU, at most \ref MAX_FRAMES_IN_FLIGHT
     /// \param previous the olf \ref Swapchain wrapped in a shared_ptr
-    Swapchain(std::shared_ptr<Device> device, VkExtent2D windowExtent, std::shared_ptr<Swapchain> previous);
+    Swapchain(
+        std::shared_ptr<Device> device,
+        VkExtent2D windowExtent,
+        std::uint32_t framesInFlight,
+        std::shared_ptr<Swapchain> previous
+    );
     ~Swapchain();
 
     Swapchain(const Swapchain&) = delete;
@@ -41,9 +51,12 @@ public:
     Swapchain& operator=(const Swapchain&) = delete;
     Swapchain& operator=(Swapchain&&) = delete;
 
-    static constexpr std::uint32_t MAX_FRAMES_IN_FLIGHT{ 2 };
+    /// \brief Upper bound for the frames in flight, 1 gives the lowest latency and 3 the highest throughput
+    static constexpr std::uint32_t MAX_FRAMES_IN_FLIGHT{ 3 };
+    static constexpr std::uint32_t DEFAULT_FRAMES_IN_FLIGHT{ 2 };
 
     [[nodiscard]] std::size_t imageCount() const { return m_swapchainImages.size(); }
+    [[nodiscard]] std::uint32_t getFramesInFlight() const noexcept { return m_framesInFlight; }
     [[nodiscard]] VkExtent2D getExtent() const { return m_swapchainImageExtent; }
     [[nodiscard]] float extentAspectRatio() const noexcept
     {
@@ -58,6 +71,18 @@ public:
     [[nodiscard]] VkSwapchainKHR getHandle() const noexcept { return m_swapchain; }
     [[nodiscard]] VkRenderPass getRenderPass() const noexcept { return m_renderPass; }
     [[nodiscard]] VkFramebuffer getFramebuffer(std::size_t index) const;
+    [[nodiscard]] VkFormat getDepthFormat() const noexcept { return m_swapchainDepthFormat; }
+    /// \brief Depth image that belongs to a swapchain image
+    ///
+    /// After the render pass ended the image is in VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL and can be sampled
+    /// from the fragment or compute stage
+    ///
+    /// \param index index of the swapchain image
+    [[nodiscard]] VkImage getDepthImage(std::size_t index) const;
+    /// \brief Depth only image view of the depth image that belongs to a swapchain image
+    ///
+    /// \param index index of the swapchain image
+    [[nodiscard]] VkImageView getDepthImageView(std::size_t index) const;
 
     /// \brief Check if the swapchain formats match
     ///
@@ -86,13 +111,14 @@ private:
     std::vector<VkImage> m_depthImages;
     std::vector<VkDeviceMemory> m_depthImagesMemory;
     std::vector<VkImageView> m_depthImageViews;
+    std::uint32_t m_framesInFlight{ DEFAULT_FRAMES_IN_FLIGHT };
     std::size_t m_currentFrame{ 0 };
 
     /** Sync */
     std::vector<VkSemaphore> m_imageAvailableSemaphores;
     std::vector<VkSemaphore> m_renderFinishedSemaphores;
-    std::vector<VkFence> m_inFlightFences;
-    std::vector<VkFence> m_imagesInFlight;
+    std::vector<std::uint64_t> m_frameTimelineValues; ///< Graphics timeline value of the last submit of each frame
+    std::vector<std::uint64_t> m_imageTimelineValues; ///< Graphics timeline value of the last submit of each image
 
     /** Setup functions */
     void createSwapchain();
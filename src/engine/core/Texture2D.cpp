@@ -1,7 +1,8 @@
 #include "Texture2D.hpp"
 
-#include "core/Buffer.hpp"
 #include "core/Device.hpp"
+#include "core/SamplerCache.hpp"
+#include "core/UploadManager.hpp"
 #include "utility/exceptions/Exception.hpp"
 #include "utility/exceptions/FileException.hpp"
 #include "utility/exceptions/VulkanException.hpp"
@@ -22,9 +23,22 @@
 namespace vv
 {
 
+void DecodedImage::PixelDeleter::operator()(std::byte* pixels) const noexcept
+{
+    stbi_image_free(pixels);
+}
+
 Texture2D Texture2D::loadFromFile(
     std::shared_ptr<Device> device, const std::filesystem::path& filepath, const TextureConfig& config
 )
+{
+    const DecodedImage image{ decodeFile(filepath) };
+    Texture2D texture{ std::move(device), image.width, image.height, config, image.getPixels() };
+
+    return texture;
+}
+
+DecodedImage Texture2D::decodeFile(const std::filesystem::path& filepath)
 {
     // NOTE: When HDR is implemented the sRGB parameter plays a role
     int texWidth{ 0 };
@@ -35,16 +49,12 @@ Texture2D Texture2D::loadFromFile(
     if(pixels == nullptr)
         throw FileException("Failed to load texture image", filepath);
 
-    const auto size{ static_cast<std::size_t>(texWidth * texHeight) * 4 };
-    std::span<const std::byte> pixelSpan{ reinterpret_cast<const std::byte*>(pixels), size };
-    Texture2D texture{ std::move(device),
-                       static_cast<std::uint32_t>(texWidth),
-                       static_cast<std::uint32_t>(texHeight),
-                       config,
-                       pixelSpan };
-    stbi_image_free(pixels);
+    DecodedImage image{};
+    image.width = static_cast<std::uint32_t>(texWidth);
+    image.height = static_cast<std::uint32_t>(texHeight);
+    image.pixels.reset(reinterpret_cast<std::byte*>(pixels));
 
-    return texture;
+    return image;
 }
 
 Texture2D::Texture2D(
@@ -62,7 +72,6 @@ Texture2D::Texture2D(
     , m_config{ config }
 {
     uploadImageData(pixels);
-    generateMipMaps();
     createImageView();
     createSampler();
 
@@ -74,9 +83,16 @@ Texture2D::~Texture2D()
     if(device == nullptr)
         return;
 
-    vkDestroySampler(device->device(), m_sampler, nullptr);
-    vkDestroyImageView(device->device(), m_imageView, nullptr);
-    vmaDestroyImage(device->allocator(), m_image, m_allocation);
+    // NOTE: The upload, the layout transitions and the mip blits are recorded into a batch that may not have been
+    // submitted yet, and frames that are still in flight may sample the texture
+    device->destroyLater([vkDevice = device->device(),
+                          allocator = device->allocator(),
+                          imageView = m_imageView,
+                          image = m_image,
+                          allocation = m_allocation]() {
+        vkDestroyImageView(vkDevice, imageView, nullptr);
+        vmaDestroyImage(allocator, image, allocation);
+    });
 }
 
 Texture2D::Texture2D(Texture2D&& other) noexcept
@@ -128,6 +144,17 @@ Texture2D& Texture2D::operator=(Texture2D&& other) noexcept
     return *this;
 }
 
+VkDeviceSize Texture2D::memorySize() const
+{
+    if(m_allocation == VK_NULL_HANDLE)
+        return 0;
+
+    VmaAllocationInfo info{};
+    vmaGetAllocationInfo(device->allocator(), m_allocation, &info);
+
+    return info.size;
+}
+
 void Texture2D::updateDescriptor() noexcept
 {
     m_descriptor.sampler = m_sampler;
@@ -137,15 +164,11 @@ void Texture2D::updateDescriptor() noexcept
 
 /// \brief Upload the image data to the Device
 ///
+/// The copy and the mipmap generation are batched by the \ref UploadManager
+///
 /// \param pixels the raw image data in bytes to upload
 void Texture2D::uploadImageData(std::span<const std::byte> pixels)
 {
-    const VkDeviceSize imageSize{ static_cast<VkDeviceSize>(m_width * m_height) * 4 };
-    auto stagingBuffer{ Buffer::createStagingBuffer(this->device, imageSize, 1) };
-
-    stagingBuffer.writeToBuffer(pixels);
-    stagingBuffer.flush();
-
     VkImageCreateInfo imageCI{};
     imageCI.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
     imageCI.imageType = VK_IMAGE_TYPE_2D;
@@ -160,12 +183,45 @@ void Texture2D::uploadImageData(std::span<const std::byte> pixels)
     imageCI.samples = VK_SAMPLE_COUNT_1_BIT;
 
     device->createImage(imageCI, m_image, m_allocation);
-    transitionImageLayout(m_image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    device->copyBufferToImage(stagingBuffer.getBuffer(), m_image, m_width, m_height, 1);
+
+    UploadManager& uploads{ device->uploadManager() };
+    // NOTE: Staging may submit the current batch, so it happens before anything is recorded into it
+    const StagingAllocation staging{ pixels.empty() ? StagingAllocation{} : uploads.stage(pixels) };
+    VkCommandBuffer commandBuffer{ uploads.getCommandBuffer() };
+
+    transitionImageLayout(commandBuffer, m_image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+    if(staging.buffer != VK_NULL_HANDLE)
+    {
+        VkBufferImageCopy region{};
+        region.bufferOffset = staging.offset;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource
+            = { .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT, .mipLevel = 0, .baseArrayLayer = 0, .layerCount = 1 };
+        region.imageOffset = { .x = 0, .y = 0, .z = 0 };
+        region.imageExtent = { .width = m_width, .height = m_height, .depth = 1 };
+
+        vkCmdCopyBufferToImage(
+            commandBuffer, staging.buffer, m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region
+        );
+    }
+
+    // NOTE: Blitting needs a graphics queue, so the mip levels are generated after the image was handed over
+    const VkImageSubresourceRange range{ .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                                         .baseMipLevel = 0,
+                                         .levelCount = m_mipLevels,
+                                         .baseArrayLayer = 0,
+                                         .layerCount = 1 };
+    uploads.transferOwnership(m_image, range, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+    generateMipMaps(uploads.getGraphicsCommandBuffer());
 }
 
 /// \brief generate the mipmap levels for the texture
-void Texture2D::generateMipMaps()
+///
+/// \param commandBuffer command buffer on the graphics queue that runs after the image was uploaded
+void Texture2D::generateMipMaps(VkCommandBuffer commandBuffer)
 {
     VkFormatProperties formatProperties{};
     vkGetPhysicalDeviceFormatProperties(device->physicalDevice(), m_config.format, &formatProperties);
@@ -173,8 +229,6 @@ void Texture2D::generateMipMaps()
     if((formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT) == 0u)
         throw Exception("Texture image format does not support linear blitting");
 
-    VkCommandBuffer commandBuffer{ device->beginSingleTimeCommand() };
-
     VkImageMemoryBarrier barrier{};
     barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
@@ -272,8 +326,6 @@ void Texture2D::generateMipMaps()
         1,
         &barrier
     );
-
-    device->endSingleTimeCommand(commandBuffer);
 }
 
 /// \brief Create the image view for the texture
@@ -295,7 +347,9 @@ void Texture2D::createImageView()
         throw VulkanException("Failed to create texture image view", result);
 }
 
-/// \brief Create the sampler for the texture
+/// \brief Get the sampler for the texture from the \ref SamplerCache
+///
+/// Every texture with the same config shares the sampler
 void Texture2D::createSampler()
 {
     VkSamplerCreateInfo samplerCI{};
@@ -312,23 +366,23 @@ void Texture2D::createSampler()
     samplerCI.compareEnable = VK_FALSE;
     samplerCI.mipmapMode = m_config.mipmapMode;
     samplerCI.minLod = 0.f;
-    samplerCI.maxLod = static_cast<float>(m_mipLevels);
+    // NOTE: The image view limits the levels, so textures with a different mip count share the sampler
+    samplerCI.maxLod = VK_LOD_CLAMP_NONE;
     samplerCI.mipLodBias = 0.f;
 
-    const VkResult result{ vkCreateSampler(device->device(), &samplerCI, nullptr, &m_sampler) };
-    if(result != VK_SUCCESS)
-        throw VulkanException("Failed to create texture sampler", result);
+    m_sampler = device->samplerCache().getSampler(samplerCI);
 }
 
 /// \brief Transition a imgae layout from one to another
 ///
+/// \param commandBuffer the command buffer to record the transition into
 /// \param image the \ref VkImage to transition
 /// \param oldLayout the layout the image is currently in
 /// \param newLayout the layout the image is transitioned to
-void Texture2D::transitionImageLayout(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout)
+void Texture2D::transitionImageLayout(
+    VkCommandBuffer commandBuffer, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout
+)
 {
-    VkCommandBuffer commandBuffer{ device->beginSingleTimeCommand() };
-
     VkImageMemoryBarrier barrier{};
     barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     barrier.oldLayout = oldLayout;
@@ -363,8 +417,6 @@ void Texture2D::transitionImageLayout(VkImage image, VkImageLayout oldLayout, Vk
     }
 
     vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-
-    device->endSingleTimeCommand(commandBuffer);
 }
 
 } // namespace vv
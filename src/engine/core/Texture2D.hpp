@@ -51,8 +51,35 @@ public:
     }
 };
 
+/// \brief Pixels of an image file, decoded to 8 bit RGBA on the CPU
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct DecodedImage
+{
+    /// \brief Frees the pixels with the image library that decoded them
+    struct PixelDeleter
+    {
+        void operator()(std::byte* pixels) const noexcept;
+    };
+
+    static constexpr std::size_t CHANNELS{ 4 };
+
+    std::uint32_t width{ 0 };
+    std::uint32_t height{ 0 };
+    std::unique_ptr<std::byte, PixelDeleter> pixels;
+
+    [[nodiscard]] std::span<const std::byte> getPixels() const noexcept
+    {
+        return { pixels.get(), static_cast<std::size_t>(width) * height * CHANNELS };
+    }
+};
+
 /// \brief Abstraction over Textures for easier usage with Vulkan
 ///
+/// The pixels are uploaded with the current batch of the \ref UploadManager, so creating many textures costs one
+/// submission and nothing waits for the GPU. Textures can be used by frames that are recorded after they were created
+///
 /// \author Felix Hommel
 /// \date 12/15/12025
 class Texture2D
@@ -61,6 +88,12 @@ public:
     static Texture2D loadFromFile(
         std::shared_ptr<Device> device, const std::filesystem::path& filepath, const TextureConfig& config
     );
+    /// \brief Decode an image file without touching the GPU, safe to call from any thread
+    ///
+    /// \param filepath the image file to decode
+    ///
+    /// \returns the decoded pixels, which can be passed to the constructor
+    [[nodiscard]] static DecodedImage decodeFile(const std::filesystem::path& filepath);
 
     /// \brief Create a new 2D Texture
     ///
@@ -89,6 +122,8 @@ public:
     [[nodiscard]] std::uint32_t width() const noexcept { return m_width; }
     [[nodiscard]] std::uint32_t height() const noexcept { return m_height; }
     [[nodiscard]] std::uint32_t mipLevels() const noexcept { return m_mipLevels; }
+    /// \brief Device memory taken up by the image and its mip levels (in byte)
+    [[nodiscard]] VkDeviceSize memorySize() const;
 
     /// \brief update the descriptor information
     void updateDescriptor() noexcept;
@@ -99,7 +134,7 @@ private:
     VkImage m_image{ VK_NULL_HANDLE };
     VkImageView m_imageView{ VK_NULL_HANDLE };
     VmaAllocation m_allocation{ VK_NULL_HANDLE };
-    VkSampler m_sampler{ VK_NULL_HANDLE };
+    VkSampler m_sampler{ VK_NULL_HANDLE }; ///< Owned by the \ref SamplerCache
     VkDescriptorImageInfo m_descriptor{};
 
     std::uint32_t m_width{ 0 };
@@ -108,11 +143,13 @@ private:
     TextureConfig m_config;
 
     void uploadImageData(std::span<const std::byte> pixels);
-    void generateMipMaps();
+    void generateMipMaps(VkCommandBuffer commandBuffer);
     void createImageView();
     void createSampler();
 
-    void transitionImageLayout(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout);
+    void transitionImageLayout(
+        VkCommandBuffer commandBuffer, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout
+    );
 };
 
 } // namespace vv
@@ -0,0 +1,441 @@
+#include "UploadManager.hpp"
+
+#include "core/Device.hpp"
+#include "utility/DeletionQueue.hpp"
+#include "utility/exceptions/Exception.hpp"
+#include "utility/exceptions/VulkanException.hpp"
+
+#include "vk_mem_alloc.h"
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace vv
+{
+
+UploadManager::UploadManager(Device& device, VkDeviceSize stagingSize)
+    : device{ device }, m_ring{ stagingSize }
+{
+    createStagingBuffer(stagingSize);
+    createCommandPools();
+}
+
+UploadManager::~UploadManager()
+{
+    // NOTE: A batch that was never submitted is freed together with the command pools
+    for(const auto& deleter : m_batchDeletions)
+        deleter();
+
+    for(const auto& staging : m_dedicatedStagingBuffers)
+        vmaDestroyBuffer(device.allocator(), staging.buffer, staging.allocation);
+
+    vkDestroyCommandPool(device.device(), m_graphics.pool, nullptr);
+    vkDestroyCommandPool(device.device(), m_transfer.pool, nullptr);
+    vmaDestroyBuffer(device.allocator(), m_stagingBuffer, m_stagingAllocation);
+}
+
+StagingAllocation UploadManager::stage(std::span<const std::byte> data)
+{
+    if(data.size() > m_ring.getCapacity())
+        return stageDedicated(data);
+
+    m_ring.release(device.completedTransferValue());
+
+    std::optional<std::uint64_t> offset{ m_ring.allocate(data.size(), STAGING_ALIGNMENT) };
+    while(!offset.has_value())
+    {
+        // NOTE: The ring is only taken up by the current batch, which has to be submitted to be released
+        if(!m_ring.hasPendingBatches())
+            flush();
+
+        device.waitForTransferValue(m_ring.getOldestPendingValue());
+        m_ring.release(device.completedTransferValue());
+
+        offset = m_ring.allocate(data.size(), STAGING_ALIGNMENT);
+    }
+
+    std::memcpy(m_stagingData + offset.value(), data.data(), data.size());
+    vmaFlushAllocation(device.allocator(), m_stagingAllocation, offset.value(), data.size());
+    m_uploadedBytes += data.size();
+
+    return { .buffer = m_stagingBuffer, .offset = offset.value() };
+}
+
+VkCommandBuffer UploadManager::getCommandBuffer()
+{
+    if(m_transfer.commandBuffer == VK_NULL_HANDLE)
+        beginCommandBuffer(m_transfer, device.completedTransferValue());
+
+    return m_transfer.commandBuffer;
+}
+
+VkCommandBuffer UploadManager::getGraphicsCommandBuffer()
+{
+    if(!device.hasDedicatedTransferQueue())
+        return getCommandBuffer();
+
+    // NOTE: The graphics batch waits for a transfer batch, so one is started as well
+    if(m_transfer.commandBuffer == VK_NULL_HANDLE)
+        beginCommandBuffer(m_transfer, device.completedTransferValue());
+
+    if(m_graphics.commandBuffer == VK_NULL_HANDLE)
+        beginCommandBuffer(m_graphics, device.completedGraphicsValue());
+
+    return m_graphics.commandBuffer;
+}
+
+void UploadManager::transferOwnership(VkBuffer buffer)
+{
+    if(!device.hasDedicatedTransferQueue() || std::ranges::find(m_ownedBuffers, buffer) != m_ownedBuffers.end())
+        return;
+
+    m_ownedBuffers.push_back(buffer);
+}
+
+void UploadManager::transferOwnership(VkImage image, const VkImageSubresourceRange& range, VkImageLayout layout)
+{
+    if(!device.hasDedicatedTransferQueue())
+        return;
+
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = 0;
+    barrier.oldLayout = layout;
+    barrier.newLayout = layout;
+    barrier.srcQueueFamilyIndex = m_transferFamily;
+    barrier.dstQueueFamilyIndex = m_graphicsFamily;
+    barrier.image = image;
+    barrier.subresourceRange = range;
+
+    vkCmdPipelineBarrier(
+        getCommandBuffer(),
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+        0,
+        0,
+        nullptr,
+        0,
+        nullptr,
+        1,
+        &barrier
+    );
+
+    // NOTE: The acquire has to match the release, only the access masks differ
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+    vkCmdPipelineBarrier(
+        getGraphicsCommandBuffer(),
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        0,
+        0,
+        nullptr,
+        0,
+        nullptr,
+        1,
+        &barrier
+    );
+}
+
+void UploadManager::uploadBuffer(VkBuffer dstBuffer, std::span<const std::byte> data, VkDeviceSize dstOffset)
+{
+    if(data.empty())
+        return;
+
+    const StagingAllocation staging{ stage(data) };
+    const VkBufferCopy region{ .srcOffset = staging.offset, .dstOffset = dstOffset, .size = data.size() };
+
+    vkCmdCopyBuffer(getCommandBuffer(), staging.buffer, dstBuffer, 1, &region);
+    transferOwnership(dstBuffer);
+}
+
+std::uint64_t UploadManager::flush()
+{
+    if(m_transfer.commandBuffer == VK_NULL_HANDLE)
+        return m_lastBatchValue;
+
+    recordBufferOwnershipTransfers();
+
+    // NOTE: Makes the copies visible to every command that is submitted after the batch and to the host
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_HOST_READ_BIT;
+
+    vkCmdPipelineBarrier(
+        getGraphicsCommandBuffer(),
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+        0,
+        1,
+        &barrier,
+        0,
+        nullptr,
+        0,
+        nullptr
+    );
+
+    VkCommandBuffer transferCommandBuffer{ endCommandBuffer(m_transfer) };
+    const std::uint64_t transferValue{ device.submitTransfer(transferCommandBuffer) };
+    m_transfer.submitted.push_back({ .commandBuffer = transferCommandBuffer, .value = transferValue });
+    m_ring.close(transferValue);
+
+    std::uint64_t value{ transferValue };
+    if(device.hasDedicatedTransferQueue())
+    {
+        // NOTE: Only this batch waits for the copies, frames that were submitted before keep rendering meanwhile
+        VkCommandBuffer graphicsCommandBuffer{ endCommandBuffer(m_graphics) };
+        value = device.submitGraphics(
+            graphicsCommandBuffer,
+            device.transferTimeline(),
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VK_NULL_HANDLE,
+            transferValue
+        );
+        m_graphics.submitted.push_back({ .commandBuffer = graphicsCommandBuffer, .value = value });
+    }
+
+    for(const auto& staging : m_dedicatedStagingBuffers)
+    {
+        device.destroyLater([allocator = device.allocator(), staging]() {
+            vmaDestroyBuffer(allocator, staging.buffer, staging.allocation);
+        });
+    }
+    m_dedicatedStagingBuffers.clear();
+
+    for(auto& deleter : m_batchDeletions)
+        device.destroyLater(std::move(deleter));
+    m_batchDeletions.clear();
+
+    m_lastBatchValue = value;
+    ++m_submittedBatches;
+
+    return value;
+}
+
+void UploadManager::destroyAfterBatch(DeletionQueue::Deleter deleter)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(hasPendingUploads() && "There is no batch to wait for");
+#endif
+
+    m_batchDeletions.push_back(std::move(deleter));
+}
+
+void UploadManager::flushAndWait()
+{
+    device.waitForGraphicsValue(flush());
+}
+
+/// \brief Create the staging ring, which stays mapped for the lifetime of the upload manager
+///
+/// \param size size of the ring in bytes
+void UploadManager::createStagingBuffer(VkDeviceSize size)
+{
+    if(size % STAGING_ALIGNMENT != 0)
+        throw Exception("The staging size has to be a multiple of the staging alignment");
+
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    VkBufferCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.size = size;
+    createInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VmaAllocationInfo allocationInfo{};
+    const VkResult result{ vmaCreateBuffer(
+        device.allocator(), &createInfo, &allocInfo, &m_stagingBuffer, &m_stagingAllocation, &allocationInfo
+    ) };
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to create staging ring", result);
+
+    m_stagingData = static_cast<std::byte*>(allocationInfo.pMappedData);
+}
+
+/// \brief Create the command pools of the upload batches
+///
+/// Command buffers are reset one by one, because older batches may still be executing. The graphics pool is only
+/// needed with a dedicated transfer queue, otherwise the transfer pool already belongs to the graphics family
+void UploadManager::createCommandPools()
+{
+    const QueueFamilyIndices indices{ device.findPhysicalQueueFamilies() };
+    if(!indices.graphicsFamily.has_value())
+        throw Exception("Failed to find graphics queue family");
+
+    m_graphicsFamily = indices.graphicsFamily.value();
+    m_transferFamily = device.hasDedicatedTransferQueue() ? indices.transferFamily.value() : m_graphicsFamily;
+
+    VkCommandPoolCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    createInfo.queueFamilyIndex = m_transferFamily;
+
+    VkResult result{ vkCreateCommandPool(device.device(), &createInfo, nullptr, &m_transfer.pool) };
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to create upload command pool", result);
+
+    if(!device.hasDedicatedTransferQueue())
+        return;
+
+    createInfo.queueFamilyIndex = m_graphicsFamily;
+
+    result = vkCreateCommandPool(device.device(), &createInfo, nullptr, &m_graphics.pool);
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to create upload acquire command pool", result);
+}
+
+/// \brief Start recording a batch, reusing the command buffer of an earlier batch if it has finished
+///
+/// \param recorder the command buffers of the queue family the batch is submitted to
+/// \param completedValue the value the timeline of the queue has reached
+void UploadManager::beginCommandBuffer(CommandRecorder& recorder, std::uint64_t completedValue) const
+{
+    if(!recorder.submitted.empty() && recorder.submitted.front().value <= completedValue)
+    {
+        recorder.commandBuffer = recorder.submitted.front().commandBuffer;
+        recorder.submitted.pop_front();
+    }
+    else
+    {
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = recorder.pool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+
+        const VkResult result{ vkAllocateCommandBuffers(device.device(), &allocInfo, &recorder.commandBuffer) };
+        if(result != VK_SUCCESS)
+            throw VulkanException("Failed to allocate upload command buffer", result);
+    }
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    const VkResult result{ vkBeginCommandBuffer(recorder.commandBuffer, &beginInfo) };
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to begin recording upload command buffer", result);
+}
+
+/// \brief Stop recording a batch
+///
+/// \param recorder the command buffers of the queue family the batch is submitted to
+///
+/// \returns the command buffer of the batch, ready to be submitted
+VkCommandBuffer UploadManager::endCommandBuffer(CommandRecorder& recorder)
+{
+    VkCommandBuffer commandBuffer{ recorder.commandBuffer };
+    recorder.commandBuffer = VK_NULL_HANDLE;
+
+    const VkResult result{ vkEndCommandBuffer(commandBuffer) };
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to record upload command buffer", result);
+
+    return commandBuffer;
+}
+
+/// \brief Release the buffers written by the current batch and acquire them on the graphics queue
+void UploadManager::recordBufferOwnershipTransfers()
+{
+    if(m_ownedBuffers.empty())
+        return;
+
+    std::vector<VkBufferMemoryBarrier> barriers{};
+    barriers.reserve(m_ownedBuffers.size());
+    for(VkBuffer buffer : m_ownedBuffers)
+    {
+        VkBufferMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = 0;
+        barrier.srcQueueFamilyIndex = m_transferFamily;
+        barrier.dstQueueFamilyIndex = m_graphicsFamily;
+        barrier.buffer = buffer;
+        barrier.offset = 0;
+        barrier.size = VK_WHOLE_SIZE;
+
+        barriers.push_back(barrier);
+    }
+    m_ownedBuffers.clear();
+
+    vkCmdPipelineBarrier(
+        getCommandBuffer(),
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+        0,
+        0,
+        nullptr,
+        static_cast<std::uint32_t>(barriers.size()),
+        barriers.data(),
+        0,
+        nullptr
+    );
+
+    for(auto& barrier : barriers)
+    {
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+    }
+
+    vkCmdPipelineBarrier(
+        getGraphicsCommandBuffer(),
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        0,
+        0,
+        nullptr,
+        static_cast<std::uint32_t>(barriers.size()),
+        barriers.data(),
+        0,
+        nullptr
+    );
+}
+
+/// \brief Stage data that does not fit into the ring in a staging buffer of its own
+///
+/// \param data the data that is uploaded
+///
+/// \returns where the data is staged
+StagingAllocation UploadManager::stageDedicated(std::span<const std::byte> data)
+{
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    VkBufferCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.size = data.size();
+    createInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    DedicatedStagingBuffer staging{};
+    VmaAllocationInfo allocationInfo{};
+    const VkResult result{ vmaCreateBuffer(
+        device.allocator(), &createInfo, &allocInfo, &staging.buffer, &staging.allocation, &allocationInfo
+    ) };
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to create dedicated staging buffer", result);
+
+    m_dedicatedStagingBuffers.push_back(staging);
+
+    std::memcpy(allocationInfo.pMappedData, data.data(), data.size());
+    vmaFlushAllocation(device.allocator(), staging.allocation, 0, data.size());
+    m_uploadedBytes += data.size();
+
+    return { .buffer = staging.buffer, .offset = 0 };
+}
+
+} // namespace vv
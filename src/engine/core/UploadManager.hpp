@@ -0,0 +1,170 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_CORE_UPLOAD_MANAGER_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_CORE_UPLOAD_MANAGER_HPP
+
+#include "utility/DeletionQueue.hpp"
+#include "utility/RingAllocator.hpp"
+
+#include "vk_mem_alloc.h"
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <vector>
+
+namespace vv
+{
+
+class Device;
+
+/// \brief Staged data that is ready to be copied by the upload command buffer
+struct StagingAllocation
+{
+    VkBuffer buffer{ VK_NULL_HANDLE };
+    VkDeviceSize offset{ 0 };
+};
+
+/// \brief Batches uploads to device local memory into one command buffer
+///
+/// Data is copied into a persistently mapped staging ring and the copies are recorded into a command buffer that is
+/// submitted by \ref flush, which the \ref Renderer calls once per frame. Nothing waits for the GPU unless the ring is
+/// full. The batch ends with a memory barrier, so everything that is submitted afterwards sees the uploaded data.
+///
+/// With a dedicated transfer queue the copies run there, next to the frames that are still rendering. The batch then
+/// releases the ownership of the uploaded resources and a small graphics batch acquires it. The graphics batch waits
+/// for the transfer timeline and also holds the work that needs a graphics queue, like blitting mip levels. Without a
+/// dedicated transfer queue both are the same command buffer on the graphics queue and ownership transfers are skipped.
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+class UploadManager
+{
+public:
+    static constexpr VkDeviceSize DEFAULT_STAGING_SIZE{ 32ULL * 1024 * 1024 };
+    /// \brief Offset alignment of staged data, enough for buffer copies and every color format
+    static constexpr VkDeviceSize STAGING_ALIGNMENT{ 16 };
+
+    /// \brief Create a new \ref UploadManager
+    ///
+    /// \param device the \ref Device that owns the upload manager
+    /// \param stagingSize size of the staging ring in bytes
+    explicit UploadManager(Device& device, VkDeviceSize stagingSize = DEFAULT_STAGING_SIZE);
+    ~UploadManager();
+
+    UploadManager(const UploadManager&) = delete;
+    UploadManager(UploadManager&&) = delete;
+    UploadManager& operator=(const UploadManager&) = delete;
+    UploadManager& operator=(UploadManager&&) = delete;
+
+    [[nodiscard]] bool hasPendingUploads() const noexcept { return m_transfer.commandBuffer != VK_NULL_HANDLE; }
+    /// \brief Bytes that went through the staging ring since the upload manager was created
+    [[nodiscard]] VkDeviceSize getUploadedBytes() const noexcept { return m_uploadedBytes; }
+    /// \brief How many batches have been submitted since the upload manager was created
+    [[nodiscard]] std::size_t getSubmittedBatches() const noexcept { return m_submittedBatches; }
+
+    /// \brief Copy data into the staging memory
+    ///
+    /// If the ring is full, the current batch is submitted and older batches are waited for, so data has to be staged
+    /// before the commands that read it are recorded. Data that is larger than the whole ring gets its own staging
+    /// buffer, which is destroyed once the batch has finished
+    ///
+    /// \param data the data that is uploaded
+    ///
+    /// \returns where the data is staged, valid until the current batch has finished
+    [[nodiscard]] StagingAllocation stage(std::span<const std::byte> data);
+    /// \brief The command buffer of the current batch, in the recording state
+    ///
+    /// Copies out of the staging memory are recorded into it. It may be executed by a queue without graphics support
+    [[nodiscard]] VkCommandBuffer getCommandBuffer();
+    /// \brief The command buffer that runs on the graphics queue after the current batch, in the recording state
+    ///
+    /// Commands that need a graphics queue are recorded into it, after the ownership of their resources was
+    /// transferred. Without a dedicated transfer queue this is the command buffer of the current batch
+    [[nodiscard]] VkCommandBuffer getGraphicsCommandBuffer();
+    /// \brief Hand a buffer that was written by the current batch over to the graphics queue
+    ///
+    /// The ownership transfer is recorded when the batch is submitted, so a buffer can be written several times
+    ///
+    /// \param buffer the buffer that was written
+    void transferOwnership(VkBuffer buffer);
+    /// \brief Hand an image that was written by the current batch over to the graphics queue
+    ///
+    /// Recorded right away, commands using the image afterwards go into the \ref getGraphicsCommandBuffer
+    ///
+    /// \param image the image that was written
+    /// \param range the subresources that were written
+    /// \param layout the layout the subresources are in, it is kept by the transfer
+    void transferOwnership(VkImage image, const VkImageSubresourceRange& range, VkImageLayout layout);
+    /// \brief Stage data and copy it into a buffer, which is handed over to the graphics queue
+    ///
+    /// \param dstBuffer the buffer to copy to
+    /// \param data the data that is copied
+    /// \param dstOffset offset into the buffer to copy to
+    void uploadBuffer(VkBuffer dstBuffer, std::span<const std::byte> data, VkDeviceSize dstOffset = 0);
+    /// \brief Destroy something once the current batch has finished
+    ///
+    /// The deletion is handed to \ref Device::destroyLater when the batch is submitted
+    ///
+    /// \param deleter destroys the resource
+    void destroyAfterBatch(DeletionQueue::Deleter deleter);
+    /// \brief Submit the current batch, if there is one
+    ///
+    /// \returns the graphics timeline value after which every upload so far has finished
+    std::uint64_t flush();
+    /// \brief Submit the current batch and wait until every upload has finished
+    void flushAndWait();
+
+private:
+    /// \brief A command buffer of an earlier batch that can be reused once the timeline reached the value
+    struct SubmittedCommandBuffer
+    {
+        VkCommandBuffer commandBuffer{ VK_NULL_HANDLE };
+        std::uint64_t value{ 0 };
+    };
+
+    /// \brief Command buffers of one queue family
+    struct CommandRecorder
+    {
+        VkCommandPool pool{ VK_NULL_HANDLE };
+        VkCommandBuffer commandBuffer{ VK_NULL_HANDLE }; ///< The batch that is being recorded, if any
+        std::deque<SubmittedCommandBuffer> submitted;
+    };
+
+    /// \brief A staging buffer that did not fit into the ring
+    struct DedicatedStagingBuffer
+    {
+        VkBuffer buffer{ VK_NULL_HANDLE };
+        VmaAllocation allocation{ VK_NULL_HANDLE };
+    };
+
+    Device& device;
+
+    VkBuffer m_stagingBuffer{ VK_NULL_HANDLE };
+    VmaAllocation m_stagingAllocation{ VK_NULL_HANDLE };
+    std::byte* m_stagingData{ nullptr };
+    RingAllocator m_ring;
+
+    std::uint32_t m_transferFamily{ 0 };
+    std::uint32_t m_graphicsFamily{ 0 };
+    CommandRecorder m_transfer;
+    CommandRecorder m_graphics; ///< Only used with a dedicated transfer queue
+    std::vector<VkBuffer> m_ownedBuffers; ///< Written by the current batch and not handed over yet
+    std::vector<DedicatedStagingBuffer> m_dedicatedStagingBuffers; ///< Used by the batch that is being recorded
+    std::vector<DeletionQueue::Deleter> m_batchDeletions; ///< Wait for the batch that is being recorded
+    std::uint64_t m_lastBatchValue{ 0 };
+
+    VkDeviceSize m_uploadedBytes{ 0 };
+    std::size_t m_submittedBatches{ 0 };
+
+    void createStagingBuffer(VkDeviceSize size);
+    void createCommandPools();
+    void beginCommandBuffer(CommandRecorder& recorder, std::uint64_t completedValue) const;
+    [[nodiscard]] static VkCommandBuffer endCommandBuffer(CommandRecorder& recorder);
+    void recordBufferOwnershipTransfers();
+    [[nodiscard]] StagingAllocation stageDedicated(std::span<const std::byte> data);
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_CORE_UPLOAD_MANAGER_HPP
@@ -4,24 +4,30 @@
 #include "core/GraphicsPipeline.hpp"
 #include "renderSystems/IRenderSystem.hpp"
 #include "utility/FrameInfo.hpp"
+#include "utility/exceptions/VulkanException.hpp"
 #include "utility/object/components/ModelComponent.hpp"
 #include "utility/object/components/TransformComponent.hpp"
 
 #include <vulkan/vulkan_core.h>
 
+#include <cstdint>
 #include <memory>
 #include <ranges>
 #include <utility>
+#include <vector>
 
 namespace vv
 {
 
 BasicRenderSystem::BasicRenderSystem(
-    std::shared_ptr<Device> device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout
+    std::shared_ptr<Device> device,
+    VkRenderPass renderPass,
+    VkDescriptorSetLayout globalSetLayout,
+    VkDescriptorSetLayout lightSetLayout
 )
-    : IRenderSystem(std::move(device))
+    : IRenderSystem(std::move(device)), m_lightSetLayout{ lightSetLayout }
 {
-    createGraphicsPipelineLayout(globalSetLayout);
+    BasicRenderSystem::createGraphicsPipelineLayout(globalSetLayout);
     createGraphicsPipeline(renderPass, VERTEX_SHADER_PATH, FRAGMENT_SHADER_PATH);
 }
 
@@ -44,6 +50,16 @@ void BasicRenderSystem::render(const FrameInfo& frameInfo) const
         0,
         nullptr
     );
+    vkCmdBindDescriptorSets(
+        frameInfo.commandBuffer,
+        VK_PIPELINE_BIND_POINT_GRAPHICS,
+        m_graphicsPipelineLayout,
+        1,
+        1,
+        &frameInfo.lightDescriptorSet,
+        0,
+        nullptr
+    );
 
     for(auto& obj : *frameInfo.objects | std::views::values)
     {
@@ -67,4 +83,25 @@ void BasicRenderSystem::render(const FrameInfo& frameInfo) const
     }
 }
 
+/// \brief Create a PipelineLayout with the global set (set 0) and the clustered light set (set 1)
+void BasicRenderSystem::createGraphicsPipelineLayout(VkDescriptorSetLayout globalSetLayout)
+{
+    constexpr VkPushConstantRange pushConstantRange{ .stageFlags
+                                                     = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                                                     .offset = 0,
+                                                     .size = sizeof(SimplePushConstantData) };
+    std::vector<VkDescriptorSetLayout> descriptorSetLayouts{ globalSetLayout, m_lightSetLayout };
+
+    VkPipelineLayoutCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    createInfo.setLayoutCount = static_cast<std::uint32_t>(descriptorSetLayouts.size());
+    createInfo.pSetLayouts = descriptorSetLayouts.data();
+    createInfo.pushConstantRangeCount = 1;
+    createInfo.pPushConstantRanges = &pushConstantRange;
+
+    const VkResult result{ vkCreatePipelineLayout(device->device(), &createInfo, nullptr, &m_graphicsPipelineLayout) };
+    if(result != VK_SUCCESS)
+        throw VulkanException("Failed to create basic pipeline layout", result);
+}
+
 } // namespace vv
@@ -30,7 +30,13 @@ public:
     /// \param device \ref Device to create the \ref Pipeline on
     /// \param renderPass Which RenderPass to use in the pipeline
     /// \param globalSetLayout the layout of globally used descriptor sets
-    BasicRenderSystem(std::shared_ptr<Device> device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout);
+    /// \param lightSetLayout layout of the clustered light set of the \ref LightClusterer
+    BasicRenderSystem(
+        std::shared_ptr<Device> device,
+        VkRenderPass renderPass,
+        VkDescriptorSetLayout globalSetLayout,
+        VkDescriptorSetLayout lightSetLayout
+    );
     ~BasicRenderSystem() override;
 
     BasicRenderSystem(const BasicRenderSystem&) = delete;
@@ -46,6 +52,10 @@ public:
 private:
     static constexpr auto VERTEX_SHADER_PATH{ PROJECT_ROOT "resources/compiledShaders/simpleVert.spv" };
     static constexpr auto FRAGMENT_SHADER_PATH{ PROJECT_ROOT "resources/compiledShaders/simpleFrag.spv" };
+
+    VkDescriptorSetLayout m_lightSetLayout{ VK_NULL_HANDLE }; ///< Owned by the \ref LightClusterer
+
+    void createGraphicsPipelineLayout(VkDescriptorSetLayout globalSetLayout) override;
 };
 
 } // namespace vv
@@ -1,35 +1,64 @@
 #include "PBRRenderSystem.hpp"
 
+#include "core/Buffer.hpp"
+#include "core/DepthPyramid.hpp"
+#include "core/DescriptorPool.hpp"
+#include "core/DescriptorSetLayout.hpp"
+#include "core/DescriptorWriter.hpp"
 #include "core/Device.hpp"
+#include "core/GpuCuller.hpp"
+#include "core/GraphicsPipeline.hpp"
 #include "renderSystems/IRenderSystem.hpp"
+#include "utility/Bounds.hpp"
+#include "utility/DrawSort.hpp"
 #include "utility/FrameInfo.hpp"
+#include "utility/Model.hpp"
+#include "utility/exceptions/Exception.hpp"
 #include "utility/exceptions/VulkanException.hpp"
 #include "utility/material/Material.hpp"
+#include "utility/material/MaterialTable.hpp"
+#include "utility/object/Object.hpp"
 #include "utility/object/components/MaterialComponent.hpp"
 #include "utility/object/components/ModelComponent.hpp"
 #include "utility/object/components/TransformComponent.hpp"
 
-#include <vector>
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include "glm/glm.hpp"
+#include "spdlog/spdlog.h"
 #include <vulkan/vulkan_core.h>
 
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace vv
 {
 
 PBRRenderSystem::PBRRenderSystem(
-    std::shared_ptr<Device> device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout
+    std::shared_ptr<Device> device,
+    VkRenderPass renderPass,
+    VkDescriptorSetLayout globalSetLayout,
+    VkDescriptorSetLayout lightSetLayout,
+    std::uint32_t framesInFlight
 )
     : IRenderSystem(std::move(device))
-    , m_materialSetLayout{ DescriptorSetLayout::Builder(this->device)
-                               .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_ALL_GRAPHICS)
-                               .addBinding(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_ALL_GRAPHICS)
-                               .addBinding(2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_ALL_GRAPHICS)
-                               .addBinding(3, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_ALL_GRAPHICS)
-                               .addBinding(4, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_ALL_GRAPHICS)
-                               .buildShared() }
+    , m_materialTable{ std::make_shared<MaterialTable>(this->device) }
+    , m_lightSetLayout{ lightSetLayout }
+    , m_objectSetLayout{ DescriptorSetLayout::Builder(this->device)
+                             .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT)
+                             .buildShared() }
+    , m_objectPool{ DescriptorPool::Builder(this->device)
+                        .setMaxSets(framesInFlight)
+                        .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, framesInFlight)
+                        .build() }
+    , m_frames(framesInFlight)
 {
     PBRRenderSystem::createGraphicsPipelineLayout(globalSetLayout);
     PBRRenderSystem::createGraphicsPipeline(renderPass, PBR_VERTEX_SHADER_PATH, PBR_FRAGMENT_SHADER_PATH);
@@ -40,11 +69,125 @@ PBRRenderSystem::~PBRRenderSystem()
     vkDestroyPipelineLayout(device->device(), m_graphicsPipelineLayout, nullptr);
 }
 
+void PBRRenderSystem::setRenderMode(PBRRenderMode mode)
+{
+    if(mode == PBRRenderMode::GpuCulled && !GpuCuller::isSupported(*device))
+    {
+        spdlog::warn("drawIndirectCount is not supported, falling back to indirect PBR rendering");
+        mode = PBRRenderMode::Indirect;
+    }
+
+    if(mode == PBRRenderMode::Indirect && device->enabledFeatures().drawIndirectFirstInstance == VK_FALSE)
+    {
+        spdlog::warn("drawIndirectFirstInstance is not supported, falling back to instanced PBR rendering");
+        mode = PBRRenderMode::Instanced;
+    }
+
+    if(mode == PBRRenderMode::GpuCulled && m_gpuCuller == nullptr)
+        m_gpuCuller = std::make_unique<GpuCuller>(device, static_cast<std::uint32_t>(m_frames.size()));
+
+    m_renderMode = mode;
+}
+
+void PBRRenderSystem::update(FrameInfo& frameInfo, [[maybe_unused]] GlobalUBO& ubo)
+{
+    collectVisibleItems(frameInfo);
+    const std::uint32_t unsortedBinds{ countUnsortedBinds() };
+    sortDrawItems(frameInfo);
+    m_stats.objects = static_cast<std::uint32_t>(m_candidates.size());
+    m_stats.visibleObjects = static_cast<std::uint32_t>(m_drawItems.size());
+    m_stats.occlusionCulled = 0;
+
+    if(m_renderMode == PBRRenderMode::PerObject)
+    {
+        m_stats.drawCalls = m_stats.visibleObjects;
+        countBinds(unsortedBinds);
+        return;
+    }
+
+    buildBatches();
+    m_stats.drawCalls = static_cast<std::uint32_t>(m_batches.size());
+    countBinds(unsortedBinds);
+
+    auto& frame{ m_frames[frameInfo.frameIndex] };
+    reserveFrameResources(
+        frame, static_cast<std::uint32_t>(m_objectData.size()), static_cast<std::uint32_t>(m_batches.size())
+    );
+
+    if(m_renderMode == PBRRenderMode::GpuCulled)
+        updateGpuCulling(frameInfo);
+
+    if(m_objectData.empty())
+        return;
+
+    frame.objectBuffer->writeToBuffer(m_objectData);
+    frame.objectBuffer->flush();
+
+    if(m_renderMode == PBRRenderMode::Indirect)
+        writeIndirectCommands(frame);
+}
+
+void PBRRenderSystem::cull(const FrameInfo& frameInfo, const DepthPyramid& depthPyramid)
+{
+    if(m_renderMode != PBRRenderMode::GpuCulled)
+        return;
+
+    m_gpuCuller->cull(frameInfo.commandBuffer, frameInfo.frameIndex, depthPyramid);
+}
+
+void PBRRenderSystem::renderDepthPrepass(const FrameInfo& frameInfo) const
+{
+    renderDepthPrepass(frameInfo, 0, getDrawCount());
+}
+
+void PBRRenderSystem::renderDepthPrepass(const FrameInfo& frameInfo, std::size_t first, std::size_t count) const
+{
+    if(!m_depthPrepass)
+        return;
+
+    if(m_renderMode == PBRRenderMode::PerObject)
+        renderPerObject(frameInfo, *m_depthPipeline, true, first, count);
+    else
+        renderBatched(frameInfo, *m_depthInstancedPipeline, true, first, count);
+}
+
 void PBRRenderSystem::render(const FrameInfo& frameInfo) const
 {
-    m_graphicsPipeline->bind(frameInfo.commandBuffer);
+    render(frameInfo, 0, getDrawCount());
+}
 
-    // NOTE: bind global descriptor (set 0; view, projection, and lights)
+void PBRRenderSystem::render(const FrameInfo& frameInfo, std::size_t first, std::size_t count) const
+{
+    if(m_renderMode == PBRRenderMode::PerObject)
+        renderPerObject(frameInfo, m_depthPrepass ? *m_equalPipeline : *m_graphicsPipeline, false, first, count);
+    else
+        renderBatched(
+            frameInfo, m_depthPrepass ? *m_equalInstancedPipeline : *m_instancedPipeline, false, first, count
+        );
+}
+
+std::size_t PBRRenderSystem::getDrawCount() const noexcept
+{
+    return m_renderMode == PBRRenderMode::PerObject ? m_drawItems.size() : m_batches.size();
+}
+
+/// \brief Record one draw per object with the model and normal matrices as push constants
+///
+/// \param frameInfo \ref FrameInfo with data about the current frame
+/// \param pipeline the pipeline the objects are drawn with
+/// \param depthOnly only bind the positions of the models and skip the materials, for the depth prepass
+/// \param first the first object that is drawn
+/// \param count how many objects are drawn
+void PBRRenderSystem::renderPerObject(
+    const FrameInfo& frameInfo, const GraphicsPipeline& pipeline, bool depthOnly, std::size_t first, std::size_t count
+) const
+{
+    if(count == 0)
+        return;
+
+    pipeline.bind(frameInfo.commandBuffer);
+
+    // NOTE: bind global descriptor (set 0; view and projection)
     vkCmdBindDescriptorSets(
         frameInfo.commandBuffer,
         VK_PIPELINE_BIND_POINT_GRAPHICS,
@@ -55,14 +198,27 @@ void PBRRenderSystem::render(const FrameInfo& frameInfo) const
         0,
         nullptr
     );
+    // NOTE: bind material table (set 1; parameters and textures of every material)
+    m_materialTable->bind(frameInfo.commandBuffer, m_graphicsPipelineLayout, 1);
+    // NOTE: bind light descriptor (set 3; point lights binned into clusters)
+    vkCmdBindDescriptorSets(
+        frameInfo.commandBuffer,
+        VK_PIPELINE_BIND_POINT_GRAPHICS,
+        m_graphicsPipelineLayout,
+        3,
+        1,
+        &frameInfo.lightDescriptorSet,
+        0,
+        nullptr
+    );
 
-    for(auto& [id, obj] : *frameInfo.objects)
+    const Material* boundMaterial{ nullptr };
+    const Model* boundModel{ nullptr };
+    for(std::size_t i{ first }; i < first + count; ++i)
     {
-        if(!obj.hasComponent<ModelComponent>())
-            continue;
-
-        const auto* transform{ obj.getComponent<TransformComponent>() };
-        SimplePushConstantData modelPush{ .modelMatrix = transform->mat4(), .normalMatrix = transform->normalMatrix() };
+        const auto& item{ m_drawItems[i] };
+        SimplePushConstantData modelPush{ .modelMatrix = item.transform->mat4(),
+                                          .normalMatrix = item.transform->normalMatrix() };
 
         vkCmdPushConstants(
             frameInfo.commandBuffer,
@@ -73,18 +229,433 @@ void PBRRenderSystem::render(const FrameInfo& frameInfo) const
             &modelPush
         );
 
-        // NOTE: bind material descriptor (set 1; material textures) and push material factors
-        obj.getComponent<MaterialComponent>()->material->bind(frameInfo.commandBuffer, m_graphicsPipelineLayout);
+        // NOTE: push the material index. The draws are sorted by material and model, so only changes have to be bound
+        if(!depthOnly && item.material != boundMaterial)
+        {
+            item.material->bind(frameInfo.commandBuffer, m_graphicsPipelineLayout);
+            boundMaterial = item.material;
+        }
+
+        if(item.model != boundModel)
+        {
+            if(depthOnly)
+                item.model->bindPositions(frameInfo.commandBuffer);
+            else
+                item.model->bind(frameInfo.commandBuffer);
+            boundModel = item.model;
+        }
 
-        const auto* model{ obj.getComponent<ModelComponent>()->model.get() };
-        model->bind(frameInfo.commandBuffer);
-        model->draw(frameInfo.commandBuffer);
+        item.model->draw(frameInfo.commandBuffer);
+    }
+}
+
+/// \brief Record one instanced draw per batch. Per object data is read from the frame's object buffer
+///
+/// In \ref PBRRenderMode::Indirect the draw parameters come from the frame's indirect buffer and in
+/// \ref PBRRenderMode::GpuCulled from the commands that the cull shader wrote, otherwise they are recorded directly
+///
+/// \param frameInfo \ref FrameInfo with data about the current frame
+/// \param pipeline the pipeline the batches are drawn with
+/// \param depthOnly only bind the positions of the models, for the depth prepass
+/// \param first the first batch that is drawn
+/// \param count how many batches are drawn
+void PBRRenderSystem::renderBatched(
+    const FrameInfo& frameInfo, const GraphicsPipeline& pipeline, bool depthOnly, std::size_t first, std::size_t count
+) const
+{
+    if(count == 0)
+        return;
+
+    const auto& frame{ m_frames[frameInfo.frameIndex] };
+
+    pipeline.bind(frameInfo.commandBuffer);
+
+    // NOTE: bind global descriptor (set 0; view and projection)
+    vkCmdBindDescriptorSets(
+        frameInfo.commandBuffer,
+        VK_PIPELINE_BIND_POINT_GRAPHICS,
+        m_graphicsPipelineLayout,
+        0,
+        1,
+        &frameInfo.globalDescriptorSet,
+        0,
+        nullptr
+    );
+    // NOTE: bind material table (set 1; parameters and textures of every material)
+    m_materialTable->bind(frameInfo.commandBuffer, m_graphicsPipelineLayout, 1);
+    // NOTE: bind light descriptor (set 3; point lights binned into clusters)
+    vkCmdBindDescriptorSets(
+        frameInfo.commandBuffer,
+        VK_PIPELINE_BIND_POINT_GRAPHICS,
+        m_graphicsPipelineLayout,
+        3,
+        1,
+        &frameInfo.lightDescriptorSet,
+        0,
+        nullptr
+    );
+    // NOTE: bind object descriptor (set 2; per object matrices and material indices)
+    vkCmdBindDescriptorSets(
+        frameInfo.commandBuffer,
+        VK_PIPELINE_BIND_POINT_GRAPHICS,
+        m_graphicsPipelineLayout,
+        2,
+        1,
+        &frame.objectDescriptorSet,
+        0,
+        nullptr
+    );
+
+    const Model* boundModel{ nullptr };
+    for(std::size_t i{ first }; i < first + count; ++i)
+    {
+        const auto& batch{ m_batches[i] };
+
+        // NOTE: materials are read per object from the object buffer, so only the model has to be bound
+        if(batch.model != boundModel)
+        {
+            if(depthOnly)
+                batch.model->bindPositions(frameInfo.commandBuffer);
+            else
+                batch.model->bind(frameInfo.commandBuffer);
+            boundModel = batch.model;
+        }
+
+        drawBatch(frameInfo, i);
+    }
+}
+
+/// \brief Record the draw of a single batch with the draw parameters of the current render mode
+///
+/// \param frameInfo \ref FrameInfo with data about the current frame
+/// \param batchIndex index of the batch in the batches of the current frame
+void PBRRenderSystem::drawBatch(const FrameInfo& frameInfo, std::size_t batchIndex) const
+{
+    const auto& batch{ m_batches[batchIndex] };
+
+    if(m_renderMode == PBRRenderMode::GpuCulled)
+    {
+        batch.model->drawIndirectCount(
+            frameInfo.commandBuffer,
+            m_gpuCuller->getCommandBuffer(frameInfo.frameIndex),
+            GpuCuller::commandOffset(batch.firstInstance),
+            m_gpuCuller->getCountBuffer(frameInfo.frameIndex),
+            GpuCuller::countOffset(static_cast<std::uint32_t>(batchIndex)),
+            batch.instanceCount,
+            static_cast<std::uint32_t>(GpuCuller::COMMAND_STRIDE)
+        );
+    }
+    else if(m_renderMode == PBRRenderMode::Indirect)
+    {
+        batch.model->drawIndirect(
+            frameInfo.commandBuffer,
+            m_frames[frameInfo.frameIndex].indirectBuffer->getBuffer(),
+            batchIndex * sizeof(VkDrawIndexedIndirectCommand)
+        );
+    }
+    else
+        batch.model->draw(frameInfo.commandBuffer, batch.instanceCount, batch.firstInstance);
+}
+
+/// \brief Gather the drawable objects and keep the ones whose bounding sphere intersects the camera frustum
+///
+/// In \ref PBRRenderMode::GpuCulled every object is kept, since the culling happens on the GPU
+///
+/// \param frameInfo \ref FrameInfo with the objects and the camera of the current frame
+void PBRRenderSystem::collectVisibleItems(const FrameInfo& frameInfo)
+{
+    m_candidates.clear();
+    m_culler.clear();
+    m_culler.reserve(frameInfo.objects->size());
+    m_culler.setFrustum(frameInfo.camera->getProjection() * frameInfo.camera->getView());
+
+    for(const auto& [id, obj] : *frameInfo.objects)
+    {
+        const auto* modelComponent{ obj.getComponent<ModelComponent>() };
+        const auto* materialComponent{ obj.getComponent<MaterialComponent>() };
+        const auto* transform{ obj.getComponent<TransformComponent>() };
+        if(modelComponent == nullptr || materialComponent == nullptr || transform == nullptr)
+            continue;
+
+        const BoundingSphere sphere{ modelComponent->model->getBoundingSphere().transformed(transform->mat4()) };
+        m_candidates.push_back(
+            { .model = modelComponent->model.get(),
+              .material = materialComponent->material.get(),
+              .transform = transform,
+              .sphere = sphere }
+        );
+        m_culler.addSphere(sphere);
+    }
+
+    m_drawItems.clear();
+    if(m_renderMode == PBRRenderMode::GpuCulled)
+    {
+        m_drawItems = m_candidates;
+        return;
+    }
+
+    m_culler.cull(m_visible);
+
+    for(const std::uint32_t index : m_visible)
+        m_drawItems.push_back(m_candidates[index]);
+}
+
+/// \brief Order the draw items by pipeline, material, model and distance to the camera
+///
+/// Draws that bind the same state end up next to each other, so the state only has to be bound when it changes and
+/// the batched modes can merge them into one draw. Within the same state the draws are ordered front to back
+///
+/// \param frameInfo \ref FrameInfo with the camera of the current frame
+void PBRRenderSystem::sortDrawItems(const FrameInfo& frameInfo)
+{
+    // NOTE: Every mode draws all items with the same pipeline, the field keeps the order right once that changes
+    const bool perObject{ m_renderMode == PBRRenderMode::PerObject };
+    const std::uint32_t pipelineId{ perObject ? 0u : 1u };
+    const glm::vec3 cameraPosition{ frameInfo.camera->getInverseView()[3] };
+
+    m_sortEntries.clear();
+    m_sortEntries.reserve(m_drawItems.size());
+    for(std::size_t i{ 0 }; i < m_drawItems.size(); ++i)
+    {
+        const auto& item{ m_drawItems[i] };
+        const float distance{ glm::length(item.sphere.center - cameraPosition) };
+        // NOTE: The batched modes select materials in the shader, so objects only have to be grouped by model
+        const std::uint32_t materialId{ perObject ? item.material->getId() : 0u };
+
+        m_sortEntries.push_back(
+            { .key = DrawSortKey::make(
+                  pipelineId, materialId, item.model->getId(), DrawSortKey::depthBucket(distance)
+              ),
+              .index = static_cast<std::uint32_t>(i) }
+        );
+    }
+
+    radixSort(m_sortEntries, m_sortScratch);
+
+    m_sortedItems.clear();
+    m_sortedItems.reserve(m_drawItems.size());
+    for(const auto& entry : m_sortEntries)
+        m_sortedItems.push_back(m_drawItems[entry.index]);
+    m_drawItems.swap(m_sortedItems);
+}
+
+/// \brief Count the binds that the visible items would need if they were drawn in scene order
+///
+/// Only the binds that the current mode issues are counted, the batched modes never bind materials and start a new
+/// batch whenever the model changes. Has to be called before the items are sorted
+///
+/// \returns how many materials and models would be bound
+std::uint32_t PBRRenderSystem::countUnsortedBinds() const
+{
+    const bool perObject{ m_renderMode == PBRRenderMode::PerObject };
+    const Material* boundMaterial{ nullptr };
+    const Model* boundModel{ nullptr };
+    std::uint32_t binds{ 0 };
+
+    for(const auto& item : m_drawItems)
+    {
+        if(perObject && item.material != boundMaterial)
+        {
+            ++binds;
+            boundMaterial = item.material;
+        }
+
+        if(item.model != boundModel)
+        {
+            ++binds;
+            boundModel = item.model;
+        }
+    }
+
+    return binds;
+}
+
+/// \brief Count the material and model binds that the recorded draws need and how many sorting saved
+///
+/// The batched modes never bind materials
+///
+/// \param unsortedBinds the binds that drawing the items in scene order would need, see \ref countUnsortedBinds
+void PBRRenderSystem::countBinds(std::uint32_t unsortedBinds)
+{
+    m_stats.materialBinds = 0;
+    m_stats.modelBinds = 0;
+
+    const Material* boundMaterial{ nullptr };
+    const Model* boundModel{ nullptr };
+    const auto bind{ [this, &boundMaterial, &boundModel](const Material* material, const Model* model) {
+        if(material != boundMaterial)
+        {
+            ++m_stats.materialBinds;
+            boundMaterial = material;
+        }
+
+        if(model != boundModel)
+        {
+            ++m_stats.modelBinds;
+            boundModel = model;
+        }
+    } };
+
+    if(m_renderMode == PBRRenderMode::PerObject)
+    {
+        for(const auto& item : m_drawItems)
+            bind(item.material, item.model);
+    }
+    else
+    {
+        for(const auto& batch : m_batches)
+            bind(nullptr, batch.model);
+    }
+
+    // NOTE: Grouping by material can split up objects of the same model, so sorting does not always save binds
+    const std::uint32_t binds{ m_stats.materialBinds + m_stats.modelBinds };
+    m_stats.bindsSkipped = unsortedBinds > binds ? unsortedBinds - binds : 0;
+}
+
+/// \brief Group the sorted draw items by model and lay out their object data batch by batch
+void PBRRenderSystem::buildBatches()
+{
+    m_objectData.clear();
+    m_batches.clear();
+
+    for(const auto& item : m_drawItems)
+    {
+        if(m_batches.empty() || m_batches.back().model != item.model)
+        {
+            m_batches.push_back(
+                { .model = item.model,
+                  .firstInstance = static_cast<std::uint32_t>(m_objectData.size()),
+                  .instanceCount = 0 }
+            );
+        }
+
+        m_objectData.push_back(
+            { .modelMatrix = item.transform->mat4(),
+              .normalMatrix = item.transform->normalMatrix(),
+              .materialIndex = item.material->getIndex(),
+              .padding = {} }
+        );
+        m_batches.back().instanceCount += 1;
+    }
+}
+
+/// \brief Write one indirect draw command per batch into the frame's indirect buffer
+///
+/// \param frame the resources of the frame that is being recorded
+void PBRRenderSystem::writeIndirectCommands(FrameResources& frame) const
+{
+    for(std::size_t i{ 0 }; i < m_batches.size(); ++i)
+    {
+        const auto& batch{ m_batches[i] };
+        const VkDeviceSize offset{ i * sizeof(VkDrawIndexedIndirectCommand) };
+
+        if(batch.model->hasIndexBuffer())
+        {
+            const VkDrawIndexedIndirectCommand command{ .indexCount = batch.model->indexCount(),
+                                                        .instanceCount = batch.instanceCount,
+                                                        .firstIndex = 0,
+                                                        .vertexOffset = 0,
+                                                        .firstInstance = batch.firstInstance };
+            frame.indirectBuffer->writeToBuffer(command, offset);
+        }
+        else
+        {
+            const VkDrawIndirectCommand command{ .vertexCount = batch.model->vertexCount(),
+                                                 .instanceCount = batch.instanceCount,
+                                                 .firstVertex = 0,
+                                                 .firstInstance = batch.firstInstance };
+            frame.indirectBuffer->writeToBuffer(command, offset);
+        }
+    }
+    frame.indirectBuffer->flush();
+}
+
+/// \brief Upload the bounds and batches of all objects to the \ref GpuCuller and pick up its latest statistics
+///
+/// Every object gets a command slot in its batch, so a batch's commands start at its first instance
+///
+/// \param frameInfo \ref FrameInfo with the camera of the current frame
+void PBRRenderSystem::updateGpuCulling(const FrameInfo& frameInfo)
+{
+    m_cullObjects.clear();
+    m_cullBatches.clear();
+
+    for(std::size_t i{ 0 }; i < m_batches.size(); ++i)
+    {
+        const auto& batch{ m_batches[i] };
+        const bool indexed{ batch.model->hasIndexBuffer() };
+        m_cullBatches.push_back(
+            { .firstCommand = batch.firstInstance,
+              .elementCount = indexed ? batch.model->indexCount() : batch.model->vertexCount(),
+              .indexed = indexed ? 1u : 0u,
+              .padding = 0 }
+        );
+
+        for(std::uint32_t instance{ batch.firstInstance }; instance < batch.firstInstance + batch.instanceCount;
+            ++instance)
+        {
+            const auto& sphere{ m_drawItems[instance].sphere };
+            m_cullObjects.push_back(
+                { .sphere = glm::vec4{ sphere.center, sphere.radius },
+                  .batch = static_cast<std::uint32_t>(i),
+                  .padding = {} }
+            );
+        }
+    }
+
+    m_gpuCuller->update(
+        frameInfo.frameIndex,
+        m_cullObjects,
+        m_cullBatches,
+        frameInfo.camera->getProjection() * frameInfo.camera->getView()
+    );
+
+    const auto& stats{ m_gpuCuller->getStats() };
+    m_stats.visibleObjects = stats.visible;
+    m_stats.occlusionCulled = stats.occlusionCulled;
+}
+
+/// \brief Make sure that the buffers of a frame are big enough, recreate them with more capacity if not
+///
+/// The frame's previous submission has already finished when this is called, so its buffers can be replaced
+///
+/// \param frame the resources of the frame that is being recorded
+/// \param objectCount how many objects are drawn
+/// \param batchCount how many draw commands are recorded
+void PBRRenderSystem::reserveFrameResources(FrameResources& frame, std::uint32_t objectCount, std::uint32_t batchCount)
+{
+    if(objectCount > frame.objectCapacity || frame.objectBuffer == nullptr)
+    {
+        frame.objectCapacity = std::max(std::bit_ceil(objectCount), MIN_BUFFER_CAPACITY);
+        frame.objectBuffer = std::make_unique<Buffer>(
+            Buffer::createHostStorageBuffer(device, sizeof(ObjectData), frame.objectCapacity)
+        );
+
+        auto bufferInfo{ frame.objectBuffer->descriptorInfo() };
+        DescriptorWriter writer{ m_objectSetLayout.get(), m_objectPool.get() };
+        writer.writeBuffer(0, &bufferInfo);
+
+        if(frame.objectDescriptorSet == VK_NULL_HANDLE)
+        {
+            if(!writer.build(frame.objectDescriptorSet))
+                throw Exception("Failed to allocate object descriptor set");
+        }
+        else
+            writer.overwrite(frame.objectDescriptorSet);
+    }
+
+    if(batchCount > frame.batchCapacity || frame.indirectBuffer == nullptr)
+    {
+        frame.batchCapacity = std::max(std::bit_ceil(batchCount), MIN_BUFFER_CAPACITY);
+        frame.indirectBuffer = std::make_unique<Buffer>(
+            Buffer::createIndirectBuffer(device, sizeof(VkDrawIndexedIndirectCommand), frame.batchCapacity)
+        );
     }
 }
 
 void PBRRenderSystem::createGraphicsPipelineLayout(VkDescriptorSetLayout globalSetLayout)
 {
-    // NOTE: These push constants conatin the model and normal matrix
+    // NOTE: These push constants conatin the model and normal matrix, followed by the material index
     constexpr VkPushConstantRange pushConstantRange{
         .stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
         .offset = 0,
@@ -94,7 +665,9 @@ void PBRRenderSystem::createGraphicsPipelineLayout(VkDescriptorSetLayout globalS
     std::vector<VkPushConstantRange> pushConstantRanges{ pushConstantRange };
 
     std::vector<VkDescriptorSetLayout> descriptorSetLayouts{ globalSetLayout,
-                                                             m_materialSetLayout->getDescriptorLayout() };
+                                                             m_materialTable->getSetLayout()->getDescriptorLayout(),
+                                                             m_objectSetLayout->getDescriptorLayout(),
+                                                             m_lightSetLayout };
 
     VkPipelineLayoutCreateInfo layoutCI{};
     layoutCI.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
@@ -125,6 +698,31 @@ void PBRRenderSystem::createGraphicsPipeline(
 
     m_graphicsPipeline
         = std::make_unique<GraphicsPipeline>(device, vertexShaderPath, fragmentShaderPath, pipelineConfig);
+    m_instancedPipeline = std::make_unique<GraphicsPipeline>(
+        device, PBR_INSTANCED_VERTEX_SHADER_PATH, fragmentShaderPath, pipelineConfig
+    );
+
+    // NOTE: After the prepass only the closest surface of a pixel passes the depth test, the depth is already final
+    pipelineConfig.depthStencilInfo.depthCompareOp = VK_COMPARE_OP_EQUAL;
+    pipelineConfig.depthStencilInfo.depthWriteEnable = VK_FALSE;
+    m_equalPipeline
+        = std::make_unique<GraphicsPipeline>(device, vertexShaderPath, fragmentShaderPath, pipelineConfig);
+    m_equalInstancedPipeline = std::make_unique<GraphicsPipeline>(
+        device, PBR_INSTANCED_VERTEX_SHADER_PATH, fragmentShaderPath, pipelineConfig
+    );
+
+    GraphicsPipelineConfigInfo depthConfig{};
+    GraphicsPipeline::defaultGraphicsPipelineConfigInfo(depthConfig);
+    depthConfig.bindingDescription = Model::Vertex::getPositionBindingDescriptions();
+    depthConfig.attributeDescription = Model::Vertex::getPositionAttributeDescriptions();
+    depthConfig.colorBlendAttachment.colorWriteMask = 0;
+    depthConfig.renderPass = renderPass;
+    depthConfig.pipelineLayout = m_graphicsPipelineLayout;
+
+    m_depthPipeline = std::make_unique<GraphicsPipeline>(device, DEPTH_PREPASS_VERTEX_SHADER_PATH, "", depthConfig);
+    m_depthInstancedPipeline = std::make_unique<GraphicsPipeline>(
+        device, DEPTH_PREPASS_INSTANCED_VERTEX_SHADER_PATH, "", depthConfig
+    );
 }
 
 } // namespace vv
@@ -1,19 +1,78 @@
 #ifndef VULKAN_VOXELS_SRC_ENGINE_RENDER_SYSTEMS_PBR_RENDER_SYSTEM_HPP
 #define VULKAN_VOXELS_SRC_ENGINE_RENDER_SYSTEMS_PBR_RENDER_SYSTEM_HPP
 
+#include "core/Buffer.hpp"
+#include "core/DepthPyramid.hpp"
+#include "core/DescriptorPool.hpp"
 #include "core/DescriptorSetLayout.hpp"
 #include "core/Device.hpp"
+#include "core/GpuCuller.hpp"
+#include "core/GraphicsPipeline.hpp"
 #include "renderSystems/IRenderSystem.hpp"
+#include "utility/Bounds.hpp"
+#include "utility/DrawSort.hpp"
 #include "utility/FrameInfo.hpp"
+#include "utility/FrustumCuller.hpp"
+#include "utility/Model.hpp"
+#include "utility/material/Material.hpp"
+#include "utility/material/MaterialTable.hpp"
+#include "utility/object/Object.hpp"
+#include "utility/object/components/TransformComponent.hpp"
 
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include "glm/glm.hpp"
 #include <vulkan/vulkan_core.h>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <vector>
 
 namespace vv
 {
 
+/// \brief How the \ref PBRRenderSystem records its draws
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+enum class PBRRenderMode : std::uint8_t
+{
+    PerObject, ///< One draw per object, matrices are pushed as push constants
+    Instanced, ///< One instanced draw per model batch, matrices are read from the object buffer
+    Indirect,  ///< Like Instanced, but each batch's draw parameters are read from an indirect buffer
+    GpuCulled, ///< Like Indirect, but a compute shader culls the objects and writes the draw commands
+};
+
+/// \brief Draw call statistics of the last frame recorded by the \ref PBRRenderSystem
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct PBRRenderStats
+{
+    std::uint32_t objects{ 0 };         ///< Drawable objects in the scene
+    std::uint32_t visibleObjects{ 0 };  ///< Objects that survived culling, i.e., the draws without batching
+    std::uint32_t occlusionCulled{ 0 }; ///< Objects hidden behind the previous frame's depth (GPU culling only)
+    std::uint32_t drawCalls{ 0 };       ///< Draws that were actually recorded
+    std::uint32_t materialBinds{ 0 };   ///< Material indices that were pushed (per object mode only)
+    std::uint32_t modelBinds{ 0 };      ///< Vertex and index buffers that were bound
+    std::uint32_t bindsSkipped{ 0 };    ///< Binds that drawing in scene order would have needed on top of these
+};
+
+/// \brief Per object data that the batched paths store in a storage buffer instead of pushing it per draw
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct ObjectData
+{
+    glm::mat4 modelMatrix{ 1.f };
+    glm::mat4 normalMatrix{ 1.f };
+    std::uint32_t materialIndex{ 0 }; ///< Index of the object's material in the \ref MaterialTable
+    std::array<std::uint32_t, 3> padding{};
+};
+
 /// \brief Render system that can render voxelized meshes
 ///
 /// \author Felix Hommel
@@ -26,8 +85,14 @@ public:
     /// \param device the \ref Device used to create pipelines
     /// \param renderPass which render pass to use for the graphics pipeline
     /// \param globalSetLayout layout of the global descriptor set
-    explicit PBRRenderSystem(
-        std::shared_ptr<Device> device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout
+    /// \param lightSetLayout layout of the clustered light set of the \ref LightClusterer
+    /// \param framesInFlight how many frames are recorded ahead of the GPU
+    PBRRenderSystem(
+        std::shared_ptr<Device> device,
+        VkRenderPass renderPass,
+        VkDescriptorSetLayout globalSetLayout,
+        VkDescriptorSetLayout lightSetLayout,
+        std::uint32_t framesInFlight
     );
     ~PBRRenderSystem() override;
 
@@ -36,20 +101,164 @@ public:
     PBRRenderSystem& operator=(const PBRRenderSystem&) = delete;
     PBRRenderSystem& operator=(PBRRenderSystem&&) = delete;
 
-    [[nodiscard]] std::shared_ptr<DescriptorSetLayout> getMaterialSetLayout() const noexcept
-    {
-        return m_materialSetLayout;
-    }
+    [[nodiscard]] std::shared_ptr<MaterialTable> getMaterialTable() const noexcept { return m_materialTable; }
+
+    [[nodiscard]] PBRRenderMode getRenderMode() const noexcept { return m_renderMode; }
+    [[nodiscard]] const PBRRenderStats& getStats() const noexcept { return m_stats; }
+    /// \brief The culler of \ref PBRRenderMode::GpuCulled, nullptr if the mode was never used
+    [[nodiscard]] const GpuCuller* getGpuCuller() const noexcept { return m_gpuCuller.get(); }
+    /// \brief Choose how draws are recorded
+    ///
+    /// The batched modes group objects that share a model and draw each group with a single instanced draw, which
+    /// makes the recording cost independent of the object count. Materials are selected per object in the shader.
+    /// \ref PBRRenderMode::Indirect requires the drawIndirectFirstInstance feature and falls back to
+    /// \ref PBRRenderMode::Instanced if it is not supported. \ref PBRRenderMode::GpuCulled additionally requires
+    /// drawIndirectCount and falls back to \ref PBRRenderMode::Indirect. Its statistics lag behind by the number of
+    /// frames in flight. Both indirect modes still record one indirect draw per model, since every model owns its own
+    /// vertex and index buffers the draws can not be merged into a single multi-draw
+    ///
+    /// \param mode the \ref PBRRenderMode to use from the next frame on
+    void setRenderMode(PBRRenderMode mode);
+    [[nodiscard]] bool hasDepthPrepass() const noexcept { return m_depthPrepass; }
+    /// \brief Choose whether the depth of the objects is laid down by \ref renderDepthPrepass before they are shaded
+    ///
+    /// With the prepass the shading pipelines test with VK_COMPARE_OP_EQUAL and do not write depth, so every pixel
+    /// is shaded exactly once no matter in which order the objects are drawn
+    ///
+    /// \param enabled whether the prepass is recorded from the next frame on
+    void setDepthPrepass(bool enabled) noexcept { m_depthPrepass = enabled; }
 
+    /// \brief Cull the objects against the camera frustum and write the object data and draw commands of the batched
+    /// modes for the current frame
+    ///
+    /// \param frameInfo \ref FrameInfo important frame related data
+    void update(FrameInfo& frameInfo, GlobalUBO& ubo) override;
+    /// \brief Record the GPU culling pass of \ref PBRRenderMode::GpuCulled, does nothing in the other modes
+    ///
+    /// Has to be recorded after \ref update and outside of the render pass in which \ref render is recorded
+    ///
+    /// \param frameInfo \ref FrameInfo with data about the current frame
+    /// \param depthPyramid the \ref DepthPyramid of the previous frame that is used for occlusion culling
+    void cull(const FrameInfo& frameInfo, const DepthPyramid& depthPyramid);
+    /// \brief Write only the depth of the objects, does nothing if the depth prepass is disabled
+    ///
+    /// Has to be recorded in the same render pass as, and before, \ref render
+    ///
+    /// \param frameInfo \ref FrameInfo with data about the current frame
+    void renderDepthPrepass(const FrameInfo& frameInfo) const;
+    /// \brief Write only the depth of a range of the draws, see \ref getDrawCount
+    ///
+    /// Ranges can be recorded into different secondary command buffers from different threads at once
+    ///
+    /// \param frameInfo \ref FrameInfo with the command buffer that records the range
+    /// \param first the first draw of the range
+    /// \param count how many draws the range contains
+    void renderDepthPrepass(const FrameInfo& frameInfo, std::size_t first, std::size_t count) const;
     /// \brief Render voxelized meshes
     ///
     /// \param frameInfo \ref FrameInfo with data about the current frame
     void render(const FrameInfo& frameInfo) const override;
+    /// \brief Render a range of the draws, see \ref getDrawCount
+    ///
+    /// Ranges can be recorded into different secondary command buffers from different threads at once
+    ///
+    /// \param frameInfo \ref FrameInfo with the command buffer that records the range
+    /// \param first the first draw of the range
+    /// \param count how many draws the range contains
+    void render(const FrameInfo& frameInfo, std::size_t first, std::size_t count) const;
+    /// \brief How many draws \ref render records in the current frame, i.e., objects in \ref PBRRenderMode::PerObject
+    /// and batches in the other modes
+    [[nodiscard]] std::size_t getDrawCount() const noexcept;
 
 private:
     static constexpr auto PBR_VERTEX_SHADER_PATH{ PROJECT_ROOT "resources/compiledShaders/pbrVert.spv" };
+    static constexpr auto PBR_INSTANCED_VERTEX_SHADER_PATH{ PROJECT_ROOT
+                                                            "resources/compiledShaders/pbrInstancedVert.spv" };
     static constexpr auto PBR_FRAGMENT_SHADER_PATH{ PROJECT_ROOT "resources/compiledShaders/pbrFrag.spv" };
-    std::shared_ptr<DescriptorSetLayout> m_materialSetLayout;
+    static constexpr auto DEPTH_PREPASS_VERTEX_SHADER_PATH{ PROJECT_ROOT
+                                                            "resources/compiledShaders/depthPrepassVert.spv" };
+    static constexpr auto DEPTH_PREPASS_INSTANCED_VERTEX_SHADER_PATH{
+        PROJECT_ROOT "resources/compiledShaders/depthPrepassInstancedVert.spv"
+    };
+    static constexpr std::uint32_t MIN_BUFFER_CAPACITY{ 64 };
+
+    /// \brief Objects that share a model and are therefore drawn by a single draw command
+    struct DrawBatch
+    {
+        Model* model{ nullptr };
+        std::uint32_t firstInstance{ 0 };
+        std::uint32_t instanceCount{ 0 };
+    };
+
+    /// \brief A visible object that is going to be drawn, before it is sorted into its batch
+    struct DrawItem
+    {
+        Model* model{ nullptr };
+        Material* material{ nullptr };
+        const TransformComponent* transform{ nullptr };
+        BoundingSphere sphere{}; ///< World space bounds
+    };
+
+    /// \brief Resources of the batched modes that exist once per frame in flight
+    struct FrameResources
+    {
+        std::unique_ptr<Buffer> objectBuffer;
+        std::unique_ptr<Buffer> indirectBuffer;
+        VkDescriptorSet objectDescriptorSet{ VK_NULL_HANDLE };
+        std::uint32_t objectCapacity{ 0 };
+        std::uint32_t batchCapacity{ 0 };
+    };
+
+    std::shared_ptr<MaterialTable> m_materialTable;
+    VkDescriptorSetLayout m_lightSetLayout{ VK_NULL_HANDLE }; ///< Owned by the \ref LightClusterer
+    std::shared_ptr<DescriptorSetLayout> m_objectSetLayout;
+    std::unique_ptr<DescriptorPool> m_objectPool;
+    std::unique_ptr<GraphicsPipeline> m_instancedPipeline;
+    std::unique_ptr<GraphicsPipeline> m_depthPipeline;          ///< Position only, without a fragment stage
+    std::unique_ptr<GraphicsPipeline> m_depthInstancedPipeline; ///< Position only, without a fragment stage
+    std::unique_ptr<GraphicsPipeline> m_equalPipeline;          ///< Shades on top of the prepass depth
+    std::unique_ptr<GraphicsPipeline> m_equalInstancedPipeline; ///< Shades on top of the prepass depth
+
+    std::vector<FrameResources> m_frames;
+    FrustumCuller m_culler;
+    std::vector<DrawItem> m_candidates;
+    std::vector<std::uint32_t> m_visible;
+    std::vector<DrawItem> m_drawItems;
+    std::vector<DrawItem> m_sortedItems;
+    std::vector<DrawSortEntry> m_sortEntries;
+    std::vector<DrawSortEntry> m_sortScratch;
+    std::vector<ObjectData> m_objectData;
+    std::vector<DrawBatch> m_batches;
+    std::unique_ptr<GpuCuller> m_gpuCuller;
+    std::vector<GpuCullObject> m_cullObjects;
+    std::vector<GpuCullBatch> m_cullBatches;
+    PBRRenderMode m_renderMode{ PBRRenderMode::PerObject };
+    bool m_depthPrepass{ false };
+    PBRRenderStats m_stats;
+
+    void renderPerObject(
+        const FrameInfo& frameInfo,
+        const GraphicsPipeline& pipeline,
+        bool depthOnly,
+        std::size_t first,
+        std::size_t count
+    ) const;
+    void renderBatched(
+        const FrameInfo& frameInfo,
+        const GraphicsPipeline& pipeline,
+        bool depthOnly,
+        std::size_t first,
+        std::size_t count
+    ) const;
+    void drawBatch(const FrameInfo& frameInfo, std::size_t batchIndex) const;
+    void collectVisibleItems(const FrameInfo& frameInfo);
+    void sortDrawItems(const FrameInfo& frameInfo);
+    [[nodiscard]] std::uint32_t countUnsortedBinds() const;
+    void countBinds(std::uint32_t unsortedBinds);
+    void buildBatches();
+    void writeIndirectCommands(FrameResources& frame) const;
+    void updateGpuCulling(const FrameInfo& frameInfo);
+    void reserveFrameResources(FrameResources& frame, std::uint32_t objectCount, std::uint32_t batchCount);
 
     void createGraphicsPipelineLayout(VkDescriptorSetLayout globalSetLayout) override;
     void createGraphicsPipeline(
@@ -1,9 +1,14 @@
 #include "PointLightRenderSystem.hpp"
 
+#include "core/Buffer.hpp"
+#include "core/DescriptorPool.hpp"
+#include "core/DescriptorSetLayout.hpp"
+#include "core/DescriptorWriter.hpp"
 #include "core/Device.hpp"
 #include "core/GraphicsPipeline.hpp"
 #include "renderSystems/IRenderSystem.hpp"
 #include "utility/FrameInfo.hpp"
+#include "utility/exceptions/Exception.hpp"
 #include "utility/object/components/PointLightComponent.hpp"
 #include "utility/object/components/TransformComponent.hpp"
 
@@ -13,8 +18,11 @@
 #include "glm/gtc/matrix_transform.hpp"
 #include <vulkan/vulkan_core.h>
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
-#include <cstddef>
+#include <cmath>
 #include <cstdint>
 #include <memory>
 #include <ranges>
@@ -26,9 +34,20 @@ namespace vv
 {
 
 PointLightRenderSystem::PointLightRenderSystem(
-    std::shared_ptr<Device> device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout
+    std::shared_ptr<Device> device,
+    VkRenderPass renderPass,
+    VkDescriptorSetLayout globalSetLayout,
+    std::uint32_t framesInFlight
 )
     : IRenderSystem(std::move(device))
+    , m_instanceSetLayout{ DescriptorSetLayout::Builder(this->device)
+                               .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT)
+                               .buildShared() }
+    , m_instancePool{ DescriptorPool::Builder(this->device)
+                          .setMaxSets(framesInFlight)
+                          .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, framesInFlight)
+                          .build() }
+    , m_frames(framesInFlight)
 {
     createGraphicsPipelineLayout(globalSetLayout);
     createGraphicsPipeline(renderPass, VERTEX_SHADER_PATH, FRAGMENT_SHADER_PATH);
@@ -39,89 +58,112 @@ PointLightRenderSystem::~PointLightRenderSystem()
     vkDestroyPipelineLayout(device->device(), m_graphicsPipelineLayout, nullptr);
 }
 
-void PointLightRenderSystem::update(FrameInfo& frameInfo, GlobalUBO& ubo)
+void PointLightRenderSystem::update(FrameInfo& frameInfo, [[maybe_unused]] GlobalUBO& ubo)
 {
     constexpr float ROTATE_FACTOR{ 0.5f };
     const auto rotateLight{ glm::rotate(glm::mat4(1.f), ROTATE_FACTOR * frameInfo.dt, { 0.f, -1.f, 0.f }) };
-    std::size_t lightIndex{ 0 };
+    m_lights.clear();
+    m_lights.reserve(frameInfo.lights.size());
+    m_instances.clear();
+    m_instances.reserve(frameInfo.lights.size());
     for(auto& obj : frameInfo.lights)
     {
         if(!obj.hasComponent<PointLightComponent>() || !obj.hasComponent<TransformComponent>())
             continue;
 
-#if defined(VV_ENABLE_ASSERTS)
-        assert(lightIndex < MAX_LIGHTS && "Point lights exceed the allowed maximum");
-#endif
-
         // NOTE: Rotate the light
         // obj.getComponent<TransformComponent>()->translation
         //     = glm::vec3(rotateLight * glm::vec4(obj.getComponent<TransformComponent>()->translation, 1.f));
 
-        // NOTE: Write the information about the light into the UBO
-        ubo.pointLights.at(lightIndex).position = glm::vec4(obj.getComponent<TransformComponent>()->translation, 1.f);
-        ubo.pointLights.at(lightIndex).color = glm::vec4(
-            obj.getComponent<PointLightComponent>()->color, obj.getComponent<PointLightComponent>()->intensity
+        // NOTE: The light falls off with 1 / d^2, so it drops below the cutoff at d = sqrt(intensity / cutoff)
+        const auto* light{ obj.getComponent<PointLightComponent>() };
+        const glm::vec3& position{ obj.getComponent<TransformComponent>()->translation };
+        const float range{ std::sqrt(light->intensity / LIGHT_CUTOFF_INTENSITY) };
+        m_lights.push_back(
+            { .position = glm::vec4(position, range), .color = glm::vec4(light->color, light->intensity) }
+        );
+        m_instances.push_back(
+            { .position = glm::vec4(position, light->radius), .color = glm::vec4(light->color, light->intensity) }
         );
-
-        lightIndex += 1;
     }
-    ubo.numLights = static_cast<int>(lightIndex);
+
+    auto& frame{ m_frames[frameInfo.frameIndex] };
+    frame.instanceCount = static_cast<std::uint32_t>(m_instances.size());
+    reserveInstances(frame, frame.instanceCount);
+
+    if(m_instances.empty())
+        return;
+
+    frame.instanceBuffer->writeToBuffer(m_instances);
+    frame.instanceBuffer->flush();
 }
 
 void PointLightRenderSystem::render(const FrameInfo& frameInfo) const
 {
+    const auto& frame{ m_frames[frameInfo.frameIndex] };
+    if(frame.instanceCount == 0)
+        return;
+
     m_graphicsPipeline->bind(frameInfo.commandBuffer);
 
+    // NOTE: bind global descriptor (set 0; view and projection) and the lights of the frame (set 1)
+    const std::array<VkDescriptorSet, 2> descriptorSets{ frameInfo.globalDescriptorSet, frame.instanceDescriptorSet };
     vkCmdBindDescriptorSets(
         frameInfo.commandBuffer,
         VK_PIPELINE_BIND_POINT_GRAPHICS,
         m_graphicsPipelineLayout,
         0,
-        1,
-        &frameInfo.globalDescriptorSet,
+        static_cast<std::uint32_t>(descriptorSets.size()),
+        descriptorSets.data(),
         0,
         nullptr
     );
 
-    for(auto& obj : frameInfo.lights)
-    {
-        if(!obj.hasComponent<PointLightComponent>() || !obj.hasComponent<TransformComponent>())
-            continue;
+    // NOTE: The billboard corners come from the vertex index and the light from the instance index
+    vkCmdDraw(frameInfo.commandBuffer, squareVertexCount, frame.instanceCount, 0, 0);
+}
 
-        PointLightPushConstants push{ .position = glm::vec4(obj.getComponent<TransformComponent>()->translation, 1.f),
-                                      .color = glm::vec4(
-                                          obj.getComponent<PointLightComponent>()->color,
-                                          obj.getComponent<PointLightComponent>()->intensity
-                                      ),
-                                      .radius = obj.getComponent<PointLightComponent>()->radius };
-
-        vkCmdPushConstants(
-            frameInfo.commandBuffer,
-            m_graphicsPipelineLayout,
-            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-            0,
-            sizeof(PointLightPushConstants),
-            &push
-        );
+/// \brief Make sure that the instance buffer of a frame is big enough, recreate it with more capacity if not
+///
+/// The frame's previous submission has already finished when this is called, so its buffer can be replaced
+///
+/// \param frame the resources of the frame that is being recorded
+/// \param instanceCount how many billboards are drawn
+void PointLightRenderSystem::reserveInstances(FrameResources& frame, std::uint32_t instanceCount)
+{
+    if(instanceCount <= frame.instanceCapacity && frame.instanceBuffer != nullptr)
+        return;
+
+    frame.instanceCapacity = std::max(std::bit_ceil(instanceCount), MIN_INSTANCE_CAPACITY);
+    frame.instanceBuffer = std::make_unique<Buffer>(
+        Buffer::createHostStorageBuffer(device, sizeof(PointLightInstance), frame.instanceCapacity)
+    );
 
-        vkCmdDraw(frameInfo.commandBuffer, squareVertexCount, 1, 0, 0);
+    auto bufferInfo{ frame.instanceBuffer->descriptorInfo() };
+    DescriptorWriter writer{ m_instanceSetLayout.get(), m_instancePool.get() };
+    writer.writeBuffer(0, &bufferInfo);
+
+    if(frame.instanceDescriptorSet == VK_NULL_HANDLE)
+    {
+        if(!writer.build(frame.instanceDescriptorSet))
+            throw Exception("Failed to allocate point light descriptor set");
     }
+    else
+        writer.overwrite(frame.instanceDescriptorSet);
 }
 
 /// \brief Create a PipelineLayout that can be used to create a Pipeline
 void PointLightRenderSystem::createGraphicsPipelineLayout(VkDescriptorSetLayout globalSetLayout)
 {
-    VkPushConstantRange pushConstantRange{ .stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                                           .offset = 0,
-                                           .size = sizeof(PointLightPushConstants) };
-    std::vector<VkDescriptorSetLayout> descriptorSetLayouts{ globalSetLayout };
+    std::vector<VkDescriptorSetLayout> descriptorSetLayouts{ globalSetLayout,
+                                                             m_instanceSetLayout->getDescriptorLayout() };
 
     VkPipelineLayoutCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     createInfo.setLayoutCount = static_cast<std::uint32_t>(descriptorSetLayouts.size());
     createInfo.pSetLayouts = descriptorSetLayouts.data();
-    createInfo.pushConstantRangeCount = 1;
-    createInfo.pPushConstantRanges = &pushConstantRange;
+    createInfo.pushConstantRangeCount = 0;
+    createInfo.pPushConstantRanges = nullptr;
 
     if(vkCreatePipelineLayout(device->device(), &createInfo, nullptr, &m_graphicsPipelineLayout) != VK_SUCCESS)
         throw std::runtime_error("failed to create pipeline layout");
@@ -1,6 +1,9 @@
 #ifndef VULKAN_VOXELS_SRC_ENGINE_RENDER_SYSTEMS_POINT_LIGHT_RENDER_SYSTEM_HPP
 #define VULKAN_VOXELS_SRC_ENGINE_RENDER_SYSTEMS_POINT_LIGHT_RENDER_SYSTEM_HPP
 
+#include "core/Buffer.hpp"
+#include "core/DescriptorPool.hpp"
+#include "core/DescriptorSetLayout.hpp"
 #include "core/Device.hpp"
 #include "renderSystems/IRenderSystem.hpp"
 #include "utility/FrameInfo.hpp"
@@ -13,23 +16,27 @@
 #include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <span>
+#include <vector>
 
 namespace vv
 {
 
-/// \brief Push constant definition for point lights
+/// \brief Per light data of the billboards, matches the std430 layout of the point light shaders
 ///
 /// \author Felix Hommel
 /// \date 11/28/2025
-struct PointLightPushConstants
+struct PointLightInstance
 {
-    glm::vec4 position{};
-    glm::vec4 color{};
-    float radius;
+    glm::vec4 position{}; ///< xyz = world space position, w = radius of the billboard
+    glm::vec4 color{};    ///< rgb = color, w = intensity
 };
 
 /// \brief Render System to render point lights in a billboard style
 ///
+/// The billboards of all lights are drawn with a single instanced draw that reads the lights from a per frame storage
+/// buffer
+///
 /// \author Felix Hommel
 /// \date 11/27/2025
 class PointLightRenderSystem final : public IRenderSystem
@@ -40,8 +47,12 @@ public:
     /// \param device \ref Device to create the \ref Pipeline on
     /// \param renderPass Which RenderPass to use in the pipeline
     /// \param globalSetLayout the layout of globally used descriptor sets
+    /// \param framesInFlight how many frames are recorded ahead of the GPU
     PointLightRenderSystem(
-        std::shared_ptr<Device> device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout
+        std::shared_ptr<Device> device,
+        VkRenderPass renderPass,
+        VkDescriptorSetLayout globalSetLayout,
+        std::uint32_t framesInFlight
     );
     ~PointLightRenderSystem() override;
 
@@ -50,12 +61,15 @@ public:
     PointLightRenderSystem& operator=(const PointLightRenderSystem&) = delete;
     PointLightRenderSystem& operator=(PointLightRenderSystem&&) = delete;
 
+    /// \brief Lights of the last update, ready to be binned by the \ref LightClusterer
+    [[nodiscard]] std::span<const PointLight> getLights() const noexcept { return m_lights; }
+
     /// \brief Update the point lights
     ///
     /// \param frameInfo \ref FrameInfo important frame related data
     void update(FrameInfo& frameInfo, GlobalUBO& ubo) override;
 
-    /// \brief Render a point light
+    /// \brief Render the billboards of all point lights
     ///
     /// \param frameInfo \ref FrameInfo with data about the current frame
     void render(const FrameInfo& frameInfo) const override;
@@ -64,6 +78,27 @@ private:
     static constexpr auto VERTEX_SHADER_PATH{ PROJECT_ROOT "resources/compiledShaders/pointLightVert.spv" };
     static constexpr auto FRAGMENT_SHADER_PATH{ PROJECT_ROOT "resources/compiledShaders/pointLightFrag.spv" };
     static constexpr std::uint32_t squareVertexCount{ 6 };
+    /// \brief Intensity below which a light is cut off, which gives every light a finite range
+    static constexpr float LIGHT_CUTOFF_INTENSITY{ 0.05f };
+    static constexpr std::uint32_t MIN_INSTANCE_CAPACITY{ 64 };
+
+    /// \brief Instance buffer and its descriptor set, exist once per frame in flight
+    struct FrameResources
+    {
+        std::unique_ptr<Buffer> instanceBuffer;
+        VkDescriptorSet instanceDescriptorSet{ VK_NULL_HANDLE };
+        std::uint32_t instanceCapacity{ 0 };
+        std::uint32_t instanceCount{ 0 };
+    };
+
+    std::shared_ptr<DescriptorSetLayout> m_instanceSetLayout;
+    std::unique_ptr<DescriptorPool> m_instancePool;
+    std::vector<FrameResources> m_frames;
+
+    std::vector<PointLight> m_lights;
+    std::vector<PointLightInstance> m_instances;
+
+    void reserveInstances(FrameResources& frame, std::uint32_t instanceCount);
 
     void createGraphicsPipelineLayout(VkDescriptorSetLayout globalSetLayout) override;
     void createGraphicsPipeline(
@@ -39,6 +39,40 @@ VoxelRenderSystem::~VoxelRenderSystem()
 void VoxelRenderSystem::render(const FrameInfo& frameInfo) const
 {
     // TODO: Implement drawing functionality
+
+    // NOTE: Planned temporal reprojection mode for the primary rays
+    // - Trace only a checkerboard (1/2) or one pixel of every 2x2 quad (1/4) per frame, rotating the pattern each frame
+    // - Reconstruct untraced pixels by reprojecting their world position with the previous frame's projection * view
+    //   into the history buffer. This needs the previous GlobalUBO matrices to be kept around per frame
+    // - Reject history if the reprojected uv is off screen, the depth differs too much or the color falls outside of
+    //   the neighbourhood min/max of the traced pixels. Rejected pixels fall back to the nearest traced neighbour
+    // - Each mode is wrapped in its own GpuTimer scope (e.g. "voxel full", "voxel checkerboard") to compare the cost
+
+    // NOTE: Planned beam prepass, dispatched before the full resolution march
+    // - One invocation per 8x8 pixel tile marches a cone that encloses all of the tile's primary rays through the
+    //   coarse occupancy levels and writes the conservative minimum hit distance into an R32F image (1/8 x 1/8
+    //   resolution)
+    // - The full resolution pass starts each ray at the distance of its tile instead of at the near plane
+    // - Both passes count their steps into an atomic counter so the step totals can be compared with the prepass on/off
+
+    // NOTE: Compositing with the rasterized meshes
+    // The raster depth of the current swapchain image is available through Renderer::getCurrentDepthImageView() once
+    // the main render pass has ended. The march converts it to a view distance and stops rays there, and the
+    // composite writes gl_FragDepth from the ray hit so later raster passes depth test against voxels as well
+
+    // NOTE: Planned voxel shadow rays for the PBR lights
+    // - The PBR fragment shader traces a short ray from the fragment towards every light through the occupancy
+    //   volume, switching to its coarse mip levels for distant lights, and scales the light by the result
+    // - A max steps quality setting bounds the march, so the cost per light stays fixed
+    // - The PBR pass runs with shadows on and off under its own GpuTimer scope to compare the cost per light
+
+    // NOTE: Planned instancing of small voxel models
+    // - Instances are objects with a TransformComponent and a (future) voxel volume component referencing a shared
+    //   volume, so props/debris reuse one volume and can move freely instead of being baked into the world grid
+    // - A top level BVH over the instance OBBs is rebuilt every frame on the CPU (binned SAH, subtrees built in
+    //   parallel) and uploaded as an SSBO
+    // - Rays traverse the BVH, intersect the instance OBB and continue marching in the instance's model space using
+    //   the inverse of its model matrix
 }
 
 void VoxelRenderSystem::createComputePipelineLayout()
@@ -0,0 +1,89 @@
+#include "AssetLoader.hpp"
+
+#include "core/Device.hpp"
+#include "core/Texture2D.hpp"
+#include "utility/Model.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace vv
+{
+
+AssetLoader::AssetLoader(std::shared_ptr<Device> device, std::size_t threadCount)
+    : device{ std::move(device) }, m_jobs{ threadCount }
+{}
+
+AssetLoader::Future<Texture2D> AssetLoader::loadTexture(
+    const std::filesystem::path& filepath, const TextureConfig& config
+)
+{
+    return request<Texture2D>([this, filepath, config]() {
+        const auto image{ std::make_shared<DecodedImage>(Texture2D::decodeFile(filepath)) };
+
+        return [this, image, config]() {
+            return std::make_shared<Texture2D>(device, image->width, image->height, config, image->getPixels());
+        };
+    });
+}
+
+AssetLoader::Future<Model> AssetLoader::loadModel(const std::filesystem::path& filepath)
+{
+    return request<Model>([this, filepath]() {
+        const auto builder{ std::make_shared<Model::Builder>() };
+        builder->loadModel(filepath);
+
+        return [this, builder]() { return std::make_shared<Model>(device, *builder); };
+    });
+}
+
+std::size_t AssetLoader::poll()
+{
+    std::deque<Finisher> decoded{};
+    {
+        const std::scoped_lock lock{ m_mutex };
+        decoded.swap(m_decoded);
+    }
+
+    for(const auto& finisher : decoded)
+        finisher();
+
+    m_created += decoded.size();
+
+    return decoded.size();
+}
+
+void AssetLoader::waitIdle()
+{
+    while(getPendingCount() > 0)
+        waitForDecoded();
+}
+
+/// \brief Hand a decoded asset over to the thread that polls
+///
+/// \param finisher creates the asset
+void AssetLoader::pushDecoded(Finisher finisher)
+{
+    {
+        const std::scoped_lock lock{ m_mutex };
+        m_decoded.push_back(std::move(finisher));
+    }
+    m_decodedAvailable.notify_one();
+}
+
+/// \brief Block until at least one asset has been decoded and create every decoded asset
+void AssetLoader::waitForDecoded()
+{
+    {
+        std::unique_lock lock{ m_mutex };
+        m_decodedAvailable.wait(lock, [this]() { return !m_decoded.empty(); });
+    }
+
+    poll();
+}
+
+} // namespace vv
@@ -0,0 +1,150 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_UTILITY_ASSET_LOADER_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_UTILITY_ASSET_LOADER_HPP
+
+#include "core/Device.hpp"
+#include "core/Texture2D.hpp"
+#include "utility/JobQueue.hpp"
+#include "utility/Model.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace vv
+{
+
+/// \brief Decodes textures and parses models on worker threads
+///
+/// Only the CPU work runs on the workers. The GPU resources are created on the thread that calls \ref poll or
+/// \ref get, which hands them to the \ref UploadManager of the \ref Device, since neither is thread safe. Requests
+/// return futures right away, so many files are decoded in parallel while the scene is being built.
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+class AssetLoader
+{
+public:
+    template<typename T>
+    using Future = std::shared_future<std::shared_ptr<T>>;
+
+    /// \brief Create a new \ref AssetLoader
+    ///
+    /// \param device the \ref Device the assets are created on
+    /// \param threadCount how many files are decoded at the same time. At least one
+    AssetLoader(std::shared_ptr<Device> device, std::size_t threadCount);
+    ~AssetLoader() = default;
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader(AssetLoader&&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+    AssetLoader& operator=(AssetLoader&&) = delete;
+
+    [[nodiscard]] std::size_t getThreadCount() const noexcept { return m_jobs.getThreadCount(); }
+    /// \brief How many assets were requested and are not created yet
+    [[nodiscard]] std::size_t getPendingCount() const noexcept { return m_requested - m_created; }
+
+    /// \brief Decode an image file in the background
+    ///
+    /// \param filepath the image file
+    /// \param config \ref TextureConfig of the texture that is created from it
+    ///
+    /// \returns the texture once it has been created by \ref poll or \ref get
+    [[nodiscard]] Future<Texture2D> loadTexture(const std::filesystem::path& filepath, const TextureConfig& config);
+    /// \brief Parse a .obj file in the background
+    ///
+    /// \param filepath the .obj file
+    ///
+    /// \returns the model once it has been created by \ref poll or \ref get
+    [[nodiscard]] Future<Model> loadModel(const std::filesystem::path& filepath);
+
+    /// \brief Create the GPU resources of every asset that has been decoded, without waiting for the others
+    ///
+    /// \returns how many assets were created
+    std::size_t poll();
+    /// \brief Wait until an asset has been decoded and created, creating every other decoded asset meanwhile
+    ///
+    /// \param future a future returned by this loader
+    ///
+    /// \returns the asset, rethrows if it could not be loaded
+    template<typename T>
+    std::shared_ptr<T> get(const Future<T>& future)
+    {
+        while(future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            waitForDecoded();
+
+        return future.get();
+    }
+    /// \brief Wait until every requested asset has been created
+    void waitIdle();
+
+private:
+    /// \brief Creates the GPU resources of a decoded asset and fulfills its future
+    using Finisher = std::function<void()>;
+
+    std::shared_ptr<Device> device;
+
+    std::mutex m_mutex;
+    std::condition_variable m_decodedAvailable;
+    std::deque<Finisher> m_decoded;
+    std::size_t m_requested{ 0 };
+    std::size_t m_created{ 0 };
+
+    // NOTE: Destroyed first, so no worker touches the members above anymore
+    JobQueue m_jobs;
+
+    void pushDecoded(Finisher finisher);
+    void waitForDecoded();
+
+    /// \brief Run decode on a worker and the function it returns on the thread that polls
+    ///
+    /// \tparam T the type of the asset
+    /// \param decode does the CPU work and returns the function that creates the asset
+    ///
+    /// \returns the asset once it has been created
+    template<typename T, typename Decode>
+    Future<T> request(Decode decode)
+    {
+        const auto promise{ std::make_shared<std::promise<std::shared_ptr<T>>>() };
+        Future<T> future{ promise->get_future().share() };
+        ++m_requested;
+
+        m_jobs.push([this, promise, decode = std::move(decode)]() {
+            std::function<std::shared_ptr<T>()> create{};
+            try
+            {
+                create = decode();
+            }
+            catch(...)
+            {
+                create = [exception = std::current_exception()]() -> std::shared_ptr<T> {
+                    std::rethrow_exception(exception);
+                };
+            }
+
+            pushDecoded([promise, create = std::move(create)]() {
+                try
+                {
+                    promise->set_value(create());
+                }
+                catch(...)
+                {
+                    promise->set_exception(std::current_exception());
+                }
+            });
+        });
+
+        return future;
+    }
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_UTILITY_ASSET_LOADER_HPP
@@ -0,0 +1,54 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_UTILITY_BOUNDS_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_UTILITY_BOUNDS_HPP
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include "glm/glm.hpp"
+
+namespace vv
+{
+
+/// \brief Axis aligned bounding box
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct AABB
+{
+    glm::vec3 min{ 0.f };
+    glm::vec3 max{ 0.f };
+
+    [[nodiscard]] glm::vec3 center() const noexcept { return (min + max) * 0.5f; }
+    [[nodiscard]] glm::vec3 extent() const noexcept { return (max - min) * 0.5f; }
+};
+
+/// \brief Bounding sphere given by its center and radius
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct BoundingSphere
+{
+    glm::vec3 center{ 0.f };
+    float radius{ 0.f };
+
+    /// \brief Transform the sphere into another space
+    ///
+    /// The radius is scaled by the largest axis scale, so the result still encloses the transformed geometry if the
+    /// matrix contains non-uniform scaling
+    ///
+    /// \param matrix the transformation, i.e., a model matrix
+    ///
+    /// \returns \ref BoundingSphere the transformed sphere
+    [[nodiscard]] BoundingSphere transformed(const glm::mat4& matrix) const noexcept
+    {
+        const float scaleX{ glm::dot(glm::vec3{ matrix[0] }, glm::vec3{ matrix[0] }) };
+        const float scaleY{ glm::dot(glm::vec3{ matrix[1] }, glm::vec3{ matrix[1] }) };
+        const float scaleZ{ glm::dot(glm::vec3{ matrix[2] }, glm::vec3{ matrix[2] }) };
+
+        return { .center = glm::vec3{ matrix * glm::vec4{ center, 1.f } },
+                 .radius = radius * glm::sqrt(glm::max(scaleX, glm::max(scaleY, scaleZ))) };
+    }
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_UTILITY_BOUNDS_HPP
@@ -0,0 +1,45 @@
+#include "DeletionQueue.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace vv
+{
+
+void DeletionQueue::push(std::uint64_t value, Deleter deleter)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert((m_entries.empty() || m_entries.back().value <= value) && "Deletions have to be pushed in timeline order");
+#endif
+
+    m_entries.push_back({ .value = value, .deleter = std::move(deleter) });
+}
+
+std::size_t DeletionQueue::collect(std::uint64_t completedValue)
+{
+    std::size_t collected{ 0 };
+    while(!m_entries.empty() && m_entries.front().value <= completedValue)
+    {
+        // NOTE: Taken out first, a deleter may push new deletions
+        Deleter deleter{ std::move(m_entries.front().deleter) };
+        m_entries.pop_front();
+        deleter();
+        ++collected;
+    }
+
+    return collected;
+}
+
+void DeletionQueue::flush()
+{
+    while(!m_entries.empty())
+    {
+        Deleter deleter{ std::move(m_entries.front().deleter) };
+        m_entries.pop_front();
+        deleter();
+    }
+}
+
+} // namespace vv
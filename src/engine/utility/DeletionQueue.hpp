@@ -0,0 +1,63 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_UTILITY_DELETION_QUEUE_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_UTILITY_DELETION_QUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+namespace vv
+{
+
+/// \brief Destroys resources once the GPU work that may still use them has finished
+///
+/// Every deletion is keyed to a value of a timeline semaphore. Once the semaphore has reached that value, the
+/// submission that last used the resource is done and the deletion runs. Values have to be pushed in ascending
+/// order, which is the case as long as they are taken from the same, monotonically increasing timeline.
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+class DeletionQueue
+{
+public:
+    using Deleter = std::function<void()>;
+
+    DeletionQueue() = default;
+    ~DeletionQueue() = default;
+
+    DeletionQueue(const DeletionQueue&) = delete;
+    DeletionQueue(DeletionQueue&&) = default;
+    DeletionQueue& operator=(const DeletionQueue&) = delete;
+    DeletionQueue& operator=(DeletionQueue&&) = default;
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_entries.size(); }
+    [[nodiscard]] bool empty() const noexcept { return m_entries.empty(); }
+
+    /// \brief Delete something once the timeline has reached a value
+    ///
+    /// \param value the timeline value after which nothing uses the resource anymore
+    /// \param deleter destroys the resource
+    void push(std::uint64_t value, Deleter deleter);
+    /// \brief Run every deletion whose value the timeline has reached
+    ///
+    /// \param completedValue the current value of the timeline
+    ///
+    /// \returns how many deletions ran
+    std::size_t collect(std::uint64_t completedValue);
+    /// \brief Run every deletion, only valid once the GPU is idle
+    void flush();
+
+private:
+    /// \brief A pending deletion
+    struct Entry
+    {
+        std::uint64_t value{ 0 };
+        Deleter deleter;
+    };
+
+    std::deque<Entry> m_entries;
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_UTILITY_DELETION_QUEUE_HPP
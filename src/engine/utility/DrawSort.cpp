@@ -0,0 +1,50 @@
+#include "DrawSort.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace vv
+{
+
+void radixSort(std::vector<DrawSortEntry>& entries, std::vector<DrawSortEntry>& scratch)
+{
+    constexpr std::uint32_t DIGIT_BITS{ 8 };
+    constexpr std::size_t BUCKETS{ std::size_t{ 1 } << DIGIT_BITS };
+    constexpr std::uint32_t PASSES{ 64 / DIGIT_BITS };
+
+    if(entries.size() < 2)
+        return;
+
+    // NOTE: All histograms are built in one pass over the keys
+    std::array<std::array<std::uint32_t, BUCKETS>, PASSES> histograms{};
+    for(const auto& entry : entries)
+    {
+        for(std::uint32_t pass{ 0 }; pass < PASSES; ++pass)
+            ++histograms[pass][(entry.key >> (pass * DIGIT_BITS)) & (BUCKETS - 1)];
+    }
+
+    scratch.resize(entries.size());
+    for(std::uint32_t pass{ 0 }; pass < PASSES; ++pass)
+    {
+        auto& histogram{ histograms[pass] };
+        const std::uint32_t shift{ pass * DIGIT_BITS };
+
+        // NOTE: Every key has the same digit, the pass would not change the order
+        if(histogram[(entries.front().key >> shift) & (BUCKETS - 1)] == entries.size())
+            continue;
+
+        std::uint32_t offset{ 0 };
+        for(auto& count : histogram)
+            offset += std::exchange(count, offset);
+
+        for(const auto& entry : entries)
+            scratch[histogram[(entry.key >> shift) & (BUCKETS - 1)]++] = entry;
+
+        entries.swap(scratch);
+    }
+}
+
+} // namespace vv
@@ -0,0 +1,86 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_UTILITY_DRAW_SORT_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_UTILITY_DRAW_SORT_HPP
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace vv
+{
+
+/// \brief A draw with its sort key and the index of the draw in the caller's list
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct DrawSortEntry
+{
+    std::uint64_t key{ 0 };
+    std::uint32_t index{ 0 };
+};
+
+/// \brief Bit layout of a draw sort key, from the most to the least significant bits
+///
+/// Draws that share a pipeline end up next to each other, within a pipeline the draws of a material, within a
+/// material the draws of a model and within a model they are ordered front to back. Ids that do not fit into their
+/// field wrap around, which only makes the order less optimal.
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct DrawSortKey
+{
+    static constexpr std::uint32_t DEPTH_BITS{ 16 };
+    static constexpr std::uint32_t MODEL_BITS{ 22 };
+    static constexpr std::uint32_t MATERIAL_BITS{ 22 };
+    static constexpr std::uint32_t PIPELINE_BITS{ 4 };
+
+    static constexpr std::uint32_t MODEL_SHIFT{ DEPTH_BITS };
+    static constexpr std::uint32_t MATERIAL_SHIFT{ MODEL_SHIFT + MODEL_BITS };
+    static constexpr std::uint32_t PIPELINE_SHIFT{ MATERIAL_SHIFT + MATERIAL_BITS };
+
+    static_assert(PIPELINE_SHIFT + PIPELINE_BITS == 64, "The fields have to fill the key");
+
+    /// \brief Quantize a non-negative view distance into a depth bucket
+    ///
+    /// Non-negative floats compare like their bit patterns, so the upper bits (exponent and the leading mantissa
+    /// bits) are a logarithmic bucket that keeps the front to back order without knowing the far plane
+    ///
+    /// \param distance distance between the camera and the object
+    [[nodiscard]] static constexpr std::uint32_t depthBucket(float distance) noexcept
+    {
+        const float clamped{ distance > 0.f ? distance : 0.f };
+        return std::bit_cast<std::uint32_t>(clamped) >> (32 - DEPTH_BITS);
+    }
+
+    /// \brief Combine the state of a draw into a key
+    ///
+    /// \param pipeline id of the pipeline the draw uses
+    /// \param material id of the material the draw binds
+    /// \param model id of the model the draw binds
+    /// \param depth depth bucket of the draw, see \ref depthBucket
+    [[nodiscard]] static constexpr std::uint64_t make(
+        std::uint32_t pipeline, std::uint32_t material, std::uint32_t model, std::uint32_t depth
+    ) noexcept
+    {
+        return (field(pipeline, PIPELINE_BITS) << PIPELINE_SHIFT) | (field(material, MATERIAL_BITS) << MATERIAL_SHIFT)
+               | (field(model, MODEL_BITS) << MODEL_SHIFT) | field(depth, DEPTH_BITS);
+    }
+
+private:
+    [[nodiscard]] static constexpr std::uint64_t field(std::uint32_t value, std::uint32_t bits) noexcept
+    {
+        return static_cast<std::uint64_t>(value) & ((std::uint64_t{ 1 } << bits) - 1);
+    }
+};
+
+/// \brief Sort draws by their key in ascending order with a least significant digit radix sort
+///
+/// Uses 8 bit digits and skips every digit in which all keys are equal, so keys that only differ in a few fields
+/// are sorted in a few passes. The sort is stable.
+///
+/// \param entries the draws to sort
+/// \param scratch memory that is reused between calls to avoid allocations, its content is overwritten
+void radixSort(std::vector<DrawSortEntry>& entries, std::vector<DrawSortEntry>& scratch);
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_UTILITY_DRAW_SORT_HPP
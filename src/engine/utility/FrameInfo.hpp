@@ -9,7 +9,6 @@
 #include "glm/glm.hpp"
 #include <vulkan/vulkan_core.h>
 
-#include <array>
 #include <cstddef>
 #include <memory>
 #include <vector>
@@ -23,11 +22,10 @@ namespace vv
 /// \date 11/28/2025
 struct PointLight
 {
-    glm::vec4 position{};
-    glm::vec4 color{};
+    glm::vec4 position{}; ///< xyz = world space position, w = range after which the light has no influence
+    glm::vec4 color{};    ///< rgb = color, w = intensity
 };
 
-static constexpr std::size_t MAX_LIGHTS{ 10 };
 static constexpr float AMBIENT_LIGHT_INTENSITY{ 0.02f };
 
 /// \brief Definition of the Global UBO that contains generally relevant data
@@ -40,8 +38,6 @@ struct GlobalUBO
     glm::mat4 view{ 1.f };
     glm::mat4 inverseView{ 1.f };
     glm::vec4 ambientLightColor{ 1.f, 1.f, 1.f, AMBIENT_LIGHT_INTENSITY };
-    std::array<PointLight, MAX_LIGHTS> pointLights;
-    int numLights;
 };
 
 /// \brief FrameInfo is a collection of relevant data that regards the entire Frame
@@ -51,7 +47,7 @@ struct GlobalUBO
 /// - delta time
 /// - command buffer in use
 /// - camera
-/// - descriptor set
+/// - descriptor sets
 /// - frame objects
 ///
 /// \author Felix Hommel
@@ -63,6 +59,7 @@ struct FrameInfo
     VkCommandBuffer commandBuffer;
     std::shared_ptr<Camera> camera;
     VkDescriptorSet globalDescriptorSet;
+    VkDescriptorSet lightDescriptorSet; ///< Point lights binned into clusters by the \ref LightClusterer
     std::shared_ptr<Object::ObjectMap> objects;
     std::vector<Object>& lights;
 };
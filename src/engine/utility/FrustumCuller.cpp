@@ -0,0 +1,154 @@
+#include "FrustumCuller.hpp"
+
+#include "utility/Bounds.hpp"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include "glm/glm.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#    define VV_FRUSTUM_CULLER_SSE
+#    include <xmmintrin.h>
+#endif
+
+namespace vv
+{
+
+void FrustumCuller::setFrustum(const glm::mat4& viewProjection)
+{
+    const auto row{ [&viewProjection](glm::length_t i) {
+        return glm::vec4{ viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i] };
+    } };
+
+    // NOTE: Gribb/Hartmann plane extraction. With a [0, 1] depth range the near plane is the third row on its own
+    m_planes[0] = row(3) + row(0); // left
+    m_planes[1] = row(3) - row(0); // right
+    m_planes[2] = row(3) + row(1); // bottom
+    m_planes[3] = row(3) - row(1); // top
+    m_planes[4] = row(2);          // near
+    m_planes[5] = row(3) - row(2); // far
+
+    for(auto& plane : m_planes)
+    {
+        const float length{ glm::length(glm::vec3{ plane }) };
+        if(length > 0.f)
+            plane /= length;
+    }
+}
+
+void FrustumCuller::clear()
+{
+    m_centerX.clear();
+    m_centerY.clear();
+    m_centerZ.clear();
+    m_radius.clear();
+}
+
+void FrustumCuller::reserve(std::size_t count)
+{
+    m_centerX.reserve(count);
+    m_centerY.reserve(count);
+    m_centerZ.reserve(count);
+    m_radius.reserve(count);
+}
+
+void FrustumCuller::addSphere(const BoundingSphere& sphere)
+{
+    m_centerX.push_back(sphere.center.x);
+    m_centerY.push_back(sphere.center.y);
+    m_centerZ.push_back(sphere.center.z);
+    m_radius.push_back(sphere.radius);
+}
+
+void FrustumCuller::cull(std::vector<std::uint32_t>& visible) const
+{
+#if defined(VV_FRUSTUM_CULLER_SSE)
+    constexpr std::size_t LANES{ 4 };
+
+    visible.clear();
+
+    const std::size_t count{ size() };
+    const std::size_t simdCount{ count - (count % LANES) };
+
+    std::array<__m128, PLANE_COUNT> planeX{};
+    std::array<__m128, PLANE_COUNT> planeY{};
+    std::array<__m128, PLANE_COUNT> planeZ{};
+    std::array<__m128, PLANE_COUNT> planeW{};
+    for(std::size_t p{ 0 }; p < PLANE_COUNT; ++p)
+    {
+        planeX[p] = _mm_set1_ps(m_planes[p].x);
+        planeY[p] = _mm_set1_ps(m_planes[p].y);
+        planeZ[p] = _mm_set1_ps(m_planes[p].z);
+        planeW[p] = _mm_set1_ps(m_planes[p].w);
+    }
+
+    const __m128 signMask{ _mm_set1_ps(-0.f) };
+    for(std::size_t i{ 0 }; i < simdCount; i += LANES)
+    {
+        const __m128 x{ _mm_loadu_ps(&m_centerX[i]) };
+        const __m128 y{ _mm_loadu_ps(&m_centerY[i]) };
+        const __m128 z{ _mm_loadu_ps(&m_centerZ[i]) };
+        const __m128 negRadius{ _mm_xor_ps(_mm_loadu_ps(&m_radius[i]), signMask) };
+
+        // NOTE: A sphere is outside if it lies completely behind any plane, i.e., distance < -radius
+        __m128 inside{ _mm_cmpeq_ps(x, x) };
+        for(std::size_t p{ 0 }; p < PLANE_COUNT; ++p)
+        {
+            __m128 distance{ _mm_mul_ps(x, planeX[p]) };
+            distance = _mm_add_ps(distance, _mm_mul_ps(y, planeY[p]));
+            distance = _mm_add_ps(distance, _mm_mul_ps(z, planeZ[p]));
+            distance = _mm_add_ps(distance, planeW[p]);
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negRadius));
+        }
+
+        auto mask{ static_cast<std::uint32_t>(_mm_movemask_ps(inside)) };
+        while(mask != 0)
+        {
+            visible.push_back(static_cast<std::uint32_t>(i) + static_cast<std::uint32_t>(std::countr_zero(mask)));
+            mask &= mask - 1;
+        }
+    }
+
+    for(std::size_t i{ simdCount }; i < count; ++i)
+    {
+        if(isVisible(i))
+            visible.push_back(static_cast<std::uint32_t>(i));
+    }
+#else
+    cullScalar(visible);
+#endif
+}
+
+void FrustumCuller::cullScalar(std::vector<std::uint32_t>& visible) const
+{
+    visible.clear();
+    for(std::size_t i{ 0 }; i < size(); ++i)
+    {
+        if(isVisible(i))
+            visible.push_back(static_cast<std::uint32_t>(i));
+    }
+}
+
+/// \brief Test a single sphere against all planes
+///
+/// \param index the index of the sphere
+bool FrustumCuller::isVisible(std::size_t index) const noexcept
+{
+    for(const auto& plane : m_planes)
+    {
+        const float distance{ (m_centerX[index] * plane.x) + (m_centerY[index] * plane.y)
+                              + (m_centerZ[index] * plane.z) + plane.w };
+        if(distance < -m_radius[index])
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace vv
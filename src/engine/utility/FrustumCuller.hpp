@@ -0,0 +1,81 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_UTILITY_FRUSTUM_CULLER_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_UTILITY_FRUSTUM_CULLER_HPP
+
+#include "utility/Bounds.hpp"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include "glm/glm.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vv
+{
+
+/// \brief Tests bounding spheres against a view frustum
+///
+/// The spheres are stored as structure of arrays so that four of them are tested against a plane at once using SSE.
+/// On targets without SSE a scalar loop is used instead, which produces the same results.
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+class FrustumCuller
+{
+public:
+    static constexpr std::size_t PLANE_COUNT{ 6 };
+
+    FrustumCuller() = default;
+    ~FrustumCuller() = default;
+
+    FrustumCuller(const FrustumCuller&) = default;
+    FrustumCuller(FrustumCuller&&) = default;
+    FrustumCuller& operator=(const FrustumCuller&) = default;
+    FrustumCuller& operator=(FrustumCuller&&) = default;
+
+    /// \brief Extract the frustum planes from a combined projection and view matrix
+    ///
+    /// Expects a projection with a depth range of [0, 1] (GLM_FORCE_DEPTH_ZERO_TO_ONE)
+    ///
+    /// \param viewProjection projection * view
+    void setFrustum(const glm::mat4& viewProjection);
+    /// \brief Remove all spheres
+    void clear();
+    /// \brief Reserve memory for a number of spheres
+    ///
+    /// \param count how many spheres are going to be added
+    void reserve(std::size_t count);
+    /// \brief Add a world space sphere, its index is the number of spheres added before it
+    ///
+    /// \param sphere the \ref BoundingSphere to add
+    void addSphere(const BoundingSphere& sphere);
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_centerX.size(); }
+    [[nodiscard]] const std::array<glm::vec4, PLANE_COUNT>& getPlanes() const noexcept { return m_planes; }
+
+    /// \brief Determine which spheres intersect the frustum
+    ///
+    /// \param visible receives the indices of all spheres that are at least partially inside, in ascending order
+    void cull(std::vector<std::uint32_t>& visible) const;
+    /// \brief Reference implementation of \ref cull that never uses SIMD
+    ///
+    /// \param visible receives the indices of all spheres that are at least partially inside, in ascending order
+    void cullScalar(std::vector<std::uint32_t>& visible) const;
+
+private:
+    // NOTE: Planes are stored as (normal, distance) with the normal pointing into the frustum
+    std::array<glm::vec4, PLANE_COUNT> m_planes{};
+
+    std::vector<float> m_centerX;
+    std::vector<float> m_centerY;
+    std::vector<float> m_centerZ;
+    std::vector<float> m_radius;
+
+    [[nodiscard]] bool isVisible(std::size_t index) const noexcept;
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_UTILITY_FRUSTUM_CULLER_HPP
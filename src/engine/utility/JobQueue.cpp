@@ -0,0 +1,81 @@
+#include "JobQueue.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace vv
+{
+
+JobQueue::JobQueue(std::size_t threadCount)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(threadCount > 0 && "A job queue needs at least one worker");
+#endif
+
+    m_workers.reserve(threadCount);
+    for(std::size_t thread{ 0 }; thread < threadCount; ++thread)
+        m_workers.emplace_back([this]() { workerLoop(); });
+}
+
+JobQueue::~JobQueue()
+{
+    {
+        const std::scoped_lock lock{ m_mutex };
+        m_stopping = true;
+    }
+    m_jobAvailable.notify_all();
+
+    for(auto& worker : m_workers)
+        worker.join();
+}
+
+void JobQueue::push(Job job)
+{
+    {
+        const std::scoped_lock lock{ m_mutex };
+        m_jobs.push_back(std::move(job));
+    }
+    m_jobAvailable.notify_one();
+}
+
+void JobQueue::waitIdle()
+{
+    std::unique_lock lock{ m_mutex };
+    m_idle.wait(lock, [this]() { return m_jobs.empty() && m_runningJobs == 0; });
+}
+
+/// \brief Run queued jobs until the queue is destroyed and no job is left
+void JobQueue::workerLoop()
+{
+    while(true)
+    {
+        Job job{};
+        {
+            std::unique_lock lock{ m_mutex };
+            m_jobAvailable.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+
+            // NOTE: Stopping still drains the queue, so every pushed job runs exactly once
+            if(m_jobs.empty())
+                return;
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            ++m_runningJobs;
+        }
+
+        job();
+
+        {
+            const std::scoped_lock lock{ m_mutex };
+            --m_runningJobs;
+            if(!m_jobs.empty() || m_runningJobs != 0)
+                continue;
+        }
+        m_idle.notify_all();
+    }
+}
+
+} // namespace vv
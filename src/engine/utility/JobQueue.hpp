@@ -0,0 +1,63 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_UTILITY_JOB_QUEUE_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_UTILITY_JOB_QUEUE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vv
+{
+
+/// \brief Worker threads that run independent jobs in the order they were pushed
+///
+/// Unlike the \ref ThreadPool the caller does not wait for the work, jobs run in the background until they are done.
+/// Jobs must not throw, a job that wants to report an error has to hand it over itself.
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+class JobQueue
+{
+public:
+    using Job = std::function<void()>;
+
+    /// \brief Create a new \ref JobQueue
+    ///
+    /// \param threadCount how many worker threads run the jobs. At least one
+    explicit JobQueue(std::size_t threadCount);
+    /// \brief Run the jobs that are still queued and stop the worker threads
+    ~JobQueue();
+
+    JobQueue(const JobQueue&) = delete;
+    JobQueue(JobQueue&&) = delete;
+    JobQueue& operator=(const JobQueue&) = delete;
+    JobQueue& operator=(JobQueue&&) = delete;
+
+    [[nodiscard]] std::size_t getThreadCount() const noexcept { return m_workers.size(); }
+
+    /// \brief Queue a job, which is run by the next free worker
+    ///
+    /// \param job the work to do
+    void push(Job job);
+    /// \brief Block until every queued job has finished
+    void waitIdle();
+
+private:
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_jobAvailable;
+    std::condition_variable m_idle;
+    std::deque<Job> m_jobs;
+    std::size_t m_runningJobs{ 0 };
+    bool m_stopping{ false };
+
+    void workerLoop();
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_UTILITY_JOB_QUEUE_HPP
@@ -1,6 +1,7 @@
 #include "Model.hpp"
 
 #include "core/Device.hpp"
+#include "core/UploadManager.hpp"
 #include "utility/Utils.hpp"
 
 #define GLM_ENABLE_EXPERIMENTAL
@@ -16,6 +17,7 @@
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
@@ -65,6 +67,24 @@ std::vector<VkVertexInputAttributeDescription> Model::Vertex::getAttributeDescri
     return attributeDescriptions;
 }
 
+std::vector<VkVertexInputBindingDescription> Model::Vertex::getPositionBindingDescriptions()
+{
+    std::vector<VkVertexInputBindingDescription> bindingDescriptions(1);
+    bindingDescriptions[0].binding = 0;
+    bindingDescriptions[0].stride = sizeof(glm::vec3);
+    bindingDescriptions[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    return bindingDescriptions;
+}
+
+std::vector<VkVertexInputAttributeDescription> Model::Vertex::getPositionAttributeDescriptions()
+{
+    std::vector<VkVertexInputAttributeDescription> attributeDescriptions{};
+    attributeDescriptions.emplace_back(0, 0, VK_FORMAT_R32G32B32_SFLOAT, 0);
+
+    return attributeDescriptions;
+}
+
 void Model::Builder::loadModel(const std::filesystem::path& filepath)
 {
     tinyobj::attrib_t attrib;
@@ -120,11 +140,41 @@ void Model::Builder::loadModel(const std::filesystem::path& filepath)
             indices.push_back(uniqueVertices[v]);
         }
     }
+
+    computeBounds();
 }
 
-Model::Model(std::shared_ptr<Device> device, const Builder& builder) : device{ std::move(device) }
+void Model::Builder::computeBounds()
+{
+    bounds = {};
+    boundingSphere = {};
+    if(vertices.empty())
+        return;
+
+    bounds.min = vertices.front().position;
+    bounds.max = vertices.front().position;
+    for(const auto& v : vertices)
+    {
+        bounds.min = glm::min(bounds.min, v.position);
+        bounds.max = glm::max(bounds.max, v.position);
+    }
+
+    // NOTE: Centered on the box, but the radius is the farthest vertex, which is tighter than half of the diagonal
+    boundingSphere.center = bounds.center();
+    float maxDistanceSquared{ 0.f };
+    for(const auto& v : vertices)
+    {
+        const glm::vec3 offset{ v.position - boundingSphere.center };
+        maxDistanceSquared = glm::max(maxDistanceSquared, glm::dot(offset, offset));
+    }
+    boundingSphere.radius = glm::sqrt(maxDistanceSquared);
+}
+
+Model::Model(std::shared_ptr<Device> device, const Builder& builder)
+    : device{ std::move(device) }, m_bounds{ builder.bounds }, m_boundingSphere{ builder.boundingSphere }
 {
     createVertexBuffer(builder.vertices);
+    createPositionBuffer(builder.vertices);
     createIndexBuffer(builder.indices);
 }
 
@@ -136,6 +186,15 @@ std::unique_ptr<Model> Model::loadFromFile(std::shared_ptr<Device> device, const
     return std::make_unique<Model>(device, builder);
 }
 
+VkDeviceSize Model::getMemorySize() const noexcept
+{
+    VkDeviceSize size{ m_vertexBuffer->getBufferSize() + m_positionBuffer->getBufferSize() };
+    if(m_hasIndexBuffer)
+        size += m_indexBuffer->getBufferSize();
+
+    return size;
+}
+
 void Model::bind(VkCommandBuffer commandBuffer) const
 {
     const std::array<VkBuffer, 1> buffers{ m_vertexBuffer->getBuffer() };
@@ -146,40 +205,88 @@ void Model::bind(VkCommandBuffer commandBuffer) const
         vkCmdBindIndexBuffer(commandBuffer, m_indexBuffer->getBuffer(), 0, VK_INDEX_TYPE_UINT32);
 }
 
-void Model::draw(VkCommandBuffer commandBuffer) const
+void Model::bindPositions(VkCommandBuffer commandBuffer) const
 {
+    const std::array<VkBuffer, 1> buffers{ m_positionBuffer->getBuffer() };
+    constexpr std::array<VkDeviceSize, 1> offsets{ 0 };
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers.data(), offsets.data());
+
     if(m_hasIndexBuffer)
-        vkCmdDrawIndexed(commandBuffer, m_indexCount, 1, 0, 0, 0);
+        vkCmdBindIndexBuffer(commandBuffer, m_indexBuffer->getBuffer(), 0, VK_INDEX_TYPE_UINT32);
+}
+
+void Model::draw(VkCommandBuffer commandBuffer, std::uint32_t instanceCount, std::uint32_t firstInstance) const
+{
+    if(m_hasIndexBuffer)
+        vkCmdDrawIndexed(commandBuffer, m_indexCount, instanceCount, 0, 0, firstInstance);
     else
-        vkCmdDraw(commandBuffer, m_vertexCount, 1, 0, 0);
+        vkCmdDraw(commandBuffer, m_vertexCount, instanceCount, 0, firstInstance);
+}
+
+void Model::drawIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset) const
+{
+    if(m_hasIndexBuffer)
+        vkCmdDrawIndexedIndirect(commandBuffer, buffer, offset, 1, sizeof(VkDrawIndexedIndirectCommand));
+    else
+        vkCmdDrawIndirect(commandBuffer, buffer, offset, 1, sizeof(VkDrawIndirectCommand));
+}
+
+void Model::drawIndirectCount(
+    VkCommandBuffer commandBuffer,
+    VkBuffer buffer,
+    VkDeviceSize offset,
+    VkBuffer countBuffer,
+    VkDeviceSize countOffset,
+    std::uint32_t maxDrawCount,
+    std::uint32_t stride
+) const
+{
+    if(m_hasIndexBuffer)
+        vkCmdDrawIndexedIndirectCount(commandBuffer, buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+    else
+        vkCmdDrawIndirectCount(commandBuffer, buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
 }
 
 /// \brief Create a new Vertex Buffer using the data specified by the vertices
 ///
-/// Uses a staging buffer to transfer the vertices to device local memory.
+/// The copy to device local memory is batched by the \ref UploadManager.
 ///
 /// \param vertices vertex data that is stored in the buffer
 void Model::createVertexBuffer(const std::vector<Vertex>& vertices)
 {
     m_vertexCount = static_cast<std::uint32_t>(vertices.size());
     constexpr std::uint32_t vertexSize{ sizeof(vertices[0]) };
-    const VkDeviceSize bufferSize{ static_cast<VkDeviceSize>(vertexSize * m_vertexCount) };
 #if defined(VV_ENABLE_ASSERTS)
     assert(m_vertexCount > 3 && "The Model must at least contain 3 vertices");
 #endif
 
-    Buffer stagingBuffer{ Buffer::createStagingBuffer(device, vertexSize, m_vertexCount) };
-    stagingBuffer.writeToBuffer(vertices);
-    stagingBuffer.flush();
-
     m_vertexBuffer = std::make_unique<Buffer>(Buffer::createVertexBuffer(device, vertexSize, m_vertexCount));
 
-    device->copyBuffer(stagingBuffer.getBuffer(), m_vertexBuffer->getBuffer(), bufferSize);
+    device->uploadManager().uploadBuffer(m_vertexBuffer->getBuffer(), std::as_bytes(std::span{ vertices }));
+}
+
+/// \brief Create a Vertex Buffer that only contains the positions of the vertices
+///
+/// The copy to device local memory is batched by the \ref UploadManager.
+///
+/// \param vertices vertex data whose positions are stored in the buffer
+void Model::createPositionBuffer(const std::vector<Vertex>& vertices)
+{
+    constexpr std::uint32_t positionSize{ sizeof(glm::vec3) };
+
+    std::vector<glm::vec3> positions{};
+    positions.reserve(vertices.size());
+    for(const auto& vertex : vertices)
+        positions.push_back(vertex.position);
+
+    m_positionBuffer = std::make_unique<Buffer>(Buffer::createVertexBuffer(device, positionSize, m_vertexCount));
+
+    device->uploadManager().uploadBuffer(m_positionBuffer->getBuffer(), std::as_bytes(std::span{ positions }));
 }
 
 /// \brief Create a new Index Buffer using the data specified by the indices
 ///
-/// Uses a staging buffer to transfer the indices to device local memory.
+/// The copy to device local memory is batched by the \ref UploadManager.
 ///
 /// \param indices index data that is stored in the buffer
 void Model::createIndexBuffer(const std::vector<std::uint32_t>& indices)
@@ -191,15 +298,10 @@ void Model::createIndexBuffer(const std::vector<std::uint32_t>& indices)
         return;
 
     constexpr std::uint32_t indexSize{ sizeof(indices[0]) };
-    const VkDeviceSize bufferSize{ static_cast<VkDeviceSize>(indexSize * m_indexCount) };
-
-    Buffer stagingBuffer{ Buffer::createStagingBuffer(device, indexSize, m_indexCount) };
-    stagingBuffer.writeToBuffer(indices);
-    stagingBuffer.flush();
 
     m_indexBuffer = std::make_unique<Buffer>(Buffer::createIndexBuffer(device, indexSize, m_indexCount));
 
-    device->copyBuffer(stagingBuffer.getBuffer(), m_indexBuffer->getBuffer(), bufferSize);
+    device->uploadManager().uploadBuffer(m_indexBuffer->getBuffer(), std::as_bytes(std::span{ indices }));
 }
 
 
@@ -3,6 +3,8 @@
 
 #include "core/Buffer.hpp"
 #include "core/Device.hpp"
+#include "utility/Bounds.hpp"
+#include "utility/object/IdPool.hpp"
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -41,6 +43,10 @@ public:
         static std::vector<VkVertexInputBindingDescription> getBindingDescriptions();
         /// \brief Provide the information about the Attributes that the Pipeline needs
         static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions();
+        /// \brief Binding of the position only stream that is bound by \ref Model::bindPositions
+        static std::vector<VkVertexInputBindingDescription> getPositionBindingDescriptions();
+        /// \brief Attributes of the position only stream, the position is at location 0 like in the full stream
+        static std::vector<VkVertexInputAttributeDescription> getPositionAttributeDescriptions();
 
         bool operator==(const Vertex& other) const
         {
@@ -56,11 +62,15 @@ public:
     {
         std::vector<Vertex> vertices;
         std::vector<std::uint32_t> indices;
+        AABB bounds;
+        BoundingSphere boundingSphere;
 
         /// \brief Use tinyobj to parse obj file and carve out vertex and index buffer content
         ///
         /// \param filepath path to the obj file
         void loadModel(const std::filesystem::path& filepath);
+        /// \brief Calculate the model space bounding box and sphere of the vertices
+        void computeBounds();
     };
 
     /// \brief Create a new \ref Model
@@ -82,26 +92,80 @@ public:
     /// \param filepath path to the obj file
     static std::unique_ptr<Model> loadFromFile(std::shared_ptr<Device> device, const std::filesystem::path& filepath);
 
+    /// \brief Unique id of the model, i.e., to sort draws by the model they bind
+    [[nodiscard]] std::uint32_t getId() const noexcept { return m_id; }
+    [[nodiscard]] bool hasIndexBuffer() const noexcept { return m_hasIndexBuffer; }
+    [[nodiscard]] std::uint32_t vertexCount() const noexcept { return m_vertexCount; }
+    [[nodiscard]] std::uint32_t indexCount() const noexcept { return m_indexCount; }
+    [[nodiscard]] const AABB& getBounds() const noexcept { return m_bounds; }
+    [[nodiscard]] const BoundingSphere& getBoundingSphere() const noexcept { return m_boundingSphere; }
+    /// \brief Device memory taken up by the vertex, position and index buffers (in byte)
+    [[nodiscard]] VkDeviceSize getMemorySize() const noexcept;
+
     /// \brief Bind the vertex buffer of the model
     ///
     /// \param commandBuffer the VkCommandBuffer that the vertex buffer is bound to
     void bind(VkCommandBuffer commandBuffer) const;
+    /// \brief Bind only the positions of the vertices and the index buffer
+    ///
+    /// Depth only passes read a third of the vertex data this way
+    ///
+    /// \param commandBuffer the VkCommandBuffer that the position buffer is bound to
+    void bindPositions(VkCommandBuffer commandBuffer) const;
     /// \brief Draw the vertices in the vertex buffer
     ///
     /// \param commandBuffer the VkCommandBuffer that the vertices are drawn to
-    void draw(VkCommandBuffer commandBuffer) const;
+    /// \param instanceCount (optional) how many instances of the model are drawn
+    /// \param firstInstance (optional) instance index of the first instance
+    void draw(VkCommandBuffer commandBuffer, std::uint32_t instanceCount = 1, std::uint32_t firstInstance = 0) const;
+    /// \brief Draw the vertices with the draw parameters read from a buffer
+    ///
+    /// Models with an index buffer read a VkDrawIndexedIndirectCommand, models without one a VkDrawIndirectCommand
+    ///
+    /// \param commandBuffer the VkCommandBuffer that the vertices are drawn to
+    /// \param buffer the buffer containing the draw command
+    /// \param offset where in \p buffer the draw command starts (in byte)
+    void drawIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset) const;
+    /// \brief Draw the vertices with a number of draw commands that is read from a buffer
+    ///
+    /// Requires the drawIndirectCount feature. The commands have the same layout as in \ref drawIndirect
+    ///
+    /// \param commandBuffer the VkCommandBuffer that the vertices are drawn to
+    /// \param buffer the buffer containing the draw commands
+    /// \param offset where in \p buffer the first draw command starts (in byte)
+    /// \param countBuffer the buffer containing the number of draw commands
+    /// \param countOffset where in \p countBuffer the draw count is stored (in byte)
+    /// \param maxDrawCount upper limit of the draw count
+    /// \param stride distance between two draw commands in \p buffer (in byte)
+    void drawIndirectCount(
+        VkCommandBuffer commandBuffer,
+        VkBuffer buffer,
+        VkDeviceSize offset,
+        VkBuffer countBuffer,
+        VkDeviceSize countOffset,
+        std::uint32_t maxDrawCount,
+        std::uint32_t stride
+    ) const;
 
 private:
+    inline static IdPool s_idPool{};
+
     std::shared_ptr<Device> device;
+    std::uint32_t m_id{ s_idPool.acquire() };
 
     std::unique_ptr<Buffer> m_vertexBuffer;
+    std::unique_ptr<Buffer> m_positionBuffer;
     std::uint32_t m_vertexCount{};
 
     bool m_hasIndexBuffer{ false };
     std::unique_ptr<Buffer> m_indexBuffer;
     std::uint32_t m_indexCount{};
 
+    AABB m_bounds;
+    BoundingSphere m_boundingSphere;
+
     void createVertexBuffer(const std::vector<Vertex>& vertices);
+    void createPositionBuffer(const std::vector<Vertex>& vertices);
     void createIndexBuffer(const std::vector<std::uint32_t>& indices);
 };
 
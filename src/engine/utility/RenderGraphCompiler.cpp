@@ -0,0 +1,264 @@
+#include "RenderGraphCompiler.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace vv
+{
+
+namespace
+{
+
+/// \brief Accesses that write memory, only these have to be made available by a barrier
+constexpr VkAccessFlags WRITE_ACCESS_MASK{ VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
+                                           | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT
+                                           | VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT };
+
+/// \brief What the recorded passes have done with a resource so far
+struct ResourceState
+{
+    VkPipelineStageFlags writeStages{ 0 }; ///< Stages of the last write or layout transition
+    VkAccessFlags writeAccessMask{ 0 };
+    VkPipelineStageFlags readStages{ 0 }; ///< Stages that read the resource since the last write
+    VkPipelineStageFlags visibleStages{ 0 };
+    VkAccessFlags visibleAccessMask{ 0 }; ///< Accesses that have already waited for the last write
+    VkImageLayout layout{ VK_IMAGE_LAYOUT_UNDEFINED };
+};
+
+/// \brief Mark every pass that contributes to an imported resource or has side effects
+///
+/// \param resources every resource of the graph
+/// \param passes every pass of the graph
+///
+/// \returns whether each pass is kept
+std::vector<bool> cullPasses(
+    std::span<const RenderGraphResourceInfo> resources, std::span<const RenderGraphPassInfo> passes
+)
+{
+    std::vector<bool> kept(passes.size(), false);
+    // NOTE: A resource is needed while a kept later pass reads its current content
+    std::vector<bool> needed(resources.size(), false);
+
+    for(std::size_t i{ passes.size() }; i-- > 0;)
+    {
+        const auto& pass{ passes[i] };
+
+        const bool keep{ pass.sideEffects || std::ranges::any_of(pass.accesses, [&](const RenderGraphPassAccess& used) {
+                             return used.access.write && (resources[used.resource].imported || needed[used.resource]);
+                         }) };
+        if(!keep)
+            continue;
+
+        kept[i] = true;
+
+        // NOTE: A write replaces the content, so earlier writers are only needed if something before this pass reads
+        for(const auto& access : pass.accesses)
+        {
+            if(access.access.write)
+                needed[access.resource] = false;
+        }
+        for(const auto& access : pass.accesses)
+        {
+            if(!access.access.write)
+                needed[access.resource] = true;
+        }
+    }
+
+    return kept;
+}
+
+/// \brief Compute the barrier that has to precede an access and update the state of the resource
+///
+/// \param state what happened to the resource so far
+/// \param resource the resource that is accessed
+/// \param image whether the resource is an image
+/// \param access the new access
+/// \param barriers where the barrier is added if one is needed
+void addBarrier(
+    ResourceState& state,
+    std::uint32_t resource,
+    bool image,
+    const RenderGraphAccess& access,
+    std::vector<RenderGraphBarrier>& barriers
+)
+{
+    const VkImageLayout layout{ image ? access.layout : VK_IMAGE_LAYOUT_UNDEFINED };
+    const bool transition{ image && layout != state.layout };
+
+    RenderGraphBarrier barrier{ .resource = resource,
+                                .srcStages = 0,
+                                .srcAccessMask = 0,
+                                .dstStages = access.stages,
+                                .dstAccessMask = access.accessMask,
+                                .oldLayout = state.layout,
+                                .newLayout = layout };
+    bool needed{ false };
+
+    if(transition || access.write)
+    {
+        // NOTE: Writes and layout transitions have to wait for every earlier access, but only writes need to be made
+        // available
+        barrier.srcStages = state.writeStages | state.readStages;
+        barrier.srcAccessMask = state.writeAccessMask;
+        needed = transition || barrier.srcStages != 0;
+    }
+    else if(state.writeStages != 0
+            && ((access.stages & ~state.visibleStages) != 0 || (access.accessMask & ~state.visibleAccessMask) != 0))
+    {
+        barrier.srcStages = state.writeStages;
+        barrier.srcAccessMask = state.writeAccessMask;
+        needed = true;
+    }
+
+    if(needed)
+    {
+        if(barrier.srcStages == 0)
+            barrier.srcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+
+        barriers.push_back(barrier);
+    }
+
+    if(access.write)
+    {
+        state.writeStages = access.stages;
+        state.writeAccessMask = access.accessMask & WRITE_ACCESS_MASK;
+        state.readStages = 0;
+        state.visibleStages = 0;
+        state.visibleAccessMask = 0;
+    }
+    else if(transition)
+    {
+        // NOTE: Later reads in other stages chain onto the barrier of the transition through these stages
+        state.writeStages = access.stages;
+        state.writeAccessMask = 0;
+        state.readStages = access.stages;
+        state.visibleStages = access.stages;
+        state.visibleAccessMask = access.accessMask;
+    }
+    else
+    {
+        state.readStages |= access.stages;
+        if(needed)
+        {
+            state.visibleStages |= access.stages;
+            state.visibleAccessMask |= access.accessMask;
+        }
+    }
+
+    state.layout = image ? access.layoutAfter() : VK_IMAGE_LAYOUT_UNDEFINED;
+}
+
+} // namespace
+
+RenderGraphPlan compileRenderGraph(
+    std::span<const RenderGraphResourceInfo> resources, std::span<const RenderGraphPassInfo> passes
+)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    for(const auto& pass : passes)
+    {
+        for(std::size_t i{ 0 }; i < pass.accesses.size(); ++i)
+        {
+            assert(pass.accesses[i].resource < resources.size() && "Pass accesses an unknown resource");
+            for(std::size_t j{ 0 }; j < i; ++j)
+                assert(pass.accesses[i].resource != pass.accesses[j].resource && "Pass accesses a resource twice");
+        }
+    }
+#endif
+
+    const std::vector<bool> kept{ cullPasses(resources, passes) };
+
+    RenderGraphPlan plan{};
+    plan.lifetimes.resize(resources.size());
+
+    std::vector<ResourceState> states(resources.size());
+    for(std::size_t i{ 0 }; i < resources.size(); ++i)
+    {
+        const auto& initial{ resources[i].initialAccess };
+        auto& state{ states[i] };
+
+        if(initial.write)
+        {
+            state.writeStages = initial.stages;
+            state.writeAccessMask = initial.accessMask & WRITE_ACCESS_MASK;
+        }
+        else
+            state.readStages = initial.stages;
+
+        state.layout = resources[i].image ? initial.layoutAfter() : VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+
+    for(std::size_t i{ 0 }; i < passes.size(); ++i)
+    {
+        if(!kept[i])
+            continue;
+
+        const auto position{ static_cast<std::uint32_t>(plan.passes.size()) };
+        plan.passes.push_back(static_cast<std::uint32_t>(i));
+        auto& barriers{ plan.barriers.emplace_back() };
+
+        for(const auto& access : passes[i].accesses)
+        {
+            const bool image{ resources[access.resource].image };
+            addBarrier(states[access.resource], access.resource, image, access.access, barriers);
+
+            auto& lifetime{ plan.lifetimes[access.resource] };
+            lifetime.firstPass = std::min(lifetime.firstPass, position);
+            lifetime.lastPass = std::max(lifetime.lastPass, position);
+        }
+    }
+
+    return plan;
+}
+
+std::vector<RenderGraphAliasSlot> assignAliasSlots(
+    std::span<const RenderGraphLifetime> lifetimes, std::span<const VkMemoryRequirements> requirements
+)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(lifetimes.size() == requirements.size() && "Every resource needs a lifetime and memory requirements");
+    assert(std::ranges::all_of(lifetimes, [](const auto& lifetime) { return lifetime.isUsed(); })
+           && "Only used resources can be placed");
+#endif
+
+    std::vector<std::uint32_t> order(lifetimes.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::ranges::stable_sort(order, [&](std::uint32_t a, std::uint32_t b) {
+        return requirements[a].size > requirements[b].size;
+    });
+
+    std::vector<RenderGraphAliasSlot> slots;
+    for(const std::uint32_t resource : order)
+    {
+        const auto& required{ requirements[resource] };
+
+        const auto slot{ std::ranges::find_if(slots, [&](const RenderGraphAliasSlot& candidate) {
+            return (candidate.requirements.memoryTypeBits & required.memoryTypeBits) != 0
+                   && std::ranges::none_of(candidate.resources, [&](std::uint32_t other) {
+                          return lifetimes[other].overlaps(lifetimes[resource]);
+                      });
+        }) };
+
+        if(slot == slots.end())
+        {
+            slots.push_back({ .requirements = required, .resources = { resource } });
+            continue;
+        }
+
+        slot->requirements.size = std::max(slot->requirements.size, required.size);
+        slot->requirements.alignment = std::max(slot->requirements.alignment, required.alignment);
+        slot->requirements.memoryTypeBits &= required.memoryTypeBits;
+        slot->resources.push_back(resource);
+    }
+
+    return slots;
+}
+
+} // namespace vv
@@ -0,0 +1,243 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_UTILITY_RENDER_GRAPH_COMPILER_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_UTILITY_RENDER_GRAPH_COMPILER_HPP
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace vv
+{
+
+/// \brief How a pass of a render graph uses a resource
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct RenderGraphAccess
+{
+    VkPipelineStageFlags stages{ 0 };
+    VkAccessFlags accessMask{ 0 };
+    VkImageLayout layout{ VK_IMAGE_LAYOUT_UNDEFINED }; ///< Layout while the pass runs, ignored for buffers
+    /// \brief Layout the pass itself leaves the image in (i.e., the final layout of a render pass attachment),
+    /// VK_IMAGE_LAYOUT_UNDEFINED if it stays in \ref layout
+    VkImageLayout finalLayout{ VK_IMAGE_LAYOUT_UNDEFINED };
+    bool write{ false }; ///< Writes replace the content, passes that only add to a resource also have to read it
+
+    [[nodiscard]] constexpr VkImageLayout layoutAfter() const noexcept
+    {
+        return finalLayout == VK_IMAGE_LAYOUT_UNDEFINED ? layout : finalLayout;
+    }
+
+    [[nodiscard]] static constexpr RenderGraphAccess indirectRead() noexcept
+    {
+        return { .stages = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+                 .accessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+                 .layout = VK_IMAGE_LAYOUT_UNDEFINED,
+                 .finalLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                 .write = false };
+    }
+    [[nodiscard]] static constexpr RenderGraphAccess vertexShaderRead() noexcept
+    {
+        return { .stages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                 .accessMask = VK_ACCESS_SHADER_READ_BIT,
+                 .layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                 .finalLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                 .write = false };
+    }
+    [[nodiscard]] static constexpr RenderGraphAccess fragmentShaderRead() noexcept
+    {
+        return { .stages = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                 .accessMask = VK_ACCESS_SHADER_READ_BIT,
+                 .layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                 .finalLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                 .write = false };
+    }
+    /// \param layout the layout in which an image is read, e.g., VK_IMAGE_LAYOUT_GENERAL for storage images
+    [[nodiscard]] static constexpr RenderGraphAccess computeShaderRead(
+        VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+    ) noexcept
+    {
+        return { .stages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                 .accessMask = VK_ACCESS_SHADER_READ_BIT,
+                 .layout = layout,
+                 .finalLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                 .write = false };
+    }
+    [[nodiscard]] static constexpr RenderGraphAccess computeShaderWrite() noexcept
+    {
+        return { .stages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                 .accessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                 .layout = VK_IMAGE_LAYOUT_GENERAL,
+                 .finalLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                 .write = true };
+    }
+    /// \param finalLayout the final layout of the attachment in the render pass
+    [[nodiscard]] static constexpr RenderGraphAccess colorAttachmentWrite(
+        VkImageLayout finalLayout = VK_IMAGE_LAYOUT_UNDEFINED
+    ) noexcept
+    {
+        return { .stages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                 .accessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                 .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                 .finalLayout = finalLayout,
+                 .write = true };
+    }
+    /// \param finalLayout the final layout of the attachment in the render pass
+    [[nodiscard]] static constexpr RenderGraphAccess depthAttachmentWrite(
+        VkImageLayout finalLayout = VK_IMAGE_LAYOUT_UNDEFINED
+    ) noexcept
+    {
+        return { .stages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                 .accessMask
+                 = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                 .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                 .finalLayout = finalLayout,
+                 .write = true };
+    }
+    [[nodiscard]] static constexpr RenderGraphAccess depthAttachmentRead() noexcept
+    {
+        return { .stages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                 .accessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+                 .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+                 .finalLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                 .write = false };
+    }
+    [[nodiscard]] static constexpr RenderGraphAccess transferRead() noexcept
+    {
+        return { .stages = VK_PIPELINE_STAGE_TRANSFER_BIT,
+                 .accessMask = VK_ACCESS_TRANSFER_READ_BIT,
+                 .layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                 .finalLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                 .write = false };
+    }
+    [[nodiscard]] static constexpr RenderGraphAccess transferWrite() noexcept
+    {
+        return { .stages = VK_PIPELINE_STAGE_TRANSFER_BIT,
+                 .accessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                 .layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                 .finalLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                 .write = true };
+    }
+};
+
+/// \brief A resource of a render graph as it is seen by \ref compileRenderGraph
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct RenderGraphResourceInfo
+{
+    bool image{ false };
+    /// \brief Imported resources outlive the graph, so passes that write them are never culled
+    bool imported{ false };
+    /// \brief The last access before the graph, a default access means that the resource has no content yet
+    RenderGraphAccess initialAccess{};
+};
+
+/// \brief A resource that is used by a pass
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct RenderGraphPassAccess
+{
+    std::uint32_t resource{ 0 };
+    RenderGraphAccess access{};
+};
+
+/// \brief A pass of a render graph as it is seen by \ref compileRenderGraph
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct RenderGraphPassInfo
+{
+    std::vector<RenderGraphPassAccess> accesses; ///< Every resource may appear at most once
+    bool sideEffects{ false };                   ///< Keep the pass even if nothing reads what it writes
+};
+
+/// \brief A dependency between the previous accesses of a resource and its access in a pass
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct RenderGraphBarrier
+{
+    std::uint32_t resource{ 0 };
+    VkPipelineStageFlags srcStages{ 0 };
+    VkAccessFlags srcAccessMask{ 0 };
+    VkPipelineStageFlags dstStages{ 0 };
+    VkAccessFlags dstAccessMask{ 0 };
+    VkImageLayout oldLayout{ VK_IMAGE_LAYOUT_UNDEFINED }; ///< Equal to \ref newLayout if there is no transition
+    VkImageLayout newLayout{ VK_IMAGE_LAYOUT_UNDEFINED };
+};
+
+/// \brief The executed passes in which a resource is used, as indices into \ref RenderGraphPlan::passes
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct RenderGraphLifetime
+{
+    std::uint32_t firstPass{ std::numeric_limits<std::uint32_t>::max() };
+    std::uint32_t lastPass{ 0 };
+
+    [[nodiscard]] constexpr bool isUsed() const noexcept { return firstPass <= lastPass; }
+    [[nodiscard]] constexpr bool overlaps(const RenderGraphLifetime& other) const noexcept
+    {
+        return firstPass <= other.lastPass && other.firstPass <= lastPass;
+    }
+};
+
+/// \brief Everything that is needed to record a render graph
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct RenderGraphPlan
+{
+    std::vector<std::uint32_t> passes;                     ///< Indices of the passes that are not culled, in order
+    std::vector<std::vector<RenderGraphBarrier>> barriers; ///< The barriers that are recorded before passes[i]
+    std::vector<RenderGraphLifetime> lifetimes;            ///< Lifetime of every resource
+};
+
+/// \brief A block of memory that is shared by transient resources whose lifetimes do not overlap
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct RenderGraphAliasSlot
+{
+    VkMemoryRequirements requirements{}; ///< Large and aligned enough for every resource, allowed types of all
+    std::vector<std::uint32_t> resources;
+};
+
+/// \brief Cull the passes whose results are never used and compute the barriers between the remaining ones
+///
+/// Walks the passes backwards: a pass is kept if it has side effects, writes an imported resource or writes a
+/// resource that a later kept pass reads. The kept passes run in their declaration order. Before each of them the
+/// resources it uses get a barrier whenever
+/// - the image layout changes,
+/// - the resource was written before and the pass touches it with stages or accesses that have not seen the write,
+/// - the pass writes a resource that was read or written before.
+///
+/// \param resources every resource of the graph, referenced by index in the passes
+/// \param passes every pass of the graph in the order in which they were declared
+///
+/// \returns the passes to execute, their barriers and the lifetimes of the resources
+[[nodiscard]] RenderGraphPlan compileRenderGraph(
+    std::span<const RenderGraphResourceInfo> resources, std::span<const RenderGraphPassInfo> passes
+);
+
+/// \brief Distribute transient resources over as few memory blocks as possible
+///
+/// Resources are placed from the largest to the smallest into the first block whose memory types are compatible and
+/// whose other resources are not alive at the same time. Resources that are only used by culled passes have to be
+/// left out by the caller.
+///
+/// \param lifetimes the lifetime of every transient resource
+/// \param requirements the memory requirements of every transient resource
+///
+/// \returns the blocks, their resources are indices into \p lifetimes
+[[nodiscard]] std::vector<RenderGraphAliasSlot> assignAliasSlots(
+    std::span<const RenderGraphLifetime> lifetimes, std::span<const VkMemoryRequirements> requirements
+);
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_UTILITY_RENDER_GRAPH_COMPILER_HPP
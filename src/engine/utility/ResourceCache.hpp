@@ -0,0 +1,226 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_UTILITY_RESOURCE_CACHE_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_UTILITY_RESOURCE_CACHE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace vv
+{
+
+/// \brief Shares resources that are loaded from the same source and evicts unused ones under a memory budget
+///
+/// Resources are handed out as std::shared_ptr handles, whose reference count tells which ones are still in use. A
+/// load that is still in flight is shared as well, so two requests for the same key only load once. Resources that
+/// no handle refers to anymore stay cached until \ref trim needs the memory, least recently used first. Loads that
+/// failed are forgotten, so the next request tries again.
+///
+/// \tparam T the type of the resource
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+template<typename T>
+class ResourceCache
+{
+public:
+    using Handle = std::shared_ptr<T>;
+    using Future = std::shared_future<Handle>;
+    /// \brief Starts loading a resource that is not cached
+    using Loader = std::function<Future()>;
+    /// \brief How much memory a loaded resource takes up (in byte)
+    using Sizer = std::function<std::size_t(const T&)>;
+
+    /// \brief Create a new \ref ResourceCache
+    ///
+    /// \param budget how much memory the cached resources may take up (in byte) before \ref trim evicts them
+    /// \param sizer measures the memory of a loaded resource
+    ResourceCache(std::size_t budget, Sizer sizer) : m_budget{ budget }, m_sizer{ std::move(sizer) } {}
+    ~ResourceCache() = default;
+
+    ResourceCache(const ResourceCache&) = delete;
+    ResourceCache(ResourceCache&&) = delete;
+    ResourceCache& operator=(const ResourceCache&) = delete;
+    ResourceCache& operator=(ResourceCache&&) = delete;
+
+    [[nodiscard]] std::size_t getBudget() const noexcept { return m_budget; }
+
+    /// \brief Requests that were answered by a resource that was cached or in flight
+    [[nodiscard]] std::size_t getHits() const
+    {
+        const std::scoped_lock lock{ m_mutex };
+        return m_hits;
+    }
+
+    /// \brief Requests that started a load
+    [[nodiscard]] std::size_t getMisses() const
+    {
+        const std::scoped_lock lock{ m_mutex };
+        return m_misses;
+    }
+
+    [[nodiscard]] std::size_t getEvictions() const
+    {
+        const std::scoped_lock lock{ m_mutex };
+        return m_evictions;
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        const std::scoped_lock lock{ m_mutex };
+        return m_entries.size();
+    }
+
+    [[nodiscard]] bool contains(const std::string& key) const
+    {
+        const std::scoped_lock lock{ m_mutex };
+        return m_entries.contains(key);
+    }
+
+    /// \brief Memory taken up by the resources that have finished loading (in byte)
+    [[nodiscard]] std::size_t getMemoryUsage()
+    {
+        const std::scoped_lock lock{ m_mutex };
+
+        std::size_t usage{ 0 };
+        for(auto& [key, entry] : m_entries)
+            usage += measure(entry).value_or(0);
+
+        return usage;
+    }
+
+    /// \brief Get a resource from the cache or start loading it
+    ///
+    /// \param key identifies the source of the resource, i.e., its normalized path
+    /// \param load starts the load if the resource is neither cached nor in flight
+    ///
+    /// \returns the resource once it has been loaded
+    [[nodiscard]] Future acquire(const std::string& key, const Loader& load)
+    {
+        const std::scoped_lock lock{ m_mutex };
+
+        if(const auto it{ m_entries.find(key) }; it != m_entries.end())
+        {
+            if(!hasFailed(it->second.future))
+            {
+                it->second.lastUse = ++m_useCounter;
+                ++m_hits;
+                return it->second.future;
+            }
+
+            m_entries.erase(it);
+        }
+
+        // NOTE: Loaded before the entry is added, so a loader that throws leaves nothing behind
+        Future future{ load() };
+        ++m_misses;
+        m_entries.emplace(key, Entry{ .future = future, .size = std::nullopt, .lastUse = ++m_useCounter });
+
+        return future;
+    }
+
+    /// \brief Evict loaded resources that no handle refers to until the cache fits into its budget
+    ///
+    /// The least recently requested resources are evicted first. Resources that are in use or still loading are
+    /// never evicted, so the cache can stay above the budget
+    ///
+    /// \returns how many resources were evicted
+    std::size_t trim()
+    {
+        const std::scoped_lock lock{ m_mutex };
+
+        std::size_t usage{ 0 };
+        for(auto& [key, entry] : m_entries)
+            usage += measure(entry).value_or(0);
+
+        std::size_t evicted{ 0 };
+        while(usage > m_budget)
+        {
+            auto victim{ m_entries.end() };
+            for(auto it{ m_entries.begin() }; it != m_entries.end(); ++it)
+            {
+                if(!isEvictable(it->second))
+                    continue;
+                if(victim == m_entries.end() || it->second.lastUse < victim->second.lastUse)
+                    victim = it;
+            }
+
+            if(victim == m_entries.end())
+                break;
+
+            usage -= victim->second.size.value_or(0);
+            m_entries.erase(victim);
+            ++evicted;
+        }
+
+        m_evictions += evicted;
+
+        return evicted;
+    }
+
+private:
+    /// \brief A resource that is cached or in flight
+    struct Entry
+    {
+        Future future;
+        std::optional<std::size_t> size; ///< Measured once the resource has finished loading
+        std::uint64_t lastUse{ 0 };      ///< Value of the use counter at the last request
+    };
+
+    std::size_t m_budget;
+    Sizer m_sizer;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Entry> m_entries;
+    std::uint64_t m_useCounter{ 0 };
+    std::size_t m_hits{ 0 };
+    std::size_t m_misses{ 0 };
+    std::size_t m_evictions{ 0 };
+
+    [[nodiscard]] static bool isReady(const Future& future)
+    {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    [[nodiscard]] static bool hasFailed(const Future& future)
+    {
+        if(!isReady(future))
+            return false;
+
+        try
+        {
+            return future.get() == nullptr;
+        }
+        catch(...)
+        {
+            return true;
+        }
+    }
+
+    /// \brief The memory of a resource, std::nullopt while it is loading or if its load failed
+    [[nodiscard]] std::optional<std::size_t> measure(Entry& entry) const
+    {
+        if(!entry.size.has_value() && isReady(entry.future) && !hasFailed(entry.future))
+            entry.size = m_sizer(*entry.future.get());
+
+        return entry.size;
+    }
+
+    /// \brief Whether the cache holds the only reference to a loaded resource
+    [[nodiscard]] static bool isEvictable(const Entry& entry)
+    {
+        // NOTE: The future keeps one reference itself, every other one belongs to a handle
+        return entry.size.has_value() && entry.future.get().use_count() == 1;
+    }
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_UTILITY_RESOURCE_CACHE_HPP
@@ -0,0 +1,64 @@
+#include "RingAllocator.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <optional>
+
+namespace vv
+{
+
+RingAllocator::RingAllocator(std::uint64_t capacity)
+    : m_capacity{ capacity }
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(capacity > 0 && "A ring needs a capacity");
+#endif
+}
+
+std::optional<std::uint64_t> RingAllocator::allocate(std::uint64_t size, std::uint64_t alignment)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0 && "Alignment has to be a power of two");
+    assert(m_capacity % alignment == 0 && "The capacity has to be a multiple of the alignment");
+#endif
+
+    if(size > m_capacity)
+        return std::nullopt;
+
+    std::uint64_t position{ (m_head + alignment - 1) & ~(alignment - 1) };
+
+    // NOTE: Ranges do not wrap around, the rest of the ring is skipped instead
+    if((position % m_capacity) + size > m_capacity)
+        position = ((position / m_capacity) + 1) * m_capacity;
+
+    if(position + size - m_tail > m_capacity)
+        return std::nullopt;
+
+    m_head = position + size;
+
+    return position % m_capacity;
+}
+
+void RingAllocator::close(std::uint64_t value)
+{
+    if(!hasOpenBatch())
+        return;
+
+#if defined(VV_ENABLE_ASSERTS)
+    assert((m_batches.empty() || m_batches.back().value <= value) && "Batches have to be closed in timeline order");
+#endif
+
+    m_batches.push_back({ .end = m_head, .value = value });
+    m_closed = m_head;
+}
+
+void RingAllocator::release(std::uint64_t completedValue)
+{
+    while(!m_batches.empty() && m_batches.front().value <= completedValue)
+    {
+        m_tail = m_batches.front().end;
+        m_batches.pop_front();
+    }
+}
+
+} // namespace vv
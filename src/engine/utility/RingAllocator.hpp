@@ -0,0 +1,77 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_UTILITY_RING_ALLOCATOR_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_UTILITY_RING_ALLOCATOR_HPP
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+namespace vv
+{
+
+/// \brief Hands out ranges of a fixed size ring buffer that are given back in the order they were handed out
+///
+/// Allocations are grouped into batches. A batch is closed with the timeline value of the submission that reads its
+/// ranges and is released once the timeline has reached that value. An allocation never wraps around the end of the
+/// ring, so every range is contiguous.
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+class RingAllocator
+{
+public:
+    /// \brief Create a new \ref RingAllocator
+    ///
+    /// \param capacity size of the ring in bytes
+    explicit RingAllocator(std::uint64_t capacity);
+    ~RingAllocator() = default;
+
+    RingAllocator(const RingAllocator&) = default;
+    RingAllocator(RingAllocator&&) = default;
+    RingAllocator& operator=(const RingAllocator&) = default;
+    RingAllocator& operator=(RingAllocator&&) = default;
+
+    [[nodiscard]] std::uint64_t getCapacity() const noexcept { return m_capacity; }
+    /// \brief Bytes that are handed out and not released yet, including the padding in front of allocations
+    [[nodiscard]] std::uint64_t getUsed() const noexcept { return m_head - m_tail; }
+    /// \brief Whether there are allocations that have not been closed into a batch yet
+    [[nodiscard]] bool hasOpenBatch() const noexcept { return m_head != m_closed; }
+    /// \brief Whether there are closed batches that have not been released yet
+    [[nodiscard]] bool hasPendingBatches() const noexcept { return !m_batches.empty(); }
+    /// \brief Timeline value of the oldest batch that has not been released yet, only valid with pending batches
+    [[nodiscard]] std::uint64_t getOldestPendingValue() const noexcept { return m_batches.front().value; }
+
+    /// \brief Hand out a range of the ring
+    ///
+    /// \param size size of the range in bytes
+    /// \param alignment alignment of the offset, a power of two
+    ///
+    /// \returns the offset of the range, std::nullopt if there is not enough free space
+    [[nodiscard]] std::optional<std::uint64_t> allocate(std::uint64_t size, std::uint64_t alignment);
+    /// \brief Close the open allocations into a batch
+    ///
+    /// \param value the timeline value after which the ranges of the batch are not read anymore
+    void close(std::uint64_t value);
+    /// \brief Give every batch back whose value the timeline has reached
+    ///
+    /// \param completedValue the current value of the timeline
+    void release(std::uint64_t completedValue);
+
+private:
+    /// \brief Allocations up to the end, that are free once the timeline reached the value
+    struct Batch
+    {
+        std::uint64_t end{ 0 };
+        std::uint64_t value{ 0 };
+    };
+
+    // NOTE: Positions only grow, the offset in the ring is the position modulo the capacity
+    std::uint64_t m_capacity;
+    std::uint64_t m_head{ 0 };   ///< Position of the next allocation
+    std::uint64_t m_tail{ 0 };   ///< Position of the oldest allocation that is not released
+    std::uint64_t m_closed{ 0 }; ///< End of the last closed batch
+    std::deque<Batch> m_batches;
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_UTILITY_RING_ALLOCATOR_HPP
@@ -1,34 +1,110 @@
 #include "Scene.hpp"
 
-#include "core/DescriptorWriter.hpp"
 #include "core/Device.hpp"
-#include "utility/exceptions/Exception.hpp"
+#include "core/Texture2D.hpp"
+#include "utility/AssetLoader.hpp"
+#include "utility/Model.hpp"
 #include "utility/material/DefaultTextureProvider.hpp"
+#include "utility/material/MaterialTable.hpp"
 #include "utility/object/ObjectBuilder.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
 #include <memory>
+#include <string>
 #include <utility>
-#include <vulkan/vulkan_core.h>
+#include <vector>
+
+namespace
+{
+
+/// \brief Cache key of a file, equal for every spelling of the same path
+///
+/// \param filepath path to the file
+///
+/// \returns the normalized path
+std::string cacheKey(const std::filesystem::path& filepath)
+{
+    return filepath.lexically_normal().generic_string();
+}
+
+/// \brief Cache key of a texture, the same file is a different texture with another config
+///
+/// \param filepath path to the image file
+/// \param config \ref TextureConfig of the texture
+///
+/// \returns the normalized path together with the config
+std::string cacheKey(const std::filesystem::path& filepath, const vv::TextureConfig& config)
+{
+    return std::format(
+        "{}|{}|{}|{}|{}|{}|{}|{}",
+        ::cacheKey(filepath),
+        static_cast<int>(config.format),
+        static_cast<int>(config.minFilter),
+        static_cast<int>(config.magFilter),
+        static_cast<int>(config.addressMode),
+        static_cast<int>(config.mipmapMode),
+        config.mipmapsEnable,
+        config.anisotropyEnable
+    );
+}
+
+} // namespace
 
 namespace vv
 {
 
-Scene::Scene(std::shared_ptr<Device> device, std::shared_ptr<DescriptorSetLayout> materialLayout)
+Scene::Scene(
+    std::shared_ptr<Device> device,
+    std::shared_ptr<MaterialTable> materialTable,
+    std::size_t textureCacheBudget,
+    std::size_t modelCacheBudget
+)
     : m_device(std::move(device))
     , m_defaultTextures{ std::make_shared<DefaultTextureProvider>(this->m_device) }
-    , m_materialSetLayout(std::move(materialLayout))
+    , m_materialTable(std::move(materialTable))
+    , m_textureCache{ textureCacheBudget, [](const Texture2D& texture) { return texture.memorySize(); } }
+    , m_modelCache{ modelCacheBudget, [](const Model& model) { return model.getMemorySize(); } }
     , m_objects{ std::make_shared<Object::ObjectMap>() }
+{}
+
+AssetLoader::Future<Texture2D>
+    Scene::loadTexture(AssetLoader& assets, const std::filesystem::path& filepath, const TextureConfig& config)
+{
+    return m_textureCache.acquire(::cacheKey(filepath, config), [&assets, &filepath, &config]() {
+        return assets.loadTexture(filepath, config);
+    });
+}
+
+AssetLoader::Future<Model> Scene::loadModel(AssetLoader& assets, const std::filesystem::path& filepath)
+{
+    return m_modelCache.acquire(::cacheKey(filepath), [&assets, &filepath]() { return assets.loadModel(filepath); });
+}
+
+std::size_t Scene::trimCaches()
+{
+    releaseUnusedMaterials();
+
+    return m_textureCache.trim() + m_modelCache.trim();
+}
+
+bool Scene::containsTexture(const std::filesystem::path& filepath, const TextureConfig& config) const
+{
+    return m_textureCache.contains(::cacheKey(filepath, config));
+}
+
+bool Scene::containsModel(const std::filesystem::path& filepath) const
 {
-    m_materialPool = DescriptorPool::Builder(m_device)
-                         .setMaxSets(MAX_MATERIAL_SETS)
-                         .addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MATERIAL_POOL_SIZE)
-                         .build();
+    return m_modelCache.contains(::cacheKey(filepath));
 }
 
 std::shared_ptr<Material> Scene::createMaterial(MaterialConfig& config)
 {
-    VkDescriptorSet descriptorSet{ allocateMaterialDescriptorSet(config) };
-    m_materialCache.emplace_back(std::make_shared<Material>(m_device, config, descriptorSet));
+    applyDefaultTextures(config);
+    const std::uint32_t materialIndex{ m_materialTable->addMaterial(config) };
+    m_materialCache.emplace_back(std::make_shared<Material>(m_device, config, materialIndex));
 
     return m_materialCache.back();
 }
@@ -43,13 +119,8 @@ void Scene::addPointlight(Object&& o)
     m_pointLights.emplace_back(std::move(o));
 }
 
-VkDescriptorSet Scene::allocateMaterialDescriptorSet(MaterialConfig& config)
+void Scene::applyDefaultTextures(MaterialConfig& config) const
 {
-    VkDescriptorSet descriptorSet{ VK_NULL_HANDLE };
-
-    if(!m_materialPool->allocateDescriptor(m_materialSetLayout->getDescriptorLayout(), descriptorSet))
-        throw Exception("Failed to allocate material descriptor set");
-
     if(!config.albedoTexture)
         config.albedoTexture = m_defaultTextures->white();
     if(!config.normalTexture)
@@ -60,22 +131,21 @@ VkDescriptorSet Scene::allocateMaterialDescriptorSet(MaterialConfig& config)
         config.occlusionTexture = m_defaultTextures->white();
     if(!config.emissiveTexture)
         config.emissiveTexture = m_defaultTextures->black();
+}
+
+/// \brief Remove the materials that nothing but the scene refers to from the material table
+///
+/// Drops the last references of the material table and the material to their textures, so that the texture cache can
+/// evict them
+void Scene::releaseUnusedMaterials()
+{
+    std::erase_if(m_materialCache, [this](const std::shared_ptr<Material>& material) {
+        if(material.use_count() > 1)
+            return false;
 
-    auto albedoInfo{ config.albedoTexture->descriptor() };
-    auto normalInfo{ config.normalTexture->descriptor() };
-    auto metallicRoughnessInfo{ config.metallicRoughnessTexture->descriptor() };
-    auto occlusionInfo{ config.occlusionTexture->descriptor() };
-    auto emissiveInfo{ config.emissiveTexture->descriptor() };
-
-    DescriptorWriter(m_materialSetLayout.get(), m_materialPool.get())
-        .writeImage(0, &albedoInfo)
-        .writeImage(1, &normalInfo)
-        .writeImage(2, &metallicRoughnessInfo)
-        .writeImage(3, &occlusionInfo)
-        .writeImage(4, &emissiveInfo)
-        .overwrite(descriptorSet);
-
-    return descriptorSet;
+        m_materialTable->removeMaterial(material->getIndex());
+        return true;
+    });
 }
 
 } // namespace vv
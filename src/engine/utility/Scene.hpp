@@ -1,19 +1,19 @@
 #ifndef VULKAN_VOXELS_SRC_ENGINE_UTILITY_SCENE_HPP
 #define VULKAN_VOXELS_SRC_ENGINE_UTILITY_SCENE_HPP
 
-#include "core/DescriptorPool.hpp"
-#include "core/DescriptorSetLayout.hpp"
 #include "core/Device.hpp"
 #include "core/Texture2D.hpp"
+#include "utility/AssetLoader.hpp"
 #include "utility/Model.hpp"
+#include "utility/ResourceCache.hpp"
 #include "utility/material/DefaultTextureProvider.hpp"
 #include "utility/material/Material.hpp"
+#include "utility/material/MaterialTable.hpp"
 #include "utility/object/Object.hpp"
 
 #include <cstddef>
 #include <filesystem>
 #include <memory>
-#include <unordered_map>
 #include <vector>
 
 namespace vv
@@ -22,13 +22,58 @@ namespace vv
 class Scene
 {
 public:
-    Scene(std::shared_ptr<Device> device, std::shared_ptr<DescriptorSetLayout> materialLayout);
+    /// \brief Memory that unused textures may keep taking up before \ref trimCaches evicts them (in byte)
+    static constexpr std::size_t TEXTURE_CACHE_BUDGET{ 256ULL * 1024 * 1024 };
+    /// \brief Memory that unused models may keep taking up before \ref trimCaches evicts them (in byte)
+    static constexpr std::size_t MODEL_CACHE_BUDGET{ 64ULL * 1024 * 1024 };
+
+    /// \brief Create a new empty \ref Scene
+    ///
+    /// \param device the \ref Device the resources of the scene are created on
+    /// \param materialTable the \ref MaterialTable that holds the materials of the scene
+    /// \param textureCacheBudget memory that unused textures may keep taking up (in byte)
+    /// \param modelCacheBudget memory that unused models may keep taking up (in byte)
+    Scene(
+        std::shared_ptr<Device> device,
+        std::shared_ptr<MaterialTable> materialTable,
+        std::size_t textureCacheBudget = TEXTURE_CACHE_BUDGET,
+        std::size_t modelCacheBudget = MODEL_CACHE_BUDGET
+    );
     ~Scene() = default;
 
     Scene(const Scene&) = delete;
-    Scene(Scene&&) = default;
+    Scene(Scene&&) = delete;
     Scene& operator=(const Scene&) = delete;
-    Scene& operator=(Scene&&) = default;
+    Scene& operator=(Scene&&) = delete;
+
+    /// \brief Load a texture, sharing it with every other request for the same file and config
+    ///
+    /// \param assets the \ref AssetLoader that loads the file if it is neither cached nor in flight
+    /// \param filepath the image file
+    /// \param config \ref TextureConfig of the texture
+    ///
+    /// \returns the texture once it has been created by \p assets
+    [[nodiscard]] AssetLoader::Future<Texture2D>
+        loadTexture(AssetLoader& assets, const std::filesystem::path& filepath, const TextureConfig& config);
+    /// \brief Load a model, sharing it with every other request for the same file
+    ///
+    /// \param assets the \ref AssetLoader that loads the file if it is neither cached nor in flight
+    /// \param filepath the .obj file
+    ///
+    /// \returns the model once it has been created by \p assets
+    [[nodiscard]] AssetLoader::Future<Model> loadModel(AssetLoader& assets, const std::filesystem::path& filepath);
+    /// \brief Evict textures and models that are not used anymore until the caches fit into their budgets
+    ///
+    /// Materials that are only held by the scene are removed from the \ref MaterialTable first, so that their textures
+    /// become unused. Evicted resources are destroyed once the GPU work that may still use them has finished
+    ///
+    /// \returns how many textures and models were evicted
+    std::size_t trimCaches();
+
+    /// \brief Whether a texture of the file and config is cached or in flight
+    [[nodiscard]] bool containsTexture(const std::filesystem::path& filepath, const TextureConfig& config) const;
+    /// \brief Whether a model of the file is cached or in flight
+    [[nodiscard]] bool containsModel(const std::filesystem::path& filepath) const;
 
     std::shared_ptr<Material> createMaterial(MaterialConfig& config);
     void addObject(Object&& o);
@@ -39,25 +84,22 @@ public:
     [[nodiscard]] std::vector<Object>& getPointLights() { return m_pointLights; }
 
 private:
-    static constexpr std::size_t MAX_MATERIAL_SETS{ 100 };
-    static constexpr std::size_t MATERIAL_POOL_SIZE{ 500 };
-
     // Utility for managing resources of a scene
     std::shared_ptr<Device> m_device;                          ///< Used to allocate textures on
     std::shared_ptr<DefaultTextureProvider> m_defaultTextures; ///< Can use when a Material has no textures
-    std::shared_ptr<DescriptorSetLayout> m_materialSetLayout;  ///< Descriptor set layout for materials
-    std::unique_ptr<DescriptorPool> m_materialPool;            ///< Pool to allocate material descriptors from
+    std::shared_ptr<MaterialTable> m_materialTable;            ///< Bindless storage of every material
 
     // Containers for scene resources
-    std::unordered_map<std::filesystem::path, std::shared_ptr<Texture2D>> m_textureCache; ///< Textures
-    std::unordered_map<std::filesystem::path, std::shared_ptr<Model>> m_modelCache;       ///< Models
-    std::vector<std::shared_ptr<Material>> m_materialCache;                               ///< Materials
+    ResourceCache<Texture2D> m_textureCache;                ///< Textures
+    ResourceCache<Model> m_modelCache;                      ///< Models
+    std::vector<std::shared_ptr<Material>> m_materialCache; ///< Materials
 
     // Scene objects
     std::shared_ptr<Object::ObjectMap> m_objects; ///< Objects
     std::vector<Object> m_pointLights;            ///< Lights
 
-    VkDescriptorSet allocateMaterialDescriptorSet(MaterialConfig& config);
+    void applyDefaultTextures(MaterialConfig& config) const;
+    void releaseUnusedMaterials();
 };
 
 } // namespace vv
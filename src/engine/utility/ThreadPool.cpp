@@ -0,0 +1,118 @@
+#include "ThreadPool.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace vv
+{
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(threadCount > 0 && "A thread pool needs at least the calling thread");
+#endif
+
+    m_workers.reserve(threadCount - 1);
+    for(std::size_t thread{ 1 }; thread < threadCount; ++thread)
+        m_workers.emplace_back([this, thread]() { workerLoop(thread); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        const std::scoped_lock lock{ m_mutex };
+        m_stopping = true;
+    }
+    m_workAvailable.notify_all();
+
+    for(auto& worker : m_workers)
+        worker.join();
+}
+
+void ThreadPool::parallelFor(std::size_t count, std::size_t rangeCount, const RangeTask& task)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(rangeCount > 0 && rangeCount <= getThreadCount() && "Every range needs its own thread");
+#endif
+
+    {
+        const std::scoped_lock lock{ m_mutex };
+        m_task = &task;
+        m_count = count;
+        m_rangeCount = rangeCount;
+        m_pendingRanges = rangeCount - 1;
+        m_exception = nullptr;
+        ++m_generation;
+    }
+    if(rangeCount > 1)
+        m_workAvailable.notify_all();
+
+    runRange(0);
+
+    std::unique_lock lock{ m_mutex };
+    m_workDone.wait(lock, [this]() { return m_pendingRanges == 0; });
+    m_task = nullptr;
+
+    if(m_exception != nullptr)
+        std::rethrow_exception(m_exception);
+}
+
+/// \brief Wait for work and run the range of the thread until the pool is destroyed
+///
+/// \param thread the index of the worker's thread, 0 is reserved for the calling thread
+void ThreadPool::workerLoop(std::size_t thread)
+{
+    std::uint64_t seenGeneration{ 0 };
+
+    while(true)
+    {
+        {
+            std::unique_lock lock{ m_mutex };
+            m_workAvailable.wait(lock, [this, seenGeneration]() {
+                return m_stopping || m_generation != seenGeneration;
+            });
+
+            if(m_stopping)
+                return;
+
+            seenGeneration = m_generation;
+            // NOTE: A later call can only start once every range of this one is done, so a worker that wakes up late
+            // only misses calls that did not need it
+            if(thread >= m_rangeCount)
+                continue;
+        }
+
+        runRange(thread);
+
+        {
+            const std::scoped_lock lock{ m_mutex };
+            --m_pendingRanges;
+            if(m_pendingRanges != 0)
+                continue;
+        }
+        m_workDone.notify_one();
+    }
+}
+
+/// \brief Run the range that belongs to a thread and keep the first exception for the caller
+///
+/// \param thread the index of the thread that runs the range
+void ThreadPool::runRange(std::size_t thread)
+{
+    try
+    {
+        (*m_task)(rangeBegin(m_count, m_rangeCount, thread), rangeBegin(m_count, m_rangeCount, thread + 1), thread);
+    }
+    catch(...)
+    {
+        const std::scoped_lock lock{ m_mutex };
+        if(m_exception == nullptr)
+            m_exception = std::current_exception();
+    }
+}
+
+} // namespace vv
@@ -0,0 +1,79 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_UTILITY_THREAD_POOL_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_UTILITY_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vv
+{
+
+/// \brief Fixed set of worker threads that split a range of work between them
+///
+/// The thread that calls \ref parallelFor takes part in the work as thread 0, so a pool with a thread count of one
+/// has no workers and runs everything on the caller. Range i is always run by thread i, which allows per thread
+/// resources like command pools to be indexed by the thread index without any locking.
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+class ThreadPool
+{
+public:
+    /// \brief Records the elements [begin, end) on the thread with the given index
+    using RangeTask = std::function<void(std::size_t begin, std::size_t end, std::size_t thread)>;
+
+    /// \brief Create a new \ref ThreadPool
+    ///
+    /// \param threadCount how many threads work on a range, including the calling thread. At least one
+    explicit ThreadPool(std::size_t threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    [[nodiscard]] std::size_t getThreadCount() const noexcept { return m_workers.size() + 1; }
+
+    /// \brief Split [0, count) into contiguous ranges of nearly equal size and run them in parallel
+    ///
+    /// Blocks until every range is done. Ranges can be empty if there are fewer elements than ranges. If a task
+    /// throws, the first exception is rethrown on the calling thread once every range has finished
+    ///
+    /// \param count how many elements there are
+    /// \param rangeCount into how many ranges the elements are split, at most \ref getThreadCount
+    /// \param task the work that is done for each range
+    void parallelFor(std::size_t count, std::size_t rangeCount, const RangeTask& task);
+
+    /// \brief The first element of a range when count elements are split into rangeCount ranges
+    [[nodiscard]] static constexpr std::size_t rangeBegin(std::size_t count, std::size_t rangeCount, std::size_t range)
+    {
+        return count * range / rangeCount;
+    }
+
+private:
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_workDone;
+    const RangeTask* m_task{ nullptr };
+    std::size_t m_count{ 0 };
+    std::size_t m_rangeCount{ 0 };
+    std::uint64_t m_generation{ 0 }; ///< Incremented for every call of \ref parallelFor
+    std::size_t m_pendingRanges{ 0 };
+    std::exception_ptr m_exception;
+    bool m_stopping{ false };
+
+    void workerLoop(std::size_t thread);
+    void runRange(std::size_t thread);
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_UTILITY_THREAD_POOL_HPP
@@ -5,13 +5,14 @@
 
 #include <vulkan/vulkan_core.h>
 
+#include <cstdint>
 #include <memory>
 #include <utility>
 
 namespace vv
 {
 
-Material::Material(std::shared_ptr<Device> device, const MaterialConfig& config, VkDescriptorSet descriptor)
+Material::Material(std::shared_ptr<Device> device, const MaterialConfig& config, std::uint32_t materialIndex)
     : device(std::move(device))
     , m_albedoTexture(std::move(config.albedoTexture))
     , m_normalTexture(std::move(config.normalTexture))
@@ -27,11 +28,12 @@ Material::Material(std::shared_ptr<Device> device, const MaterialConfig& config,
     , m_alphaCutoff{ config.alphaCutoff }
     , m_alphaMode{ config.alphaMode }
     , m_doubleSided{ config.doubleSided }
-    , m_descriptorSet(descriptor)
+    , m_materialIndex{ materialIndex }
 {}
 
 Material::Material(Material&& other) noexcept
     : device(std::move(other.device))
+    , m_id{ other.m_id }
     , m_albedoTexture(std::move(other.m_albedoTexture))
     , m_normalTexture(std::move(other.m_normalTexture))
     , m_metallicRoughnessTexture(std::move(other.m_metallicRoughnessTexture))
@@ -46,21 +48,12 @@ Material::Material(Material&& other) noexcept
     , m_alphaCutoff{ other.m_alphaCutoff }
     , m_alphaMode{ other.m_alphaMode }
     , m_doubleSided{ other.m_doubleSided }
-    , m_descriptorSet(other.m_descriptorSet)
+    , m_materialIndex{ other.m_materialIndex }
 {}
 
 void Material::bind(VkCommandBuffer commandBuffer, VkPipelineLayout layout)
 {
-    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 1, 1, &m_descriptorSet, 0, nullptr);
-
-    MaterialPushConstants push{
-        .baseColorFactor = m_baseColorFactor,
-        .emissiveFactor = m_emissiveFactor,
-        .normalScale = m_normalScale,
-        .metallicFactor = m_metallicFactor,
-        .roughnessFactor = m_roughnessFactor,
-        .occlusionStrength = m_occlusionStrength,
-    };
+    MaterialPushConstants push{ .materialIndex = m_materialIndex };
 
     vkCmdPushConstants(
         commandBuffer,
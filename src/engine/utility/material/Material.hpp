@@ -4,12 +4,14 @@
 #include "core/Device.hpp"
 #include "core/Texture2D.hpp"
 #include "utility/material/MaterialAlphaMode.hpp"
+#include "utility/object/IdPool.hpp"
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #include "glm/glm.hpp"
 #include <vulkan/vulkan_core.h>
 
+#include <cstdint>
 #include <memory>
 
 namespace vv
@@ -49,22 +51,16 @@ public:
     bool doubleSided{ DEFAULT_DOUBLE_SIDED };
 };
 
-static constexpr unsigned int PUSH_VECTOR_ALIGNMENT{ 16 };
-
 /// \brief Push constant layout for materials
 ///
+/// The parameters and textures of a material live in the \ref MaterialTable, draws only select them by index
+///
 /// \author Felix Hommel
 /// \date 12/17/2025
 struct MaterialPushConstants
 {
 public:
-    glm::vec4 baseColorFactor;
-    alignas(PUSH_VECTOR_ALIGNMENT) glm::vec3 emissiveFactor;
-    float normalScale;
-    float metallicFactor;
-    float roughnessFactor;
-    float occlusionStrength;
-    float alphaCutoff;
+    std::uint32_t materialIndex;
 };
 
 /// \brief PBR based Material
@@ -75,7 +71,11 @@ class Material
 {
 public:
     /// \brief Create a new Material
-    Material(std::shared_ptr<Device> device, const MaterialConfig& config, VkDescriptorSet descriptor);
+    ///
+    /// \param device the \ref Device the material is used on
+    /// \param config configuration of the material
+    /// \param materialIndex index of the material in the \ref MaterialTable
+    Material(std::shared_ptr<Device> device, const MaterialConfig& config, std::uint32_t materialIndex);
     Material(Material&& other) noexcept;
     ~Material() = default;
 
@@ -83,16 +83,25 @@ public:
     Material& operator=(const Material&) = delete;
     Material& operator=(Material&&) = delete;
 
+    /// \brief Unique id of the material, i.e., to sort draws by the material they bind
+    [[nodiscard]] std::uint32_t getId() const noexcept { return m_id; }
+    /// \brief Index of the material in the \ref MaterialTable
+    [[nodiscard]] std::uint32_t getIndex() const noexcept { return m_materialIndex; }
+
     /// \brief Binde the material to the pipeline
     ///
-    /// This does not bind any models or meshes - only the textures related to the material are bound by this method
+    /// This does not bind any models or meshes or descriptor sets - only the index of the material is pushed, the
+    /// \ref MaterialTable has to be bound before
     ///
     /// \param commandBuffer the command buffer that is rendered to
     /// \param layoput the layout of the used graphics pipeline
     void bind(VkCommandBuffer commandBuffer, VkPipelineLayout layout);
 
 private:
+    inline static IdPool s_idPool{};
+
     std::shared_ptr<Device> device;
+    std::uint32_t m_id{ s_idPool.acquire() };
 
     // Textures (optional)
     std::shared_ptr<Texture2D> m_albedoTexture;            ///< Base color of the material
@@ -115,7 +124,7 @@ private:
     bool m_doubleSided;    ///< Whether to render both sides or not
 
     // Vulkan Resources
-    VkDescriptorSet m_descriptorSet{ VK_NULL_HANDLE }; ///< The Descriptor set for the Material
+    std::uint32_t m_materialIndex; ///< Index of the material in the material table
 };
 
 } // namespace vv
@@ -0,0 +1,232 @@
+#include "MaterialTable.hpp"
+
+#include "core/Buffer.hpp"
+#include "core/DescriptorPool.hpp"
+#include "core/DescriptorSetLayout.hpp"
+#include "core/DescriptorWriter.hpp"
+#include "core/Device.hpp"
+#include "core/Texture2D.hpp"
+#include "utility/exceptions/Exception.hpp"
+#include "utility/material/Material.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace vv
+{
+
+MaterialTable::MaterialTable(std::shared_ptr<Device> device)
+    : device{ std::move(device) }
+{
+    if(!isSupported(*this->device))
+        throw Exception("Bindless materials require descriptor indexing support");
+
+    m_setLayout = DescriptorSetLayout::Builder(this->device)
+                      .addBinding(MATERIAL_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT)
+                      .addBinding(
+                          TEXTURE_BINDING,
+                          VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                          VK_SHADER_STAGE_FRAGMENT_BIT,
+                          MAX_TEXTURES
+                      )
+                      .setBindingFlags(MATERIAL_BINDING, VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT)
+                      .setBindingFlags(
+                          TEXTURE_BINDING,
+                          VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
+                      )
+                      .setLayoutFlags(VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT)
+                      .buildShared();
+
+    m_pool = DescriptorPool::Builder(this->device)
+                 .setMaxSets(1)
+                 .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1)
+                 .addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_TEXTURES)
+                 .setPoolFlags(VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT)
+                 .build();
+
+    if(!m_pool->allocateDescriptor(m_setLayout->getDescriptorLayout(), m_descriptorSet))
+        throw Exception("Failed to allocate material table descriptor set");
+
+    reserveMaterials(MIN_MATERIAL_CAPACITY);
+}
+
+bool MaterialTable::isSupported(const Device& device) noexcept
+{
+    const auto& features{ device.enabledVulkan12Features() };
+
+    return features.runtimeDescriptorArray == VK_TRUE && features.descriptorBindingPartiallyBound == VK_TRUE
+           && features.shaderSampledImageArrayNonUniformIndexing == VK_TRUE
+           && features.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE
+           && features.descriptorBindingStorageBufferUpdateAfterBind == VK_TRUE;
+}
+
+std::uint32_t MaterialTable::addMaterial(const MaterialConfig& config)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(
+        config.albedoTexture && config.normalTexture && config.metallicRoughnessTexture && config.occlusionTexture
+        && config.emissiveTexture && "Every texture of a material has to be set"
+    );
+#endif
+
+    const MaterialData data{ .baseColorFactor = config.baseColorFactor,
+                             .emissiveFactor = config.emissiveFactor,
+                             .normalScale = config.normalScale,
+                             .metallicFactor = config.metallicFactor,
+                             .roughnessFactor = config.roughnessFactor,
+                             .occlusionStrength = config.occlusionStrength,
+                             .alphaCutoff = config.alphaCutoff,
+                             .albedoTexture = addTexture(config.albedoTexture),
+                             .normalTexture = addTexture(config.normalTexture),
+                             .metallicRoughnessTexture = addTexture(config.metallicRoughnessTexture),
+                             .occlusionTexture = addTexture(config.occlusionTexture),
+                             .emissiveTexture = addTexture(config.emissiveTexture),
+                             .padding = {} };
+
+    std::uint32_t index{};
+    if(const auto freeSlot{ takeFreeSlot(m_freeMaterials) })
+    {
+        index = *freeSlot;
+        m_materials[index] = data;
+    }
+    else
+    {
+        index = static_cast<std::uint32_t>(m_materials.size());
+        m_materials.push_back(data);
+        reserveMaterials(static_cast<std::uint32_t>(m_materials.size()));
+    }
+
+    m_materialBuffer->writeToBuffer(data, static_cast<VkDeviceSize>(index) * sizeof(MaterialData));
+    m_materialBuffer->flush();
+
+    return index;
+}
+
+void MaterialTable::removeMaterial(std::uint32_t index)
+{
+#if defined(VV_ENABLE_ASSERTS)
+    assert(index < m_materials.size() && "Material index exceeds the material table");
+#endif
+
+    const MaterialData& data{ m_materials[index] };
+    releaseTexture(data.albedoTexture);
+    releaseTexture(data.normalTexture);
+    releaseTexture(data.metallicRoughnessTexture);
+    releaseTexture(data.occlusionTexture);
+    releaseTexture(data.emissiveTexture);
+
+    m_freeMaterials.push_back({ .index = index, .timelineValue = device->submittedGraphicsValue() });
+}
+
+void MaterialTable::bind(VkCommandBuffer commandBuffer, VkPipelineLayout layout, std::uint32_t setIndex) const
+{
+    vkCmdBindDescriptorSets(
+        commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, setIndex, 1, &m_descriptorSet, 0, nullptr
+    );
+}
+
+/// \brief Get the index of a texture in the texture array, the texture is added if it is not in the array yet
+///
+/// \param texture the texture
+///
+/// \returns the index of the texture
+std::uint32_t MaterialTable::addTexture(const std::shared_ptr<Texture2D>& texture)
+{
+    if(const auto it{ m_textureIndices.find(texture.get()) }; it != m_textureIndices.end())
+    {
+        ++m_textures[it->second].users;
+        return it->second;
+    }
+
+    std::uint32_t index{};
+    if(const auto freeSlot{ takeFreeSlot(m_freeTextures) })
+    {
+        index = *freeSlot;
+        m_textures[index] = { .texture = texture, .users = 1 };
+    }
+    else
+    {
+        if(m_textures.size() >= MAX_TEXTURES)
+            throw Exception("Exceeded the maximum amount of bindless textures");
+
+        index = static_cast<std::uint32_t>(m_textures.size());
+        m_textures.push_back({ .texture = texture, .users = 1 });
+    }
+    m_textureIndices.emplace(texture.get(), index);
+
+    // NOTE: The texture binding is update after bind, so the set may be bound by frames that are still in flight
+    auto imageInfo{ texture->descriptor() };
+    DescriptorWriter{ m_setLayout.get(), m_pool.get() }
+        .writeImageArrayElement(TEXTURE_BINDING, index, &imageInfo)
+        .overwrite(m_descriptorSet);
+
+    return index;
+}
+
+/// \brief Drop one use of a texture, the texture leaves the array once no material uses it anymore
+///
+/// \param index the index of the texture
+void MaterialTable::releaseTexture(std::uint32_t index)
+{
+    auto& slot{ m_textures[index] };
+    if(--slot.users > 0)
+        return;
+
+    // NOTE: The texture is destroyed through the deferred deletion of the device once it is not referenced anymore,
+    // so frames in flight can still sample it. The descriptor is partially bound and only overwritten on reuse
+    m_textureIndices.erase(slot.texture.get());
+    slot.texture.reset();
+    m_freeTextures.push_back({ .index = index, .timelineValue = device->submittedGraphicsValue() });
+}
+
+/// \brief Make sure that the material buffer can hold a certain amount of materials
+///
+/// \param count the amount of materials
+void MaterialTable::reserveMaterials(std::uint32_t count)
+{
+    if(count <= m_materialCapacity)
+        return;
+
+    // NOTE: The material binding is update after bind, so frames that are still in flight keep reading the old
+    // buffer, which the buffer destructor keeps alive until they have finished
+    m_materialCapacity = std::max(std::bit_ceil(count), MIN_MATERIAL_CAPACITY);
+    m_materialBuffer = std::make_unique<Buffer>(
+        Buffer::createHostStorageBuffer(device, sizeof(MaterialData), m_materialCapacity)
+    );
+    if(!m_materials.empty())
+    {
+        m_materialBuffer->writeToBuffer(m_materials);
+        m_materialBuffer->flush();
+    }
+
+    auto bufferInfo{ m_materialBuffer->descriptorInfo() };
+    DescriptorWriter{ m_setLayout.get(), m_pool.get() }
+        .writeBuffer(MATERIAL_BINDING, &bufferInfo)
+        .overwrite(m_descriptorSet);
+}
+
+/// \brief Take the oldest free slot if the frames that may still use it have finished
+///
+/// \param slots the free slots, oldest first
+///
+/// \returns the index of the slot, or nothing if no slot can be reused yet
+std::optional<std::uint32_t> MaterialTable::takeFreeSlot(std::deque<FreeSlot>& slots) const
+{
+    if(slots.empty() || slots.front().timelineValue > device->completedGraphicsValue())
+        return std::nullopt;
+
+    const std::uint32_t index{ slots.front().index };
+    slots.pop_front();
+
+    return index;
+}
+
+} // namespace vv
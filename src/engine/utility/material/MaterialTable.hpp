@@ -0,0 +1,162 @@
+#ifndef VULKAN_VOXELS_SRC_ENGINE_UTILITY_MATERIAL_MATERIAL_TABLE_HPP
+#define VULKAN_VOXELS_SRC_ENGINE_UTILITY_MATERIAL_MATERIAL_TABLE_HPP
+
+#include "core/Buffer.hpp"
+#include "core/DescriptorPool.hpp"
+#include "core/DescriptorSetLayout.hpp"
+#include "core/Device.hpp"
+#include "core/Texture2D.hpp"
+#include "utility/material/Material.hpp"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include "glm/glm.hpp"
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace vv
+{
+
+/// \brief Parameters of a single material as they are stored in the material buffer, matches the std430 layout of
+/// the PBR fragment shader
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+struct MaterialData
+{
+    glm::vec4 baseColorFactor{ MaterialConfig::DEFAULT_BASE_COLOR_FACTOR };
+    glm::vec3 emissiveFactor{ MaterialConfig::DEFAULT_EMISSIVE_FACTOR };
+    float normalScale{ MaterialConfig::DEFAULT_NORMAL_SCALE };
+    float metallicFactor{ MaterialConfig::DEFAULT_METALLIC_FACTOR };
+    float roughnessFactor{ MaterialConfig::DEFAULT_ROUGHNESS_FACTOR };
+    float occlusionStrength{ MaterialConfig::DEFAULT_OCCLUSION_STRENGTH };
+    float alphaCutoff{ MaterialConfig::DEFAULT_ALPHA_CUTOFF };
+
+    // Indices into the texture array
+    std::uint32_t albedoTexture{ 0 };
+    std::uint32_t normalTexture{ 0 };
+    std::uint32_t metallicRoughnessTexture{ 0 };
+    std::uint32_t occlusionTexture{ 0 };
+    std::uint32_t emissiveTexture{ 0 };
+    std::array<std::uint32_t, 3> padding{};
+};
+
+static_assert(sizeof(MaterialData) == 80, "MaterialData has to match the std430 layout of the shader");
+
+/// \brief Bindless storage for the parameters and textures of every material
+///
+/// All materials share a single descriptor set: binding 0 is a storage buffer with one \ref MaterialData per
+/// material and binding 1 is a partially bound array of every texture that is used by any material. Shaders select a
+/// material through its index, so switching the material of a draw does not require binding a descriptor set.
+///
+/// Removed materials and textures that no material uses anymore free their slots, which are reused once the frames
+/// that were submitted before the removal have finished.
+///
+/// Requires the descriptor indexing features of Vulkan 1.2.
+///
+/// \author Felix Hommel
+/// \date 10/18/2026
+class MaterialTable
+{
+public:
+    static constexpr std::uint32_t MATERIAL_BINDING{ 0 };
+    static constexpr std::uint32_t TEXTURE_BINDING{ 1 };
+    /// \brief Size of the texture array, far below the update after bind limits that descriptor indexing guarantees
+    static constexpr std::uint32_t MAX_TEXTURES{ 4096 };
+
+    /// \brief Create a new empty \ref MaterialTable
+    ///
+    /// \param device the \ref Device where the table is created on
+    ///
+    /// \throws Exception if the device does not support descriptor indexing
+    explicit MaterialTable(std::shared_ptr<Device> device);
+    ~MaterialTable() = default;
+
+    MaterialTable(const MaterialTable&) = delete;
+    MaterialTable(MaterialTable&&) = delete;
+    MaterialTable& operator=(const MaterialTable&) = delete;
+    MaterialTable& operator=(MaterialTable&&) = delete;
+
+    /// \brief Whether the device has enabled every feature that is needed by the table
+    ///
+    /// \param device the \ref Device that is checked
+    [[nodiscard]] static bool isSupported(const Device& device) noexcept;
+
+    [[nodiscard]] std::shared_ptr<DescriptorSetLayout> getSetLayout() const noexcept { return m_setLayout; }
+    [[nodiscard]] std::uint32_t getMaterialCount() const noexcept
+    {
+        return static_cast<std::uint32_t>(m_materials.size() - m_freeMaterials.size());
+    }
+    [[nodiscard]] std::uint32_t getTextureCount() const noexcept
+    {
+        return static_cast<std::uint32_t>(m_textureIndices.size());
+    }
+
+    /// \brief Add a material to the table
+    ///
+    /// \note Has to be called between frames. The material buffer grows without waiting for frames in flight
+    ///
+    /// \param config configuration of the material, every texture has to be set
+    ///
+    /// \returns the index of the material in the table
+    std::uint32_t addMaterial(const MaterialConfig& config);
+    /// \brief Remove a material from the table and release the textures that no other material uses
+    ///
+    /// \note Has to be called between frames. Draws that were recorded before may still use the material
+    ///
+    /// \param index the index of the material that was returned by \ref addMaterial
+    void removeMaterial(std::uint32_t index);
+    /// \brief Bind the descriptor set of the table
+    ///
+    /// \param commandBuffer the command buffer that is rendered to
+    /// \param layout the layout of the used graphics pipeline
+    /// \param setIndex the set number the table is bound to
+    void bind(VkCommandBuffer commandBuffer, VkPipelineLayout layout, std::uint32_t setIndex) const;
+
+private:
+    static constexpr std::uint32_t MIN_MATERIAL_CAPACITY{ 64 };
+
+    /// \brief A texture in the texture array together with how many material textures refer to it
+    struct TextureSlot
+    {
+        std::shared_ptr<Texture2D> texture;
+        std::uint32_t users{ 0 };
+    };
+
+    /// \brief A slot that was freed, it may be reused when the graphics timeline has reached the value
+    struct FreeSlot
+    {
+        std::uint32_t index;
+        std::uint64_t timelineValue;
+    };
+
+    std::shared_ptr<Device> device;
+    std::shared_ptr<DescriptorSetLayout> m_setLayout;
+    std::unique_ptr<DescriptorPool> m_pool;
+    VkDescriptorSet m_descriptorSet{ VK_NULL_HANDLE };
+
+    std::unique_ptr<Buffer> m_materialBuffer;
+    std::uint32_t m_materialCapacity{ 0 };
+    std::vector<MaterialData> m_materials;
+    std::deque<FreeSlot> m_freeMaterials; ///< Slots of removed materials, oldest first
+
+    std::vector<TextureSlot> m_textures;                                  ///< Keeps every used texture alive
+    std::unordered_map<const Texture2D*, std::uint32_t> m_textureIndices; ///< Index of a texture in the array
+    std::deque<FreeSlot> m_freeTextures;                                  ///< Slots of released textures, oldest first
+
+    std::uint32_t addTexture(const std::shared_ptr<Texture2D>& texture);
+    void releaseTexture(std::uint32_t index);
+    void reserveMaterials(std::uint32_t count);
+    [[nodiscard]] std::optional<std::uint32_t> takeFreeSlot(std::deque<FreeSlot>& slots) const;
+};
+
+} // namespace vv
+
+#endif // !VULKAN_VOXELS_SRC_ENGINE_UTILITY_MATERIAL_MATERIAL_TABLE_HPP
@@ -79,6 +79,19 @@ TEST_F(BufferTest, WriteToBuffer)
     buffer.unmap();
 }
 
+TEST_F(BufferTest, ReadFromBuffer)
+{
+    Buffer buffer(ctx->device(), ELEMENT_SIZE, ALLOCATIONS, BUFFER_USAGE, VMA_ALLOC);
+
+    buffer.map();
+    const std::vector<float> writeData{ 1.f, 2.f, 3.f, 4.f, 5.f };
+    buffer.writeToBuffer(writeData);
+
+    EXPECT_FLOAT_EQ(buffer.readFromBuffer<float>(), 1.f);
+    EXPECT_FLOAT_EQ(buffer.readFromBuffer<float>(2 * sizeof(float)), 3.f);
+    buffer.unmap();
+}
+
 TEST_F(BufferTest, BufferMoveConstructor)
 {
     std::unique_ptr<Buffer> buffer;
@@ -134,6 +147,22 @@ TEST_F(BufferTest, CreateStorageBuffer)
     EXPECT_EQ(BufferTestHelper::getMappedMemory(buffer), nullptr);
 }
 
+TEST_F(BufferTest, CreateGpuIndirectBuffer)
+{
+    const auto buffer{ Buffer::createGpuIndirectBuffer(ctx->device(), ELEMENT_SIZE, ALLOCATIONS) };
+
+    EXPECT_NE(buffer.getBuffer(), VK_NULL_HANDLE);
+    EXPECT_EQ(BufferTestHelper::getMappedMemory(buffer), nullptr);
+}
+
+TEST_F(BufferTest, CreateReadbackBuffer)
+{
+    const auto buffer{ Buffer::createReadbackBuffer(ctx->device(), ELEMENT_SIZE, ALLOCATIONS) };
+
+    EXPECT_NE(buffer.getBuffer(), VK_NULL_HANDLE);
+    EXPECT_NE(BufferTestHelper::getMappedMemory(buffer), nullptr);
+}
+
 TEST_F(BufferTest, CreateStagingBuffer)
 {
     const auto buffer{ Buffer::createStagingBuffer(ctx->device(), ELEMENT_SIZE, ALLOCATIONS) };
@@ -0,0 +1,98 @@
+#include "core/CommandPoolRing.hpp"
+#include "fixtures/TestVulkanContext.hpp"
+
+#include "gtest/gtest.h"
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <memory>
+
+namespace vv::test
+{
+
+class CommandPoolRingTest : public ::testing::Test
+{
+protected:
+    static constexpr std::size_t FRAMES{ 2 };
+    static constexpr std::size_t THREADS{ 3 };
+
+    void SetUp() override
+    {
+        ctx = std::make_unique<TestVulkanContext>();
+        ring = std::make_unique<CommandPoolRing>(ctx->device(), FRAMES, THREADS);
+    }
+
+    void TearDown() override { ring.reset(); }
+
+    std::unique_ptr<TestVulkanContext> ctx;
+    std::unique_ptr<CommandPoolRing> ring;
+};
+
+TEST_F(CommandPoolRingTest, HasAPoolPerFrameAndThread)
+{
+    EXPECT_EQ(ring->getFrameCount(), FRAMES);
+    EXPECT_EQ(ring->getThreadCount(), THREADS);
+}
+
+TEST_F(CommandPoolRingTest, AllocationsInAFrameAreDistinct)
+{
+    const VkCommandBuffer first{ ring->allocate(0, 0, VK_COMMAND_BUFFER_LEVEL_PRIMARY) };
+    const VkCommandBuffer second{ ring->allocate(0, 0, VK_COMMAND_BUFFER_LEVEL_PRIMARY) };
+    const VkCommandBuffer secondary{ ring->allocate(0, 0, VK_COMMAND_BUFFER_LEVEL_SECONDARY) };
+
+    EXPECT_NE(first, VK_NULL_HANDLE);
+    EXPECT_NE(first, second);
+    EXPECT_NE(secondary, first);
+    EXPECT_NE(secondary, second);
+}
+
+TEST_F(CommandPoolRingTest, FramesAndThreadsDoNotShareCommandBuffers)
+{
+    const VkCommandBuffer frame0{ ring->allocate(0, 0, VK_COMMAND_BUFFER_LEVEL_SECONDARY) };
+    const VkCommandBuffer frame1{ ring->allocate(1, 0, VK_COMMAND_BUFFER_LEVEL_SECONDARY) };
+    const VkCommandBuffer thread1{ ring->allocate(0, 1, VK_COMMAND_BUFFER_LEVEL_SECONDARY) };
+
+    EXPECT_NE(frame0, frame1);
+    EXPECT_NE(frame0, thread1);
+    EXPECT_NE(frame1, thread1);
+}
+
+TEST_F(CommandPoolRingTest, ResetRecyclesCommandBuffersInOrder)
+{
+    const VkCommandBuffer first{ ring->allocate(0, 2, VK_COMMAND_BUFFER_LEVEL_PRIMARY) };
+    const VkCommandBuffer second{ ring->allocate(0, 2, VK_COMMAND_BUFFER_LEVEL_PRIMARY) };
+
+    ring->reset(0);
+
+    EXPECT_EQ(ring->allocate(0, 2, VK_COMMAND_BUFFER_LEVEL_PRIMARY), first);
+    EXPECT_EQ(ring->allocate(0, 2, VK_COMMAND_BUFFER_LEVEL_PRIMARY), second);
+}
+
+TEST_F(CommandPoolRingTest, ResetOnlyAffectsItsFrame)
+{
+    const VkCommandBuffer frame1{ ring->allocate(1, 0, VK_COMMAND_BUFFER_LEVEL_PRIMARY) };
+
+    ring->reset(0);
+
+    EXPECT_NE(ring->allocate(1, 0, VK_COMMAND_BUFFER_LEVEL_PRIMARY), frame1);
+}
+
+TEST_F(CommandPoolRingTest, RecycledCommandBufferCanBeRecordedAgain)
+{
+    const VkCommandBufferBeginInfo beginInfo{ .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+                                              .pNext = nullptr,
+                                              .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+                                              .pInheritanceInfo = nullptr };
+
+    VkCommandBuffer commandBuffer{ ring->allocate(0, 0, VK_COMMAND_BUFFER_LEVEL_PRIMARY) };
+    ASSERT_EQ(vkBeginCommandBuffer(commandBuffer, &beginInfo), VK_SUCCESS);
+    ASSERT_EQ(vkEndCommandBuffer(commandBuffer), VK_SUCCESS);
+
+    ring->reset(0);
+
+    commandBuffer = ring->allocate(0, 0, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+    EXPECT_EQ(vkBeginCommandBuffer(commandBuffer, &beginInfo), VK_SUCCESS);
+    EXPECT_EQ(vkEndCommandBuffer(commandBuffer), VK_SUCCESS);
+}
+
+} // namespace vv::test
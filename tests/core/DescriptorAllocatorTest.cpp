@@ -0,0 +1,78 @@
+#include "core/DescriptorAllocator.hpp"
+#include "core/DescriptorSetLayout.hpp"
+#include "fixtures/TestVulkanContext.hpp"
+
+#include "gtest/gtest.h"
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+
+namespace vv::test
+{
+
+class DescriptorAllocatorTest : public ::testing::Test
+{
+protected:
+    static constexpr std::uint32_t INITIAL_SETS{ 4 };
+    static constexpr std::array<PoolSizeRatio, 1> RATIOS{
+        { { .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .ratio = 1.f } }
+    };
+
+    void SetUp() override
+    {
+        ctx = std::make_unique<TestVulkanContext>();
+        layout = DescriptorSetLayout::Builder(ctx->device())
+                     .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                     .build();
+        allocator = std::make_unique<DescriptorAllocator>(ctx->device(), INITIAL_SETS, RATIOS);
+    }
+
+    void TearDown() override
+    {
+        allocator.reset();
+        layout.reset();
+    }
+
+    std::unique_ptr<TestVulkanContext> ctx;
+    std::unique_ptr<DescriptorSetLayout> layout;
+    std::unique_ptr<DescriptorAllocator> allocator;
+};
+
+TEST_F(DescriptorAllocatorTest, FirstPoolIsCreatedOnDemand)
+{
+    EXPECT_EQ(allocator->getPoolCount(), 0);
+
+    EXPECT_NE(allocator->allocate(layout->getDescriptorLayout()), VK_NULL_HANDLE);
+    EXPECT_EQ(allocator->getPoolCount(), 1);
+}
+
+TEST_F(DescriptorAllocatorTest, FullPoolGrowsTheAllocator)
+{
+    constexpr std::uint32_t COUNT{ INITIAL_SETS * 8 };
+    std::set<VkDescriptorSet> sets;
+    for(std::uint32_t i{ 0 }; i < COUNT; ++i)
+        sets.insert(allocator->allocate(layout->getDescriptorLayout()));
+
+    EXPECT_EQ(sets.size(), COUNT);
+    EXPECT_GT(allocator->getPoolCount(), 1);
+    EXPECT_GT(allocator->getSetsPerPool(), INITIAL_SETS);
+}
+
+TEST_F(DescriptorAllocatorTest, ResetRecyclesThePools)
+{
+    for(std::uint32_t i{ 0 }; i < INITIAL_SETS * 4; ++i)
+        static_cast<void>(allocator->allocate(layout->getDescriptorLayout()));
+    const std::size_t pools{ allocator->getPoolCount() };
+
+    allocator->reset();
+    for(std::uint32_t i{ 0 }; i < INITIAL_SETS * 4; ++i)
+        static_cast<void>(allocator->allocate(layout->getDescriptorLayout()));
+
+    EXPECT_EQ(allocator->getPoolCount(), pools);
+}
+
+} // namespace vv::test
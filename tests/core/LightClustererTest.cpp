@@ -0,0 +1,56 @@
+#include "core/LightClusterer.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+
+namespace vv::test
+{
+
+namespace
+{
+
+constexpr float NEAR_PLANE{ 0.1f };
+constexpr float FAR_PLANE{ 100.f };
+
+} // namespace
+
+TEST(LightClustererTest, NearPlaneIsFirstSlice)
+{
+    EXPECT_EQ(LightClusterer::depthSlice(NEAR_PLANE, NEAR_PLANE, FAR_PLANE), 0u);
+    EXPECT_FLOAT_EQ(LightClusterer::sliceDepth(0, NEAR_PLANE, FAR_PLANE), NEAR_PLANE);
+}
+
+TEST(LightClustererTest, FarPlaneIsLastSlice)
+{
+    EXPECT_EQ(LightClusterer::depthSlice(FAR_PLANE, NEAR_PLANE, FAR_PLANE), LightClusterer::GRID_SIZE_Z - 1);
+    EXPECT_NEAR(LightClusterer::sliceDepth(LightClusterer::GRID_SIZE_Z, NEAR_PLANE, FAR_PLANE), FAR_PLANE, 1e-3f);
+}
+
+TEST(LightClustererTest, DepthsOutsideTheFrustumAreClamped)
+{
+    EXPECT_EQ(LightClusterer::depthSlice(NEAR_PLANE / 2.f, NEAR_PLANE, FAR_PLANE), 0u);
+    EXPECT_EQ(LightClusterer::depthSlice(FAR_PLANE * 2.f, NEAR_PLANE, FAR_PLANE), LightClusterer::GRID_SIZE_Z - 1);
+}
+
+TEST(LightClustererTest, SlicesGrowWithDepth)
+{
+    for(std::uint32_t slice{ 0 }; slice < LightClusterer::GRID_SIZE_Z; ++slice)
+        EXPECT_LT(
+            LightClusterer::sliceDepth(slice, NEAR_PLANE, FAR_PLANE),
+            LightClusterer::sliceDepth(slice + 1, NEAR_PLANE, FAR_PLANE)
+        );
+}
+
+TEST(LightClustererTest, SliceCenterMapsBackToSlice)
+{
+    for(std::uint32_t slice{ 0 }; slice < LightClusterer::GRID_SIZE_Z; ++slice)
+    {
+        const float begin{ LightClusterer::sliceDepth(slice, NEAR_PLANE, FAR_PLANE) };
+        const float end{ LightClusterer::sliceDepth(slice + 1, NEAR_PLANE, FAR_PLANE) };
+
+        EXPECT_EQ(LightClusterer::depthSlice((begin + end) / 2.f, NEAR_PLANE, FAR_PLANE), slice);
+    }
+}
+
+} // namespace vv::test
@@ -0,0 +1,55 @@
+#include "core/SamplerCache.hpp"
+#include "core/Texture2D.hpp"
+#include "fixtures/TestVulkanContext.hpp"
+
+#include "gtest/gtest.h"
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace vv::test
+{
+
+class SamplerCacheTest : public ::testing::Test
+{
+protected:
+    static constexpr std::uint32_t SIZE{ 4 };
+
+    void SetUp() override { ctx = std::make_unique<TestVulkanContext>(); }
+
+    [[nodiscard]] Texture2D makeTexture(std::uint32_t size, const TextureConfig& config) const
+    {
+        const std::vector<std::uint8_t> pixels(static_cast<std::size_t>(size * size * 4), 255);
+        return { ctx->device(), size, size, config, std::as_bytes(std::span(pixels)) };
+    }
+
+    std::unique_ptr<TestVulkanContext> ctx;
+};
+
+TEST_F(SamplerCacheTest, SameConfigSharesSampler)
+{
+    const Texture2D first{ makeTexture(SIZE, TextureConfig::albedo()) };
+    const Texture2D second{ makeTexture(SIZE * 2, TextureConfig::albedo()) };
+
+    EXPECT_NE(first.descriptor().sampler, VK_NULL_HANDLE);
+    EXPECT_EQ(first.descriptor().sampler, second.descriptor().sampler);
+}
+
+TEST_F(SamplerCacheTest, DifferentStateGetsOwnSampler)
+{
+    TextureConfig clamped{ TextureConfig::albedo() };
+    clamped.addressMode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    const std::size_t samplers{ ctx->device()->samplerCache().size() };
+
+    const Texture2D repeated{ makeTexture(SIZE, TextureConfig::albedo()) };
+    const Texture2D clampedTexture{ makeTexture(SIZE, clamped) };
+
+    EXPECT_NE(repeated.descriptor().sampler, clampedTexture.descriptor().sampler);
+    EXPECT_EQ(ctx->device()->samplerCache().size(), samplers + 2);
+}
+
+} // namespace vv::test
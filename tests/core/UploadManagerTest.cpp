@@ -0,0 +1,148 @@
+#include "core/Buffer.hpp"
+#include "core/Device.hpp"
+#include "core/UploadManager.hpp"
+#include "fixtures/TestVulkanContext.hpp"
+
+#include "gtest/gtest.h"
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace vv::test
+{
+
+class UploadManagerTest : public ::testing::Test
+{
+protected:
+    static constexpr std::uint32_t ELEMENTS{ 256 };
+    static constexpr VkDeviceSize SMALL_STAGING_SIZE{ 256 };
+
+    void SetUp() override { ctx = std::make_unique<TestVulkanContext>(); }
+
+    [[nodiscard]] static std::vector<std::uint32_t> makeData()
+    {
+        std::vector<std::uint32_t> data(ELEMENTS);
+        std::iota(data.begin(), data.end(), 1U);
+        return data;
+    }
+
+    [[nodiscard]] static std::vector<std::uint32_t> readBack(Buffer& buffer)
+    {
+        EXPECT_EQ(buffer.invalidate(), VK_SUCCESS);
+
+        std::vector<std::uint32_t> data(ELEMENTS);
+        for(std::uint32_t i{ 0 }; i < ELEMENTS; ++i)
+            data[i] = buffer.readFromBuffer<std::uint32_t>(i * sizeof(std::uint32_t));
+
+        return data;
+    }
+
+    std::unique_ptr<TestVulkanContext> ctx;
+};
+
+TEST_F(UploadManagerTest, TransferQueueMatchesQueueFamilies)
+{
+    const auto device{ ctx->device() };
+    const QueueFamilyIndices indices{ device->findPhysicalQueueFamilies() };
+
+    EXPECT_EQ(device->hasDedicatedTransferQueue(), indices.transferFamily.has_value());
+    if(device->hasDedicatedTransferQueue())
+    {
+        EXPECT_NE(indices.transferFamily, indices.graphicsFamily);
+        EXPECT_NE(device->transferTimeline(), device->graphicsTimeline());
+    }
+    else
+    {
+        EXPECT_EQ(device->transferQueue(), device->graphicsQueue());
+        EXPECT_EQ(device->transferTimeline(), device->graphicsTimeline());
+    }
+}
+
+TEST_F(UploadManagerTest, UploadedDataReachesBuffer)
+{
+    Buffer buffer{ Buffer::createReadbackBuffer(ctx->device(), sizeof(std::uint32_t), ELEMENTS) };
+    const std::vector<std::uint32_t> data{ makeData() };
+
+    UploadManager& uploads{ ctx->device()->uploadManager() };
+    uploads.uploadBuffer(buffer.getBuffer(), std::as_bytes(std::span{ data }));
+    EXPECT_TRUE(uploads.hasPendingUploads());
+
+    uploads.flushAndWait();
+
+    EXPECT_FALSE(uploads.hasPendingUploads());
+    EXPECT_EQ(readBack(buffer), data);
+}
+
+TEST_F(UploadManagerTest, FlushWithoutUploadsSubmitsNothing)
+{
+    UploadManager& uploads{ ctx->device()->uploadManager() };
+    const std::size_t batches{ uploads.getSubmittedBatches() };
+
+    uploads.flush();
+
+    EXPECT_EQ(uploads.getSubmittedBatches(), batches);
+}
+
+TEST_F(UploadManagerTest, DeletionWaitsForThePendingBatch)
+{
+    const auto device{ ctx->device() };
+    Buffer buffer{ Buffer::createReadbackBuffer(device, sizeof(std::uint32_t), ELEMENTS) };
+    const std::vector<std::uint32_t> data{ makeData() };
+
+    UploadManager& uploads{ device->uploadManager() };
+    uploads.uploadBuffer(buffer.getBuffer(), std::as_bytes(std::span{ data }));
+
+    bool destroyed{ false };
+    device->destroyLater([&destroyed]() { destroyed = true; });
+
+    // NOTE: A single time command advances the graphics timeline before the batch is submitted
+    device->endSingleTimeCommand(device->beginSingleTimeCommand());
+    device->collectDeletions();
+    EXPECT_FALSE(destroyed);
+
+    uploads.flushAndWait();
+    device->endSingleTimeCommand(device->beginSingleTimeCommand());
+    device->collectDeletions();
+    EXPECT_TRUE(destroyed);
+}
+
+TEST_F(UploadManagerTest, DataLargerThanTheRingIsUploaded)
+{
+    Buffer buffer{ Buffer::createReadbackBuffer(ctx->device(), sizeof(std::uint32_t), ELEMENTS) };
+    const std::vector<std::uint32_t> data{ makeData() };
+
+    UploadManager uploads{ *ctx->device(), SMALL_STAGING_SIZE };
+    uploads.uploadBuffer(buffer.getBuffer(), std::as_bytes(std::span{ data }));
+    uploads.flushAndWait();
+
+    EXPECT_EQ(readBack(buffer), data);
+}
+
+TEST_F(UploadManagerTest, FullRingSubmitsTheBatch)
+{
+    Buffer buffer{ Buffer::createReadbackBuffer(ctx->device(), sizeof(std::uint32_t), ELEMENTS) };
+    const std::vector<std::uint32_t> data{ makeData() };
+    const std::span<const std::uint32_t> elements{ data };
+
+    // NOTE: Each upload takes a quarter of the ring, so the ring wraps around several times
+    constexpr std::size_t chunk{ SMALL_STAGING_SIZE / sizeof(std::uint32_t) / 4 };
+    UploadManager uploads{ *ctx->device(), SMALL_STAGING_SIZE };
+    for(std::size_t offset{ 0 }; offset < elements.size(); offset += chunk)
+    {
+        uploads.uploadBuffer(
+            buffer.getBuffer(), std::as_bytes(elements.subspan(offset, chunk)), offset * sizeof(std::uint32_t)
+        );
+    }
+    uploads.flushAndWait();
+
+    EXPECT_GT(uploads.getSubmittedBatches(), 1);
+    EXPECT_EQ(uploads.getUploadedBytes(), data.size() * sizeof(std::uint32_t));
+    EXPECT_EQ(readBack(buffer), data);
+}
+
+} // namespace vv::test
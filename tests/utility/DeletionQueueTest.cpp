@@ -0,0 +1,86 @@
+#include "utility/DeletionQueue.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vv::test
+{
+
+class DeletionQueueTest : public ::testing::Test
+{
+public:
+    DeletionQueueTest() = default;
+    ~DeletionQueueTest() override = default;
+
+    DeletionQueueTest(const DeletionQueueTest&) = delete;
+    DeletionQueueTest(DeletionQueueTest&&) = delete;
+    DeletionQueueTest& operator=(const DeletionQueueTest&) = delete;
+    DeletionQueueTest& operator=(DeletionQueueTest&&) = delete;
+
+    void SetUp() override {}
+    void TearDown() override {}
+
+protected:
+    DeletionQueue m_queue;
+    std::vector<int> m_deleted;
+
+    void push(std::uint64_t value, int id)
+    {
+        m_queue.push(value, [this, id]() { m_deleted.push_back(id); });
+    }
+};
+
+TEST_F(DeletionQueueTest, NothingRunsBeforeItsValue)
+{
+    push(3, 1);
+
+    EXPECT_EQ(m_queue.collect(2), 0);
+    EXPECT_TRUE(m_deleted.empty());
+    EXPECT_EQ(m_queue.size(), 1);
+}
+
+TEST_F(DeletionQueueTest, CollectRunsReachedValuesInOrder)
+{
+    push(1, 1);
+    push(2, 2);
+    push(2, 3);
+    push(4, 4);
+
+    EXPECT_EQ(m_queue.collect(2), 3);
+    EXPECT_EQ(m_deleted, (std::vector<int>{ 1, 2, 3 }));
+    EXPECT_EQ(m_queue.size(), 1);
+
+    EXPECT_EQ(m_queue.collect(10), 1);
+    EXPECT_EQ(m_deleted, (std::vector<int>{ 1, 2, 3, 4 }));
+    EXPECT_TRUE(m_queue.empty());
+}
+
+TEST_F(DeletionQueueTest, FlushRunsEverything)
+{
+    push(5, 1);
+    push(7, 2);
+
+    m_queue.flush();
+
+    EXPECT_EQ(m_deleted, (std::vector<int>{ 1, 2 }));
+    EXPECT_TRUE(m_queue.empty());
+}
+
+TEST_F(DeletionQueueTest, DeleterCanPushNewDeletions)
+{
+    m_queue.push(1, [this]() {
+        m_deleted.push_back(1);
+        push(3, 2);
+    });
+
+    EXPECT_EQ(m_queue.collect(1), 1);
+    EXPECT_EQ(m_queue.size(), 1);
+
+    EXPECT_EQ(m_queue.collect(3), 1);
+    EXPECT_EQ(m_deleted, (std::vector<int>{ 1, 2 }));
+}
+
+} // namespace vv::test
@@ -0,0 +1,103 @@
+#include "helper/RandomNumberGenerator.hpp"
+#include "utility/DrawSort.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vv::test
+{
+
+class DrawSortTest : public ::testing::Test
+{
+public:
+    DrawSortTest() = default;
+    ~DrawSortTest() override = default;
+
+    DrawSortTest(const DrawSortTest&) = delete;
+    DrawSortTest(DrawSortTest&&) = delete;
+    DrawSortTest& operator=(const DrawSortTest&) = delete;
+    DrawSortTest& operator=(DrawSortTest&&) = delete;
+
+    void SetUp() override {}
+    void TearDown() override {}
+
+protected:
+    std::vector<DrawSortEntry> m_entries;
+    std::vector<DrawSortEntry> m_scratch;
+};
+
+TEST_F(DrawSortTest, KeyOrdersByPipelineMaterialModelDepth)
+{
+    const std::uint64_t base{ DrawSortKey::make(1, 1, 1, 1) };
+
+    EXPECT_LT(base, DrawSortKey::make(2, 0, 0, 0));
+    EXPECT_LT(base, DrawSortKey::make(1, 2, 0, 0));
+    EXPECT_LT(base, DrawSortKey::make(1, 1, 2, 0));
+    EXPECT_LT(base, DrawSortKey::make(1, 1, 1, 2));
+}
+
+TEST_F(DrawSortTest, DepthBucketIsMonotonic)
+{
+    EXPECT_EQ(DrawSortKey::depthBucket(-1.f), DrawSortKey::depthBucket(0.f));
+    EXPECT_LE(DrawSortKey::depthBucket(0.5f), DrawSortKey::depthBucket(1.f));
+    EXPECT_LT(DrawSortKey::depthBucket(1.f), DrawSortKey::depthBucket(2.f));
+    EXPECT_LT(DrawSortKey::depthBucket(10.f), DrawSortKey::depthBucket(100.f));
+}
+
+TEST_F(DrawSortTest, SortsAscendingAndStable)
+{
+    m_entries = { { .key = 3, .index = 0 }, { .key = 1, .index = 1 }, { .key = 3, .index = 2 },
+                  { .key = 0, .index = 3 }, { .key = 1, .index = 4 } };
+
+    radixSort(m_entries, m_scratch);
+
+    const std::vector<std::uint32_t> expected{ 3, 1, 4, 0, 2 };
+    ASSERT_EQ(m_entries.size(), expected.size());
+    for(std::size_t i{ 0 }; i < expected.size(); ++i)
+        EXPECT_EQ(m_entries[i].index, expected[i]);
+}
+
+TEST_F(DrawSortTest, MatchesStableSort)
+{
+    static constexpr std::uint32_t ENTRY_COUNT{ 10'000 };
+    m_entries.reserve(ENTRY_COUNT);
+    for(std::uint32_t i{ 0 }; i < ENTRY_COUNT; ++i)
+    {
+        const std::uint64_t key{ DrawSortKey::make(
+            generateRandom<std::uint32_t>(0, 3),
+            generateRandom<std::uint32_t>(0, 100),
+            generateRandom<std::uint32_t>(0, 100),
+            DrawSortKey::depthBucket(generateRandom<float>(0.f, 100.f))
+        ) };
+        m_entries.push_back({ .key = key, .index = i });
+    }
+
+    std::vector<DrawSortEntry> expected{ m_entries };
+    std::ranges::stable_sort(expected, {}, &DrawSortEntry::key);
+
+    radixSort(m_entries, m_scratch);
+
+    ASSERT_EQ(m_entries.size(), expected.size());
+    for(std::size_t i{ 0 }; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(m_entries[i].key, expected[i].key);
+        EXPECT_EQ(m_entries[i].index, expected[i].index);
+    }
+}
+
+TEST_F(DrawSortTest, EmptyAndSingleEntry)
+{
+    radixSort(m_entries, m_scratch);
+    EXPECT_TRUE(m_entries.empty());
+
+    m_entries.push_back({ .key = 42, .index = 7 });
+    radixSort(m_entries, m_scratch);
+    ASSERT_EQ(m_entries.size(), 1u);
+    EXPECT_EQ(m_entries.front().index, 7u);
+}
+
+} // namespace vv::test
@@ -0,0 +1,166 @@
+#include "helper/RandomNumberGenerator.hpp"
+#include "utility/Bounds.hpp"
+#include "utility/Camera.hpp"
+#include "utility/FrustumCuller.hpp"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include "glm/glm.hpp"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vv::test
+{
+
+class FrustumCullerTest : public ::testing::Test
+{
+public:
+    FrustumCullerTest() = default;
+    ~FrustumCullerTest() override = default;
+
+    FrustumCullerTest(const FrustumCullerTest&) = delete;
+    FrustumCullerTest(FrustumCullerTest&&) = delete;
+    FrustumCullerTest& operator=(const FrustumCullerTest&) = delete;
+    FrustumCullerTest& operator=(FrustumCullerTest&&) = delete;
+
+    void SetUp() override
+    {
+        static constexpr float FOV{ glm::radians(50.f) };
+        static constexpr float ASPECT_RATIO{ 16.f / 9.f };
+
+        // NOTE: Camera sits in the origin and looks along +z
+        Camera camera{};
+        camera.setPerspectiveProjection(FOV, ASPECT_RATIO, NEAR_PLANE, FAR_PLANE);
+        camera.setViewDirection(glm::vec3{ 0.f }, glm::vec3{ 0.f, 0.f, 1.f });
+
+        m_culler.setFrustum(camera.getProjection() * camera.getView());
+    }
+    void TearDown() override {}
+
+protected:
+    static constexpr float NEAR_PLANE{ 0.1f };
+    static constexpr float FAR_PLANE{ 100.f };
+
+    FrustumCuller m_culler;
+
+    void addRandomSpheres(std::size_t count)
+    {
+        static constexpr float RANGE{ 150.f };
+        static constexpr float MAX_RADIUS{ 2.f };
+
+        m_culler.reserve(count);
+        for(std::size_t i{ 0 }; i < count; ++i)
+        {
+            m_culler.addSphere(
+                { .center = { generateRandom<float>(-RANGE, RANGE),
+                              generateRandom<float>(-RANGE, RANGE),
+                              generateRandom<float>(-RANGE, RANGE) },
+                  .radius = generateRandom<float>(0.f, MAX_RADIUS) }
+            );
+        }
+    }
+};
+
+TEST_F(FrustumCullerTest, SpheresInsideAreVisible)
+{
+    m_culler.addSphere({ .center = { 0.f, 0.f, 5.f }, .radius = 1.f });
+    m_culler.addSphere({ .center = { 0.f, 0.f, FAR_PLANE - 1.f }, .radius = 0.5f });
+
+    std::vector<std::uint32_t> visible;
+    m_culler.cull(visible);
+
+    ASSERT_EQ(visible.size(), 2u);
+    EXPECT_EQ(visible[0], 0u);
+    EXPECT_EQ(visible[1], 1u);
+}
+
+TEST_F(FrustumCullerTest, SpheresOutsideAreCulled)
+{
+    m_culler.addSphere({ .center = { 0.f, 0.f, -5.f }, .radius = 1.f });
+    m_culler.addSphere({ .center = { 0.f, 0.f, FAR_PLANE + 5.f }, .radius = 1.f });
+    m_culler.addSphere({ .center = { 50.f, 0.f, 5.f }, .radius = 1.f });
+    m_culler.addSphere({ .center = { 0.f, -50.f, 5.f }, .radius = 1.f });
+
+    std::vector<std::uint32_t> visible;
+    m_culler.cull(visible);
+
+    EXPECT_TRUE(visible.empty());
+}
+
+TEST_F(FrustumCullerTest, SpheresIntersectingAPlaneAreVisible)
+{
+    m_culler.addSphere({ .center = { 0.f, 0.f, -0.5f }, .radius = 1.f });
+    m_culler.addSphere({ .center = { 0.f, 0.f, FAR_PLANE + 0.5f }, .radius = 1.f });
+
+    std::vector<std::uint32_t> visible;
+    m_culler.cull(visible);
+
+    EXPECT_EQ(visible.size(), 2u);
+}
+
+TEST_F(FrustumCullerTest, TransformedSphere)
+{
+    const BoundingSphere sphere{ .center = { 1.f, 0.f, 0.f }, .radius = 1.f };
+    const glm::mat4 transform{ glm::mat4{ { 2.f, 0.f, 0.f, 0.f },
+                                          { 0.f, 3.f, 0.f, 0.f },
+                                          { 0.f, 0.f, 1.f, 0.f },
+                                          { 0.f, 0.f, 5.f, 1.f } } };
+
+    const BoundingSphere result{ sphere.transformed(transform) };
+
+    EXPECT_FLOAT_EQ(result.center.x, 2.f);
+    EXPECT_FLOAT_EQ(result.center.y, 0.f);
+    EXPECT_FLOAT_EQ(result.center.z, 5.f);
+    EXPECT_FLOAT_EQ(result.radius, 3.f);
+}
+
+TEST_F(FrustumCullerTest, SimdMatchesScalar)
+{
+    // NOTE: Not a multiple of the SIMD width so that the remainder loop is covered as well
+    static constexpr std::size_t SPHERE_COUNT{ 1003 };
+    addRandomSpheres(SPHERE_COUNT);
+
+    std::vector<std::uint32_t> simd;
+    std::vector<std::uint32_t> scalar;
+    m_culler.cull(simd);
+    m_culler.cullScalar(scalar);
+
+    EXPECT_EQ(simd, scalar);
+}
+
+TEST_F(FrustumCullerTest, Benchmark100kObjects)
+{
+    static constexpr std::size_t SPHERE_COUNT{ 100'000 };
+    static constexpr int ITERATIONS{ 100 };
+    addRandomSpheres(SPHERE_COUNT);
+
+    std::vector<std::uint32_t> visible;
+    visible.reserve(SPHERE_COUNT);
+
+    const auto measure{ [&visible](const auto& cull) {
+        const auto start{ std::chrono::steady_clock::now() };
+        for(int i{ 0 }; i < ITERATIONS; ++i)
+            cull(visible);
+        const auto end{ std::chrono::steady_clock::now() };
+
+        return std::chrono::duration<double, std::micro>(end - start).count() / ITERATIONS;
+    } };
+
+    const double simdMicroseconds{ measure([this](std::vector<std::uint32_t>& out) { m_culler.cull(out); }) };
+    const std::size_t visibleCount{ visible.size() };
+    const double scalarMicroseconds{ measure([this](std::vector<std::uint32_t>& out) { m_culler.cullScalar(out); }) };
+
+    RecordProperty("cullMicrosecondsPerFrame", std::to_string(simdMicroseconds));
+    RecordProperty("scalarCullMicrosecondsPerFrame", std::to_string(scalarMicroseconds));
+    RecordProperty("visibleObjects", std::to_string(visibleCount));
+
+    EXPECT_EQ(visibleCount, visible.size());
+    EXPECT_LT(visibleCount, SPHERE_COUNT);
+}
+
+} // namespace vv::test
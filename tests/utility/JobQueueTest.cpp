@@ -0,0 +1,99 @@
+#include "utility/JobQueue.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vv::test
+{
+
+class JobQueueTest : public ::testing::Test
+{
+public:
+    JobQueueTest() = default;
+    ~JobQueueTest() override = default;
+
+    JobQueueTest(const JobQueueTest&) = delete;
+    JobQueueTest(JobQueueTest&&) = delete;
+    JobQueueTest& operator=(const JobQueueTest&) = delete;
+    JobQueueTest& operator=(JobQueueTest&&) = delete;
+
+    void SetUp() override {}
+    void TearDown() override {}
+
+protected:
+    static constexpr std::size_t THREAD_COUNT{ 4 };
+
+    JobQueue m_queue{ THREAD_COUNT };
+};
+
+TEST_F(JobQueueTest, ThreadCountIsWorkerCount)
+{
+    EXPECT_EQ(m_queue.getThreadCount(), THREAD_COUNT);
+}
+
+TEST_F(JobQueueTest, EveryJobRunsOnce)
+{
+    constexpr std::size_t COUNT{ 1000 };
+    std::vector<std::atomic<int>> runs(COUNT);
+
+    for(std::size_t i{ 0 }; i < COUNT; ++i)
+        m_queue.push([&runs, i]() { runs[i].fetch_add(1); });
+    m_queue.waitIdle();
+
+    for(const auto& run : runs)
+        EXPECT_EQ(run.load(), 1);
+}
+
+TEST_F(JobQueueTest, JobsRunOffTheCallingThread)
+{
+    std::mutex mutex;
+    std::vector<std::thread::id> threads;
+
+    for(std::size_t i{ 0 }; i < THREAD_COUNT; ++i)
+    {
+        m_queue.push([&mutex, &threads]() {
+            const std::scoped_lock lock{ mutex };
+            threads.push_back(std::this_thread::get_id());
+        });
+    }
+    m_queue.waitIdle();
+
+    ASSERT_EQ(threads.size(), THREAD_COUNT);
+    for(const auto& thread : threads)
+        EXPECT_NE(thread, std::this_thread::get_id());
+}
+
+TEST_F(JobQueueTest, JobsCanPushJobs)
+{
+    std::atomic<int> runs{ 0 };
+
+    m_queue.push([this, &runs]() {
+        runs.fetch_add(1);
+        m_queue.push([&runs]() { runs.fetch_add(1); });
+    });
+    m_queue.waitIdle();
+
+    EXPECT_EQ(runs.load(), 2);
+}
+
+TEST_F(JobQueueTest, DestructionRunsQueuedJobs)
+{
+    constexpr std::size_t COUNT{ 100 };
+    std::atomic<std::size_t> runs{ 0 };
+
+    {
+        const auto queue{ std::make_unique<JobQueue>(1) };
+        for(std::size_t i{ 0 }; i < COUNT; ++i)
+            queue->push([&runs]() { runs.fetch_add(1); });
+    }
+
+    EXPECT_EQ(runs.load(), COUNT);
+}
+
+} // namespace vv::test
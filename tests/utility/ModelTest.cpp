@@ -1,3 +1,8 @@
+#include "utility/Model.hpp"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include "glm/glm.hpp"
 #include "gtest/gtest.h"
 
 namespace vv::test
@@ -5,4 +10,33 @@ namespace vv::test
 
 TEST(ModelTest, ModelParsing) {}
 
+TEST(ModelTest, ComputeBounds)
+{
+    Model::Builder builder{};
+    builder.vertices = {
+        { .position = { -1.f, 0.f, 0.f } },
+        { .position = { 3.f, 0.f, 0.f } },
+        { .position = { 1.f, 2.f, -1.f } },
+    };
+
+    builder.computeBounds();
+
+    EXPECT_EQ(builder.bounds.min, glm::vec3(-1.f, 0.f, -1.f));
+    EXPECT_EQ(builder.bounds.max, glm::vec3(3.f, 2.f, 0.f));
+    EXPECT_EQ(builder.boundingSphere.center, glm::vec3(1.f, 1.f, -0.5f));
+    // NOTE: The two x extremes are the farthest vertices from the center
+    EXPECT_FLOAT_EQ(builder.boundingSphere.radius, glm::sqrt(4.f + 1.f + 0.25f));
+}
+
+TEST(ModelTest, ComputeBoundsWithoutVertices)
+{
+    Model::Builder builder{};
+
+    builder.computeBounds();
+
+    EXPECT_EQ(builder.bounds.min, glm::vec3(0.f));
+    EXPECT_EQ(builder.bounds.max, glm::vec3(0.f));
+    EXPECT_EQ(builder.boundingSphere.radius, 0.f);
+}
+
 } // namespace vv::test
@@ -0,0 +1,236 @@
+#include "utility/RenderGraphCompiler.hpp"
+
+#include "gtest/gtest.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace vv::test
+{
+
+namespace
+{
+
+constexpr RenderGraphResourceInfo TRANSIENT_BUFFER{ .image = false, .imported = false, .initialAccess = {} };
+constexpr RenderGraphResourceInfo TRANSIENT_IMAGE{ .image = true, .imported = false, .initialAccess = {} };
+constexpr RenderGraphResourceInfo IMPORTED_IMAGE{ .image = true, .imported = true, .initialAccess = {} };
+
+constexpr VkDeviceSize SMALL_SIZE{ 1024 };
+constexpr VkDeviceSize LARGE_SIZE{ 4096 };
+constexpr std::uint32_t ANY_MEMORY_TYPE{ 0xFF };
+
+} // namespace
+
+TEST(RenderGraphCompilerTest, PassWithoutReadersIsCulled)
+{
+    const std::vector<RenderGraphResourceInfo> resources{ TRANSIENT_BUFFER, IMPORTED_IMAGE };
+    const std::vector<RenderGraphPassInfo> passes{
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::computeShaderWrite() } }, .sideEffects = false },
+        { .accesses = { { .resource = 1, .access = RenderGraphAccess::computeShaderWrite() } }, .sideEffects = false }
+    };
+
+    const RenderGraphPlan plan{ compileRenderGraph(resources, passes) };
+
+    ASSERT_EQ(plan.passes.size(), 1u);
+    EXPECT_EQ(plan.passes[0], 1u);
+    EXPECT_FALSE(plan.lifetimes[0].isUsed());
+}
+
+TEST(RenderGraphCompilerTest, SideEffectsKeepPass)
+{
+    const std::vector<RenderGraphResourceInfo> resources{ TRANSIENT_BUFFER };
+    const std::vector<RenderGraphPassInfo> passes{
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::computeShaderWrite() } }, .sideEffects = true }
+    };
+
+    EXPECT_EQ(compileRenderGraph(resources, passes).passes.size(), 1u);
+}
+
+TEST(RenderGraphCompilerTest, ProducersOfKeptPassesAreKept)
+{
+    const std::vector<RenderGraphResourceInfo> resources{ TRANSIENT_BUFFER, TRANSIENT_BUFFER, IMPORTED_IMAGE };
+    const std::vector<RenderGraphPassInfo> passes{
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::computeShaderWrite() } }, .sideEffects = false },
+        { .accesses = { { .resource = 1, .access = RenderGraphAccess::computeShaderWrite() } }, .sideEffects = false },
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::computeShaderRead() },
+                        { .resource = 2, .access = RenderGraphAccess::computeShaderWrite() } },
+         .sideEffects = false }
+    };
+
+    const RenderGraphPlan plan{ compileRenderGraph(resources, passes) };
+
+    const std::vector<std::uint32_t> expected{ 0, 2 };
+    EXPECT_EQ(plan.passes, expected);
+    EXPECT_EQ(plan.lifetimes[0].firstPass, 0u);
+    EXPECT_EQ(plan.lifetimes[0].lastPass, 1u);
+}
+
+TEST(RenderGraphCompilerTest, OverwrittenResultIsCulled)
+{
+    const std::vector<RenderGraphResourceInfo> resources{ TRANSIENT_BUFFER };
+    const std::vector<RenderGraphPassInfo> passes{
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::computeShaderWrite() } }, .sideEffects = false },
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::transferWrite() } }, .sideEffects = false },
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::indirectRead() } }, .sideEffects = true }
+    };
+
+    const std::vector<std::uint32_t> expected{ 1, 2 };
+    EXPECT_EQ(compileRenderGraph(resources, passes).passes, expected);
+}
+
+TEST(RenderGraphCompilerTest, ReadAfterWriteMakesWriteVisible)
+{
+    const std::vector<RenderGraphResourceInfo> resources{ TRANSIENT_BUFFER };
+    const std::vector<RenderGraphPassInfo> passes{
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::computeShaderWrite() } }, .sideEffects = false },
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::indirectRead() } }, .sideEffects = true }
+    };
+
+    const RenderGraphPlan plan{ compileRenderGraph(resources, passes) };
+
+    ASSERT_EQ(plan.barriers.size(), 2u);
+    EXPECT_TRUE(plan.barriers[0].empty());
+    ASSERT_EQ(plan.barriers[1].size(), 1u);
+
+    const RenderGraphBarrier& barrier{ plan.barriers[1][0] };
+    EXPECT_EQ(barrier.srcStages, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+    EXPECT_EQ(barrier.srcAccessMask, VK_ACCESS_SHADER_WRITE_BIT);
+    EXPECT_EQ(barrier.dstStages, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT);
+    EXPECT_EQ(barrier.dstAccessMask, VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+}
+
+TEST(RenderGraphCompilerTest, RepeatedReadNeedsNoBarrier)
+{
+    const std::vector<RenderGraphResourceInfo> resources{ TRANSIENT_BUFFER };
+    const std::vector<RenderGraphPassInfo> passes{
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::computeShaderWrite() } }, .sideEffects = false },
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::fragmentShaderRead() } }, .sideEffects = true },
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::fragmentShaderRead() } }, .sideEffects = true },
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::vertexShaderRead() } }, .sideEffects = true }
+    };
+
+    const RenderGraphPlan plan{ compileRenderGraph(resources, passes) };
+
+    ASSERT_EQ(plan.barriers.size(), 4u);
+    EXPECT_EQ(plan.barriers[1].size(), 1u);
+    EXPECT_TRUE(plan.barriers[2].empty());
+    ASSERT_EQ(plan.barriers[3].size(), 1u);
+    EXPECT_EQ(plan.barriers[3][0].dstStages, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT);
+}
+
+TEST(RenderGraphCompilerTest, WriteAfterReadOnlyWaitsForReaders)
+{
+    const std::vector<RenderGraphResourceInfo> resources{ TRANSIENT_BUFFER };
+    const std::vector<RenderGraphPassInfo> passes{
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::computeShaderWrite() } }, .sideEffects = false },
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::fragmentShaderRead() } }, .sideEffects = true },
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::transferWrite() } }, .sideEffects = true }
+    };
+
+    const RenderGraphPlan plan{ compileRenderGraph(resources, passes) };
+
+    ASSERT_EQ(plan.barriers[2].size(), 1u);
+    const RenderGraphBarrier& barrier{ plan.barriers[2][0] };
+    EXPECT_EQ(barrier.srcStages, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    EXPECT_EQ(barrier.srcAccessMask, VK_ACCESS_SHADER_WRITE_BIT);
+    EXPECT_EQ(barrier.dstStages, VK_PIPELINE_STAGE_TRANSFER_BIT);
+}
+
+TEST(RenderGraphCompilerTest, FirstUseOfImageTransitionsFromUndefined)
+{
+    const std::vector<RenderGraphResourceInfo> resources{ TRANSIENT_IMAGE };
+    const std::vector<RenderGraphPassInfo> passes{
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::colorAttachmentWrite() } },
+         .sideEffects = false },
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::fragmentShaderRead() } }, .sideEffects = true }
+    };
+
+    const RenderGraphPlan plan{ compileRenderGraph(resources, passes) };
+
+    ASSERT_EQ(plan.barriers[0].size(), 1u);
+    EXPECT_EQ(plan.barriers[0][0].srcStages, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+    EXPECT_EQ(plan.barriers[0][0].oldLayout, VK_IMAGE_LAYOUT_UNDEFINED);
+    EXPECT_EQ(plan.barriers[0][0].newLayout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+
+    ASSERT_EQ(plan.barriers[1].size(), 1u);
+    EXPECT_EQ(plan.barriers[1][0].srcStages, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    EXPECT_EQ(plan.barriers[1][0].srcAccessMask, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+    EXPECT_EQ(plan.barriers[1][0].oldLayout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    EXPECT_EQ(plan.barriers[1][0].newLayout, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+}
+
+TEST(RenderGraphCompilerTest, FinalLayoutOfRenderPassIsTracked)
+{
+    constexpr VkImageLayout READ_ONLY{ VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL };
+
+    const std::vector<RenderGraphResourceInfo> resources{ IMPORTED_IMAGE };
+    const std::vector<RenderGraphPassInfo> passes{
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::depthAttachmentWrite(READ_ONLY) } },
+         .sideEffects = false },
+        { .accesses = { { .resource = 0, .access = RenderGraphAccess::computeShaderRead(READ_ONLY) } },
+         .sideEffects = true }
+    };
+
+    const RenderGraphPlan plan{ compileRenderGraph(resources, passes) };
+
+    ASSERT_EQ(plan.barriers[1].size(), 1u);
+    EXPECT_EQ(plan.barriers[1][0].oldLayout, READ_ONLY);
+    EXPECT_EQ(plan.barriers[1][0].newLayout, READ_ONLY);
+    EXPECT_EQ(plan.barriers[1][0].srcAccessMask, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+}
+
+TEST(RenderGraphCompilerTest, DisjointLifetimesShareMemory)
+{
+    const std::vector<RenderGraphLifetime> lifetimes{
+        { .firstPass = 0, .lastPass = 1 },
+        { .firstPass = 2, .lastPass = 3 }
+    };
+    const std::vector<VkMemoryRequirements> requirements{
+        { .size = SMALL_SIZE, .alignment = 256, .memoryTypeBits = ANY_MEMORY_TYPE },
+        { .size = LARGE_SIZE, .alignment = 1024, .memoryTypeBits = 0x0F }
+    };
+
+    const auto slots{ assignAliasSlots(lifetimes, requirements) };
+
+    ASSERT_EQ(slots.size(), 1u);
+    EXPECT_EQ(slots[0].resources.size(), 2u);
+    EXPECT_EQ(slots[0].requirements.size, LARGE_SIZE);
+    EXPECT_EQ(slots[0].requirements.alignment, 1024u);
+    EXPECT_EQ(slots[0].requirements.memoryTypeBits, 0x0Fu);
+}
+
+TEST(RenderGraphCompilerTest, OverlappingLifetimesDoNotShareMemory)
+{
+    const std::vector<RenderGraphLifetime> lifetimes{
+        { .firstPass = 0, .lastPass = 2 },
+        { .firstPass = 2, .lastPass = 3 },
+        { .firstPass = 3, .lastPass = 3 }
+    };
+    const std::vector<VkMemoryRequirements> requirements(
+        3, { .size = SMALL_SIZE, .alignment = 256, .memoryTypeBits = ANY_MEMORY_TYPE }
+    );
+
+    const auto slots{ assignAliasSlots(lifetimes, requirements) };
+
+    ASSERT_EQ(slots.size(), 2u);
+    const std::vector<std::uint32_t> first{ 0, 2 };
+    EXPECT_EQ(slots[0].resources, first);
+}
+
+TEST(RenderGraphCompilerTest, IncompatibleMemoryTypesDoNotShareMemory)
+{
+    const std::vector<RenderGraphLifetime> lifetimes{
+        { .firstPass = 0, .lastPass = 0 },
+        { .firstPass = 1, .lastPass = 1 }
+    };
+    const std::vector<VkMemoryRequirements> requirements{
+        { .size = SMALL_SIZE, .alignment = 256, .memoryTypeBits = 0x01 },
+        { .size = SMALL_SIZE, .alignment = 256, .memoryTypeBits = 0x02 }
+    };
+
+    EXPECT_EQ(assignAliasSlots(lifetimes, requirements).size(), 2u);
+}
+
+} // namespace vv::test
@@ -0,0 +1,154 @@
+#include "utility/ResourceCache.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace vv::test
+{
+
+class ResourceCacheTest : public ::testing::Test
+{
+public:
+    ResourceCacheTest() = default;
+    ~ResourceCacheTest() override = default;
+
+    ResourceCacheTest(const ResourceCacheTest&) = delete;
+    ResourceCacheTest(ResourceCacheTest&&) = delete;
+    ResourceCacheTest& operator=(const ResourceCacheTest&) = delete;
+    ResourceCacheTest& operator=(ResourceCacheTest&&) = delete;
+
+    void SetUp() override {}
+    void TearDown() override {}
+
+protected:
+    using Cache = ResourceCache<std::size_t>;
+
+    /// \brief Every resource takes up as much memory as its value
+    static constexpr std::size_t BUDGET{ 100 };
+
+    Cache m_cache{ BUDGET, [](const std::size_t& value) { return value; } };
+    std::size_t m_loads{ 0 };
+
+    /// \brief A loader that finishes right away and counts how often it was called
+    [[nodiscard]] Cache::Loader loaded(std::size_t value)
+    {
+        return [this, value]() {
+            ++m_loads;
+            std::promise<Cache::Handle> promise;
+            promise.set_value(std::make_shared<std::size_t>(value));
+            return promise.get_future().share();
+        };
+    }
+};
+
+TEST_F(ResourceCacheTest, SameKeyLoadsOnce)
+{
+    const Cache::Handle first{ m_cache.acquire("a", loaded(1)).get() };
+    const Cache::Handle second{ m_cache.acquire("a", loaded(2)).get() };
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(*second, 1);
+    EXPECT_EQ(m_loads, 1);
+    EXPECT_EQ(m_cache.getHits(), 1);
+    EXPECT_EQ(m_cache.getMisses(), 1);
+}
+
+TEST_F(ResourceCacheTest, InFlightLoadIsShared)
+{
+    std::promise<Cache::Handle> promise;
+    const Cache::Future pending{ promise.get_future().share() };
+
+    const Cache::Future first{ m_cache.acquire("a", [&pending]() { return pending; }) };
+    const Cache::Future second{ m_cache.acquire("a", loaded(2)) };
+    promise.set_value(std::make_shared<std::size_t>(1));
+
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(m_loads, 0);
+    EXPECT_EQ(m_cache.getMemoryUsage(), 1);
+}
+
+TEST_F(ResourceCacheTest, FailedLoadIsRetried)
+{
+    const Cache::Future failed{ m_cache.acquire("a", []() {
+        std::promise<Cache::Handle> promise;
+        promise.set_exception(std::make_exception_ptr(std::runtime_error{ "missing file" }));
+        return promise.get_future().share();
+    }) };
+    EXPECT_THROW(static_cast<void>(failed.get()), std::runtime_error);
+
+    EXPECT_EQ(*m_cache.acquire("a", loaded(1)).get(), 1);
+    EXPECT_EQ(m_loads, 1);
+    EXPECT_EQ(m_cache.getMisses(), 2);
+}
+
+TEST_F(ResourceCacheTest, ThrowingLoaderLeavesNoEntry)
+{
+    const Cache::Loader throwing{ []() -> Cache::Future { throw std::runtime_error{ "no worker" }; } };
+    EXPECT_THROW(static_cast<void>(m_cache.acquire("a", throwing)), std::runtime_error);
+    EXPECT_FALSE(m_cache.contains("a"));
+    EXPECT_EQ(m_cache.size(), 0);
+
+    EXPECT_EQ(*m_cache.acquire("a", loaded(1)).get(), 1);
+    EXPECT_EQ(m_cache.trim(), 0);
+    EXPECT_EQ(m_cache.getMemoryUsage(), 1);
+}
+
+TEST_F(ResourceCacheTest, TrimKeepsResourcesWithinBudget)
+{
+    static_cast<void>(m_cache.acquire("a", loaded(60)));
+    static_cast<void>(m_cache.acquire("b", loaded(30)));
+
+    EXPECT_EQ(m_cache.trim(), 0);
+    EXPECT_EQ(m_cache.size(), 2);
+}
+
+TEST_F(ResourceCacheTest, TrimEvictsLeastRecentlyUsed)
+{
+    static_cast<void>(m_cache.acquire("a", loaded(60)));
+    static_cast<void>(m_cache.acquire("b", loaded(30)));
+    static_cast<void>(m_cache.acquire("c", loaded(30)));
+    static_cast<void>(m_cache.acquire("a", loaded(60)));
+
+    EXPECT_EQ(m_cache.trim(), 1);
+    EXPECT_FALSE(m_cache.contains("b"));
+    EXPECT_TRUE(m_cache.contains("a"));
+    EXPECT_TRUE(m_cache.contains("c"));
+    EXPECT_EQ(m_cache.getMemoryUsage(), 90);
+    EXPECT_EQ(m_cache.getEvictions(), 1);
+}
+
+TEST_F(ResourceCacheTest, TrimKeepsResourcesInUse)
+{
+    const Cache::Handle used{ m_cache.acquire("a", loaded(80)).get() };
+    static_cast<void>(m_cache.acquire("b", loaded(80)));
+
+    EXPECT_EQ(m_cache.trim(), 1);
+    EXPECT_TRUE(m_cache.contains("a"));
+    EXPECT_FALSE(m_cache.contains("b"));
+
+    static_cast<void>(m_cache.acquire("c", loaded(80)));
+    const Cache::Handle alsoUsed{ m_cache.acquire("c", loaded(80)).get() };
+
+    EXPECT_EQ(m_cache.trim(), 0);
+    EXPECT_GT(m_cache.getMemoryUsage(), BUDGET);
+}
+
+TEST_F(ResourceCacheTest, TrimKeepsLoadsInFlight)
+{
+    std::promise<Cache::Handle> promise;
+    const Cache::Future pending{ promise.get_future().share() };
+    static_cast<void>(m_cache.acquire("a", [&pending]() { return pending; }));
+    static_cast<void>(m_cache.acquire("b", loaded(200)));
+
+    EXPECT_EQ(m_cache.trim(), 1);
+    EXPECT_TRUE(m_cache.contains("a"));
+
+    promise.set_value(std::make_shared<std::size_t>(1));
+}
+
+} // namespace vv::test
@@ -0,0 +1,97 @@
+#include "utility/RingAllocator.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <optional>
+
+namespace vv::test
+{
+
+class RingAllocatorTest : public ::testing::Test
+{
+public:
+    RingAllocatorTest() = default;
+    ~RingAllocatorTest() override = default;
+
+    RingAllocatorTest(const RingAllocatorTest&) = delete;
+    RingAllocatorTest(RingAllocatorTest&&) = delete;
+    RingAllocatorTest& operator=(const RingAllocatorTest&) = delete;
+    RingAllocatorTest& operator=(RingAllocatorTest&&) = delete;
+
+    void SetUp() override {}
+    void TearDown() override {}
+
+protected:
+    static constexpr std::uint64_t CAPACITY{ 256 };
+
+    RingAllocator m_ring{ CAPACITY };
+};
+
+TEST_F(RingAllocatorTest, AllocationsAreAlignedAndDoNotOverlap)
+{
+    EXPECT_EQ(m_ring.allocate(10, 1), 0);
+    EXPECT_EQ(m_ring.allocate(10, 16), 16);
+    EXPECT_EQ(m_ring.allocate(4, 4), 28);
+    EXPECT_EQ(m_ring.getUsed(), 32);
+}
+
+TEST_F(RingAllocatorTest, FailsWhenFullAndFreesOnRelease)
+{
+    ASSERT_TRUE(m_ring.allocate(200, 16).has_value());
+    m_ring.close(1);
+
+    EXPECT_FALSE(m_ring.allocate(100, 16).has_value());
+
+    m_ring.release(0);
+    EXPECT_FALSE(m_ring.allocate(100, 16).has_value());
+
+    m_ring.release(1);
+    EXPECT_FALSE(m_ring.hasPendingBatches());
+    EXPECT_TRUE(m_ring.allocate(100, 16).has_value());
+}
+
+TEST_F(RingAllocatorTest, RangesDoNotWrapAroundTheEnd)
+{
+    ASSERT_EQ(m_ring.allocate(192, 16), 0);
+    m_ring.close(1);
+    m_ring.release(1);
+
+    // NOTE: Only 64 bytes are left before the end, so the range starts at the beginning again
+    EXPECT_EQ(m_ring.allocate(100, 16), 0);
+    EXPECT_EQ(m_ring.getUsed(), 164);
+}
+
+TEST_F(RingAllocatorTest, OpenAllocationsAreNeverReleased)
+{
+    ASSERT_TRUE(m_ring.allocate(64, 16).has_value());
+    m_ring.close(1);
+    ASSERT_TRUE(m_ring.allocate(64, 16).has_value());
+
+    m_ring.release(10);
+
+    EXPECT_TRUE(m_ring.hasOpenBatch());
+    EXPECT_EQ(m_ring.getUsed(), 64);
+}
+
+TEST_F(RingAllocatorTest, BatchesAreReleasedInOrder)
+{
+    ASSERT_TRUE(m_ring.allocate(64, 16).has_value());
+    m_ring.close(1);
+    ASSERT_TRUE(m_ring.allocate(64, 16).has_value());
+    m_ring.close(3);
+
+    EXPECT_EQ(m_ring.getOldestPendingValue(), 1);
+
+    m_ring.release(2);
+    EXPECT_EQ(m_ring.getUsed(), 64);
+    EXPECT_EQ(m_ring.getOldestPendingValue(), 3);
+}
+
+TEST_F(RingAllocatorTest, TooLargeAllocationFails)
+{
+    EXPECT_FALSE(m_ring.allocate(CAPACITY + 1, 1).has_value());
+    EXPECT_EQ(m_ring.getUsed(), 0);
+}
+
+} // namespace vv::test
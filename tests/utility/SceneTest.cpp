@@ -0,0 +1,86 @@
+#include "fixtures/TestVulkanContext.hpp"
+
+#include "core/Texture2D.hpp"
+#include "utility/AssetLoader.hpp"
+#include "utility/Scene.hpp"
+#include "utility/material/Material.hpp"
+#include "utility/material/MaterialTable.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace vv::test
+{
+
+class SceneTest : public ::testing::Test
+{
+public:
+    static constexpr auto TEST_TEXTURE_PATH{ PROJECT_ROOT "tests/resources/512x512.png" };
+
+    void SetUp() override
+    {
+        ctx = std::make_unique<TestVulkanContext>();
+        if(!MaterialTable::isSupported(*ctx->device()))
+            GTEST_SKIP() << "The device does not support bindless materials";
+
+        materialTable = std::make_shared<MaterialTable>(ctx->device());
+        // NOTE: Without a budget, every texture and model that is not used anymore is evicted by the next trim
+        scene = std::make_unique<Scene>(ctx->device(), materialTable, 0, 0);
+        assets = std::make_unique<AssetLoader>(ctx->device(), 1);
+    }
+
+    std::unique_ptr<TestVulkanContext> ctx;
+    std::shared_ptr<MaterialTable> materialTable;
+    std::unique_ptr<Scene> scene;
+    std::unique_ptr<AssetLoader> assets;
+};
+
+TEST_F(SceneTest, TextureOfUsedMaterialIsNotEvicted)
+{
+    const auto textureConfig{ TextureConfig::albedo() };
+    MaterialConfig config{};
+    config.albedoTexture = assets->get(scene->loadTexture(*assets, TEST_TEXTURE_PATH, textureConfig));
+    const auto material{ scene->createMaterial(config) };
+    config = {};
+
+    EXPECT_EQ(scene->trimCaches(), 0);
+    EXPECT_TRUE(scene->containsTexture(TEST_TEXTURE_PATH, textureConfig));
+    EXPECT_EQ(materialTable->getMaterialCount(), 1);
+}
+
+TEST_F(SceneTest, TextureOfReleasedMaterialIsEvicted)
+{
+    const auto textureConfig{ TextureConfig::albedo() };
+    MaterialConfig config{};
+    config.albedoTexture = assets->get(scene->loadTexture(*assets, TEST_TEXTURE_PATH, textureConfig));
+    auto material{ scene->createMaterial(config) };
+    config = {};
+
+    material.reset();
+
+    EXPECT_EQ(scene->trimCaches(), 1);
+    EXPECT_FALSE(scene->containsTexture(TEST_TEXTURE_PATH, textureConfig));
+    EXPECT_EQ(materialTable->getMaterialCount(), 0);
+    EXPECT_EQ(materialTable->getTextureCount(), 0);
+}
+
+TEST_F(SceneTest, ReleasedMaterialSlotIsReused)
+{
+    MaterialConfig config{};
+    auto material{ scene->createMaterial(config) };
+    const std::uint32_t index{ material->getIndex() };
+
+    material.reset();
+    static_cast<void>(scene->trimCaches());
+    // NOTE: The slot is only reused once the work that was submitted before the removal has finished
+    ctx->device()->waitForGraphicsValue(ctx->device()->submittedGraphicsValue());
+    config = {};
+    material = scene->createMaterial(config);
+
+    EXPECT_EQ(material->getIndex(), index);
+    EXPECT_EQ(materialTable->getMaterialCount(), 1);
+}
+
+} // namespace vv::test
@@ -0,0 +1,151 @@
+#include "utility/ThreadPool.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace vv::test
+{
+
+class ThreadPoolTest : public ::testing::Test
+{
+public:
+    ThreadPoolTest() = default;
+    ~ThreadPoolTest() override = default;
+
+    ThreadPoolTest(const ThreadPoolTest&) = delete;
+    ThreadPoolTest(ThreadPoolTest&&) = delete;
+    ThreadPoolTest& operator=(const ThreadPoolTest&) = delete;
+    ThreadPoolTest& operator=(ThreadPoolTest&&) = delete;
+
+    void SetUp() override {}
+    void TearDown() override {}
+
+protected:
+    static constexpr std::size_t THREAD_COUNT{ 4 };
+
+    ThreadPool m_pool{ THREAD_COUNT };
+};
+
+TEST_F(ThreadPoolTest, ThreadCountIncludesCaller)
+{
+    EXPECT_EQ(m_pool.getThreadCount(), THREAD_COUNT);
+    EXPECT_EQ(ThreadPool{ 1 }.getThreadCount(), 1);
+}
+
+TEST_F(ThreadPoolTest, EveryElementIsVisitedOnce)
+{
+    constexpr std::size_t COUNT{ 1000 };
+    std::vector<std::atomic<int>> visits(COUNT);
+
+    m_pool.parallelFor(COUNT, THREAD_COUNT, [&visits](std::size_t begin, std::size_t end, std::size_t) {
+        for(std::size_t i{ begin }; i < end; ++i)
+            visits[i].fetch_add(1);
+    });
+
+    for(const auto& visit : visits)
+        EXPECT_EQ(visit.load(), 1);
+}
+
+TEST_F(ThreadPoolTest, RangeIndexMatchesThreadIndex)
+{
+    constexpr std::size_t COUNT{ 10 };
+    std::mutex mutex;
+    std::vector<std::size_t> begins(THREAD_COUNT, COUNT + 1);
+    std::vector<std::size_t> ends(THREAD_COUNT, COUNT + 1);
+    std::vector<std::thread::id> ids(THREAD_COUNT);
+
+    m_pool.parallelFor(COUNT, THREAD_COUNT, [&](std::size_t begin, std::size_t end, std::size_t thread) {
+        const std::scoped_lock lock{ mutex };
+        begins[thread] = begin;
+        ends[thread] = end;
+        ids[thread] = std::this_thread::get_id();
+    });
+
+    EXPECT_EQ(ids[0], std::this_thread::get_id());
+    EXPECT_EQ(begins[0], 0);
+    EXPECT_EQ(ends[THREAD_COUNT - 1], COUNT);
+    for(std::size_t thread{ 0 }; thread < THREAD_COUNT; ++thread)
+    {
+        EXPECT_EQ(begins[thread], ThreadPool::rangeBegin(COUNT, THREAD_COUNT, thread));
+        EXPECT_EQ(ends[thread], ThreadPool::rangeBegin(COUNT, THREAD_COUNT, thread + 1));
+        if(thread > 0)
+        {
+            EXPECT_NE(ids[thread], ids[0]);
+        }
+    }
+}
+
+TEST_F(ThreadPoolTest, FewerRangesThanThreads)
+{
+    std::atomic<std::size_t> calls{ 0 };
+    std::atomic<std::size_t> maxThread{ 0 };
+
+    m_pool.parallelFor(5, 2, [&](std::size_t, std::size_t, std::size_t thread) {
+        calls.fetch_add(1);
+        std::size_t expected{ maxThread.load() };
+        while(thread > expected && !maxThread.compare_exchange_weak(expected, thread)) {}
+    });
+
+    EXPECT_EQ(calls.load(), 2);
+    EXPECT_EQ(maxThread.load(), 1);
+}
+
+TEST_F(ThreadPoolTest, EmptyRangesWhenFewerElementsThanRanges)
+{
+    std::atomic<std::size_t> elements{ 0 };
+
+    m_pool.parallelFor(2, THREAD_COUNT, [&elements](std::size_t begin, std::size_t end, std::size_t) {
+        elements.fetch_add(end - begin);
+    });
+
+    EXPECT_EQ(elements.load(), 2);
+}
+
+TEST_F(ThreadPoolTest, CanBeReusedManyTimes)
+{
+    constexpr std::size_t ITERATIONS{ 200 };
+    std::atomic<std::size_t> total{ 0 };
+
+    for(std::size_t i{ 0 }; i < ITERATIONS; ++i)
+    {
+        const std::size_t ranges{ (i % THREAD_COUNT) + 1 };
+        m_pool.parallelFor(100, ranges, [&total](std::size_t begin, std::size_t end, std::size_t) {
+            total.fetch_add(end - begin);
+        });
+    }
+
+    EXPECT_EQ(total.load(), ITERATIONS * 100);
+}
+
+TEST_F(ThreadPoolTest, ExceptionIsRethrownOnCaller)
+{
+    std::atomic<std::size_t> finished{ 0 };
+
+    EXPECT_THROW(
+        m_pool.parallelFor(
+            THREAD_COUNT,
+            THREAD_COUNT,
+            [&finished](std::size_t, std::size_t, std::size_t thread) {
+                if(thread == THREAD_COUNT - 1)
+                    throw std::runtime_error("range failed");
+                finished.fetch_add(1);
+            }
+        ),
+        std::runtime_error
+    );
+    EXPECT_EQ(finished.load(), THREAD_COUNT - 1);
+
+    std::atomic<std::size_t> calls{ 0 };
+    m_pool.parallelFor(THREAD_COUNT, THREAD_COUNT, [&calls](std::size_t, std::size_t, std::size_t) {
+        calls.fetch_add(1);
+    });
+    EXPECT_EQ(calls.load(), THREAD_COUNT);
+}
+
+} // namespace vv::test